@@ -9,10 +9,9 @@ Output: Populates FlightInfo on success and returns true.
 */
 #include "adapters/AeroAPIFetcher.h"
 #include "config/RuntimeSettings.h"
+#include "utils/ApiHttpClient.h"
 #include "utils/NetLock.h"
-
-static unsigned long s_lastTlsFailMs = 0;
-static const unsigned long kTlsBackoffMs = 20000UL; // back off 20s after TLS alloc failure
+#include "utils/PipelinedStream.h"
 
 static String safeGetString(JsonVariantConst v, const char *key)
 {
@@ -24,10 +23,9 @@ static String safeGetString(JsonVariantConst v, const char *key)
 
 bool AeroAPIFetcher::fetchFlightInfo(const String &flightIdent, FlightInfo &outInfo)
 {
-    unsigned long nowMs = millis();
-    if (s_lastTlsFailMs != 0 && nowMs - s_lastTlsFailMs < kTlsBackoffMs)
+    if (!ApiHttp::available(ApiHttp::Host::AeroApi))
     {
-        Serial.println("AeroAPIFetcher: backing off after TLS failure");
+        Serial.println("AeroAPIFetcher: backing off after failure");
         return false;
     }
 
@@ -54,30 +52,23 @@ bool AeroAPIFetcher::fetchFlightInfo(const String &flightIdent, FlightInfo &outI
     // Try up to 2 attempts to handle occasional truncated bodies.
     for (int attempt = 0; attempt < 2; ++attempt)
     {
-        HTTPClient http;
-        String url = String(APIConfiguration::AEROAPI_BASE_URL) + "/flights/" + flightIdent;
-        http.begin(client, url);
-        http.addHeader("x-apikey", cfg.aeroApiKey);
-        http.addHeader("Accept", "application/json");
-        http.addHeader("Accept-Encoding", "identity"); // avoid gzip/deflate to reduce parsing issues
-        http.addHeader("Connection", "close");          // prefer connection-close to signal body end
-        static const char *headers[] = {"Content-Length", "Transfer-Encoding", "Content-Encoding", "Connection"};
-        http.collectHeaders(headers, 4);
-        http.useHTTP10(true); // prefer non-chunked, connection-close responses
-        http.setReuse(false);
-        http.setTimeout(30000); // allow longer for full body
-
-        int code = http.GET();
+        ApiHttp::Request request(ApiHttp::Host::AeroApi, client);
+        if (!request.setUrl("%s/flights/%s", APIConfiguration::AEROAPI_BASE_URL, flightIdent.c_str()))
+        {
+            return false;
+        }
+        request.addHeader("x-apikey", cfg.aeroApiKey.c_str());
+        request.addHeader("Accept", "application/json");
+        request.acceptCompressed(); // gzip only when the inflater fits next to TLS
+        request.addHeader("Connection", "close");          // prefer connection-close to signal body end
+        request.setTimeout(30000); // allow longer for full body
+
+        int code = request.get();
         if (code != 200)
         {
-            if (code < 0)
-            {
-                s_lastTlsFailMs = millis();
-            }
             Serial.printf("AeroAPIFetcher: HTTP %d for flight %s -> likely server/network issue\n",
                           code,
                           flightIdent.c_str());
-            http.end();
             return false;
         }
 
@@ -96,22 +87,28 @@ bool AeroAPIFetcher::fetchFlightInfo(const String &flightIdent, FlightInfo &outI
         filter["flights"][0]["destination"]["code_iata"] = true;
         filter["flights"][0]["destination"]["name"] = true;
 
-        int expectedLen = http.getSize();
-        String transferEncoding = http.header("Transfer-Encoding");
-        String contentEncoding = http.header("Content-Encoding");
+        int expectedLen = request.contentLength();
+        String transferEncoding = request.header("Transfer-Encoding");
+        String contentEncoding = request.header("Content-Encoding");
         bool isChunked = transferEncoding.equalsIgnoreCase("chunked");
 
-        WiFiClient *stream = http.getStreamPtr();
+        Stream *stream = request.body();
         if (!stream)
         {
-            http.end();
             return false;
         }
-        stream->setTimeout(30000);
+
+        PipelinedStream pipeline;
+        Stream *input = pipeline.begin(*stream, request.timeoutMs(), &request.connection()) ? static_cast<Stream *>(&pipeline) : stream;
 
         static DynamicJsonDocument doc(8192); // reuse to avoid heap churn
         doc.clear();
-        DeserializationError err = deserializeJson(doc, *stream, DeserializationOption::Filter(filter));
+        DeserializationError err = deserializeJson(doc, *input, DeserializationOption::Filter(filter));
+        pipeline.end();
+        if (!err && !request.bodyIntact())
+        {
+            err = DeserializationError::InvalidInput;
+        }
 
         if (err)
         {
@@ -125,7 +122,7 @@ bool AeroAPIFetcher::fetchFlightInfo(const String &flightIdent, FlightInfo &outI
                           isChunked ? "yes" : "no");
 
             bool truncated = (err == DeserializationError::IncompleteInput);
-            http.end();
+            request.end();
             if (truncated && attempt == 0)
             {
                 Serial.println("AeroAPIFetcher: retrying once due to truncated body");
@@ -135,7 +132,7 @@ bool AeroAPIFetcher::fetchFlightInfo(const String &flightIdent, FlightInfo &outI
             return false;
         }
 
-        http.end();
+        request.end();
 
         JsonArray flights = doc["flights"].as<JsonArray>();
         if (flights.isNull() || flights.size() == 0)
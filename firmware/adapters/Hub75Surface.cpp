@@ -0,0 +1,59 @@
+/*
+Purpose: HUB75 backend for RenderSurface.
+Responsibilities:
+- Forward pre-clipped spans to hlineDMA and rects to fillRectDMA with the RGB888 color
+  computed once per call, so each row costs one DMA-buffer pass instead of one virtual
+  drawPixel per pixel.
+- For panels stacked in more than one row, split spans at panel edges and translate
+  them to chain coordinates.
+*/
+#include "adapters/Hub75Surface.h"
+#include <ESP32-HUB75-MatrixPanel-I2S-DMA.h>
+
+int16_t Hub75Surface::width() const
+{
+    return m_tileWidth * m_columns;
+}
+
+int16_t Hub75Surface::height() const
+{
+    return m_tileHeight * m_rows;
+}
+
+void Hub75Surface::writeSpan(int16_t x, int16_t y, int16_t w, const Color &color)
+{
+    if (m_rows <= 1)
+    {
+        m_panel.drawFastHLine(x, y, w, color.r, color.g, color.b);
+        return;
+    }
+
+    // The chain is one long row of panels; panel row r starts at tile r * columns.
+    const int16_t chainY = y % m_tileHeight;
+    const int16_t tileBase = (y / m_tileHeight) * m_columns;
+    while (w > 0)
+    {
+        const int16_t column = x / m_tileWidth;
+        const int16_t offset = x - column * m_tileWidth;
+        int16_t run = m_tileWidth - offset;
+        if (run > w)
+            run = w;
+        const int16_t chainX = (tileBase + column) * m_tileWidth + offset;
+        m_panel.drawFastHLine(chainX, chainY, run, color.r, color.g, color.b);
+        x += run;
+        w -= run;
+    }
+}
+
+void Hub75Surface::writeRect(int16_t x, int16_t y, int16_t w, int16_t h, const Color &color)
+{
+    if (m_rows <= 1)
+    {
+        m_panel.fillRect(x, y, w, h, color.r, color.g, color.b);
+        return;
+    }
+    for (int16_t row = 0; row < h; ++row)
+    {
+        writeSpan(x, y + row, w, color);
+    }
+}
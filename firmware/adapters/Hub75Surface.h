@@ -0,0 +1,33 @@
+#pragma once
+
+#include "utils/RenderSurface.h"
+
+class MatrixPanel_I2S_DMA;
+
+// RenderSurface backend that writes spans and rects straight into the HUB75 DMA buffer
+// through the panel's RGB888 line/rect calls, bypassing Adafruit_GFX's per-pixel
+// drawPixel -> updateMatrixDMABuffer path. Chained panels stacked in several rows are
+// presented as one columns x rows surface; spans are split at panel edges and mapped
+// onto the chain (row by row, left to right).
+class Hub75Surface : public RenderSurface
+{
+public:
+    Hub75Surface(MatrixPanel_I2S_DMA &panel, int16_t tileWidth, int16_t tileHeight,
+                 uint8_t columns = 1, uint8_t rows = 1)
+        : m_panel(panel), m_tileWidth(tileWidth), m_tileHeight(tileHeight),
+          m_columns(columns), m_rows(rows) {}
+
+    int16_t width() const override;
+    int16_t height() const override;
+
+protected:
+    void writeSpan(int16_t x, int16_t y, int16_t w, const Color &color) override;
+    void writeRect(int16_t x, int16_t y, int16_t w, int16_t h, const Color &color) override;
+
+private:
+    MatrixPanel_I2S_DMA &m_panel;
+    int16_t m_tileWidth;
+    int16_t m_tileHeight;
+    uint8_t m_columns;
+    uint8_t m_rows;
+};
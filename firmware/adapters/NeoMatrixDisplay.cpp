@@ -2,53 +2,154 @@
 Purpose: Render flight info on a HUB75 panel (ESP32 Trinity) via MatrixPanel_I2S_DMA.
 Responsibilities:
 - Initialize LED matrix based on HardwareConfiguration and user display settings.
-- Render a simple two-line flight card (no border), using alternating frames:
-    Frame A:
-        Line 1: airline code from flight ident (e.g. "LH")
-        Line 2: aircraft model (e.g. "A320", "747-8")
-    Frame B:
-        Line 1: origin (ICAO or "---")
-        Line 2: destination (ICAO or "---")
+- Render flight cards from the selected design's constexpr tables (utils/CardLayout):
+  progress bar, airline fin and name, route codes, aircraft, cities and live metrics are
+  rows and fields in the data, with alignment, colors and overflow policy (clip, truncate,
+  marquee, wrap), executed by one generic layout pass and line renderer.
 - Show a minimal loading screen when no flights are available.
-- Cycle through multiple flights at a configurable interval.
+- Cycle through the flights in relevance-weighted playlist order (utils/FlightPlaylist),
+  refreshing a shown card in place when only its live metrics change.
+- Split chained panels into panes by geometry: one card, two cards side by side (wide)
+  or a card above the radar or list (tall); in radar and list mode that view takes the
+  last pane. Each card is laid out relative to its own pane and redraws only its own
+  damaged rows, so cost grows with the pixels that change.
+- Between card changes, clear and redraw only the marquee rows that moved (dirty rects),
+  and log frame/pixel-write counters.
+- Draw text, rects, arrows and atlas sprites (weather icons, the logo, airline tail fins)
+  as spans through Hub75Surface, which writes rows straight into the DMA buffer instead
+  of going pixel by pixel.
+- Run the boot test, logo fade/hold and card wipe as time-based animations, one step
+  per render tick, instead of blocking with delay().
+- Show a climbing or descending flight's altitude extrapolated from its last fix, stepped
+  once a second, and dead-reckon radar contacts between fetches (utils/MotionModel).
+- Report when the next visible change is due (marquee step, cycle, colon blink) so the
+  caller can sleep instead of re-rendering unchanged frames.
+- Avoid tearing per FW_DISPLAY_TEAR_MODE: compose damaged rows in a small band buffer
+  and write each pixel once (default), or use full DMA double buffering.
 Inputs: FlightInfo list; UserConfiguration (colors/brightness), TimingConfiguration (cycle),
         HardwareConfiguration (dimensions/pin/tiling).
 Outputs: Visual output to LED matrix using double-buffered DMA.
 */
 
 #include "adapters/NeoMatrixDisplay.h"
+#include "adapters/Hub75Surface.h"
 
 #include <ESP32-HUB75-MatrixPanel-I2S-DMA.h>
 #include <Adafruit_GFX.h>
 #include <time.h>
 #include <math.h>
-#include <WiFi.h>
-#include <WiFiClientSecure.h>
-#include <HTTPClient.h>
-#include <ArduinoJson.h>
 #include "config/UserConfiguration.h"
 #include "config/RuntimeSettings.h"
 #include "config/HardwareConfiguration.h"
 #include "config/TimingConfiguration.h"
-#include "images/flightwatch_logo.h"
-#include "utils/NetLock.h"
+#include "utils/SpriteAtlas.h"
+#include "utils/CardLayout.h"
+#include "utils/MotionModel.h"
+
+#ifndef FW_DISPLAY_TEAR_MODE
+// 0: clear and redraw damaged rows directly in the single DMA buffer
+// 1: compose damaged rows in a ~1.5 KB band buffer, then write each pixel once (default)
+// 2: full DMA double buffering; tear-free but costs a second DMA frame (see README)
+#define FW_DISPLAY_TEAR_MODE 1
+#endif
+
+#ifndef FW_CARD_COMPACT_FONT
+// 1: card rows a design sets in the compact font use the proportional 5 px font (default),
+//    so most names fit without a marquee; 0: the 6x8 GFX font everywhere
+#define FW_CARD_COMPACT_FONT 1
+#endif
+
+#ifndef FW_RENDER_BENCH
+#define FW_RENDER_BENCH 0 // 1: time per-glyph vs strip text rendering once at boot and log it
+#endif
 
 namespace
 {
     constexpr int CHAR_WIDTH = 6;
     constexpr int CHAR_HEIGHT = 8;
-    constexpr int LINE_GAP = 2;
+    constexpr int ARROW_WIDTH = 7;       // widest row of ARROW_SPANS
     constexpr int MARQUEE_GAP_PX = 10;
     constexpr unsigned long MARQUEE_FRAME_MS = 25; // 40 FPS target
     constexpr int MARQUEE_SPEED_PX = 1;
     constexpr int BORDER = 1;
-    constexpr int PROGRESS_BAR_HEIGHT = 2;
+    constexpr unsigned long RENDER_STATS_WINDOW_MS = 10000;
+    constexpr unsigned long MAX_RENDER_WAIT_MS = 1000; // upper bound when nothing is scheduled
+    constexpr unsigned long RADAR_FRAME_MS = 100;      // how often radar motion is re-evaluated
+    constexpr unsigned long RADAR_GLIDE_MS = 3000;     // a radar contact converges onto a new fix
+    constexpr unsigned long ALTITUDE_STEP_MS = 1000;   // extrapolated card altitude changes this often
+
+    // Animation timing
+    constexpr uint16_t BOOT_TEST_STEPS = 5; // red, green, blue, white, checkerboard
+    constexpr unsigned long BOOT_TEST_STEP_MS = 1000;
+    constexpr uint16_t LOGO_FADE_STEPS = 16;
+    constexpr unsigned long LOGO_FADE_STEP_MS = 40;
+    constexpr unsigned long LOGO_HOLD_MS = 5000;
+    constexpr int WIPE_BAND_PX = 6; // pixel band; small to keep transition light
+    constexpr unsigned long WIPE_STEP_MS = 8;
+    // A DMA flip takes effect when the current scan-out ends: one frame at the HUB75
+    // library's 60 Hz minimum refresh. Until then the back buffer may still be on screen.
+    constexpr unsigned long FLIP_SETTLE_MS = 17;
+
+    // Row widths of the solid 6x8 right-pointing arrow (same rows fillTriangle produced).
+    constexpr int8_t ARROW_SPANS[CHAR_HEIGHT] = {1, 3, 5, 7, 6, 4, 3, 1};
+
+    uint32_t fnv1a(uint32_t h, const void *data, size_t len)
+    {
+        const uint8_t *p = (const uint8_t *)data;
+        for (size_t i = 0; i < len; ++i)
+        {
+            h = (h ^ p[i]) * 16777619u;
+        }
+        return h;
+    }
+
+    // Altitude a card shows: extrapolated from the fix at its vertical rate and held for
+    // ALTITUDE_STEP_MS at a time, so the metrics line is rebuilt at most once a step.
+    // nextMs is set to the next step, or 0 when the altitude holds.
+    double cardAltitude(const FlightInfo &f, unsigned long nowMs, unsigned long &nextMs)
+    {
+        nextMs = 0;
+        if (f.position_ms == 0 || isnan(f.baro_altitude_m) || isnan(f.vertical_rate_mps) || f.vertical_rate_mps == 0)
+            return f.baro_altitude_m;
+        if ((long)(nowMs - f.position_ms) < 0)
+            return f.baro_altitude_m;
+        const unsigned long age = nowMs - f.position_ms;
+        if (age >= MotionModel::kHorizonMs)
+            return MotionModel::altitudeAt(f.baro_altitude_m, f.vertical_rate_mps, f.position_ms, f.position_ms + MotionModel::kHorizonMs);
+        const unsigned long stepMs = f.position_ms + age / ALTITUDE_STEP_MS * ALTITUDE_STEP_MS;
+        nextMs = stepMs + ALTITUDE_STEP_MS;
+        return MotionModel::altitudeAt(f.baro_altitude_m, f.vertical_rate_mps, f.position_ms, stepMs);
+    }
+
+    RenderSurface::Color cardColor(CardLayout::ColorRole role)
+    {
+        switch (role)
+        {
+        case CardLayout::ColorRole::Dim:
+            return RenderSurface::rgb(UserConfiguration::TEXT_COLOR_R / 3,
+                                      UserConfiguration::TEXT_COLOR_G / 3,
+                                      UserConfiguration::TEXT_COLOR_B / 3);
+        case CardLayout::ColorRole::Origin:
+            return RenderSurface::rgb(80, 200, 200); // soft teal
+        case CardLayout::ColorRole::Destination:
+            return RenderSurface::rgb(255, 200, 80); // soft amber
+        case CardLayout::ColorRole::White:
+            return RenderSurface::rgb(255, 255, 255);
+        case CardLayout::ColorRole::Text:
+        default:
+            return RenderSurface::rgb(UserConfiguration::TEXT_COLOR_R,
+                                      UserConfiguration::TEXT_COLOR_G,
+                                      UserConfiguration::TEXT_COLOR_B);
+        }
+    }
 }
 
 NeoMatrixDisplay::NeoMatrixDisplay() {}
 
 NeoMatrixDisplay::~NeoMatrixDisplay()
 {
+    delete _surface;
+    _surface = nullptr;
     if (_matrix)
     {
         delete _matrix;
@@ -58,16 +159,21 @@ NeoMatrixDisplay::~NeoMatrixDisplay()
 
 bool NeoMatrixDisplay::initialize()
 {
-    _matrixWidth  = HardwareConfiguration::DISPLAY_MATRIX_WIDTH;
-    _matrixHeight = HardwareConfiguration::DISPLAY_MATRIX_HEIGHT;
+    const uint8_t chainRows = HardwareConfiguration::DISPLAY_CHAIN_ROWS > 0
+                                  ? HardwareConfiguration::DISPLAY_CHAIN_ROWS
+                                  : 1;
+    const uint8_t chainColumns = HardwareConfiguration::DISPLAY_CHAIN_LENGTH / chainRows;
+    _matrixWidth  = HardwareConfiguration::DISPLAY_MATRIX_WIDTH * chainColumns;
+    _matrixHeight = HardwareConfiguration::DISPLAY_MATRIX_HEIGHT * chainRows;
 
     HUB75_I2S_CFG mxconfig(
-        _matrixWidth,
-        _matrixHeight,
+        HardwareConfiguration::DISPLAY_MATRIX_WIDTH,
+        HardwareConfiguration::DISPLAY_MATRIX_HEIGHT,
         HardwareConfiguration::DISPLAY_CHAIN_LENGTH);
 
     mxconfig.gpio.e      = HardwareConfiguration::DISPLAY_GPIO_E;
-    mxconfig.double_buff = false; // disable double buffer to free heap for TLS/network
+    // Single buffer unless built for it: a second DMA frame competes with TLS for heap.
+    mxconfig.double_buff = (FW_DISPLAY_TEAR_MODE == 2);
 
     _matrix = new MatrixPanel_I2S_DMA(mxconfig);
     if (_matrix == nullptr)
@@ -79,15 +185,29 @@ bool NeoMatrixDisplay::initialize()
     {
         return false;
     }
+    _surface = new Hub75Surface(*_matrix,
+                                HardwareConfiguration::DISPLAY_MATRIX_WIDTH,
+                                HardwareConfiguration::DISPLAY_MATRIX_HEIGHT,
+                                chainColumns,
+                                chainRows);
+    _target = _surface;
+    _clipX0 = 0;
+    _clipX1 = _matrixWidth;
+#if FW_DISPLAY_TEAR_MODE == 1
+    _band.begin(_matrixWidth, _matrixHeight);
+#endif
 
     _matrix->setTextWrap(false);
     _matrix->setTextSize(1); // smallest built-in font
     _matrix->setBrightness8(RuntimeSettings::current().displayBrightness);
+    _damage.setBounds(_matrixWidth, _matrixHeight);
+    layoutPanes();
 
-    runBootTest();
+#if FW_RENDER_BENCH
+    runRenderBenchmark();
+#endif
     clear();
 
-    _currentFlightIndex = 0;
     _lastCycleMs = millis();
     return true;
 }
@@ -96,8 +216,12 @@ void NeoMatrixDisplay::clear()
 {
     if (_matrix)
     {
-        _matrix->fillScreen(0);
+        _surface->clear();
         present();
+#if FW_DISPLAY_TEAR_MODE == 2
+        _surface->clear(); // the buffer the flip just hid
+#endif
+        _fullRedraw = true;
     }
 }
 
@@ -139,14 +263,29 @@ String NeoMatrixDisplay::makeFlightLine(const FlightInfo &f)
     return line;
 }
 
+void NeoMatrixDisplay::drawStrip(const TextStrip &strip, int16_t x, int16_t y, const RenderSurface::Color &color)
+{
+    strip.blit(*_target, x, y, _clipX0, _clipX1, color);
+}
+
 void NeoMatrixDisplay::drawTextLine(int16_t x, int16_t y,
                                     const String &text, uint16_t color)
 {
-    _matrix->setCursor(x, y);
-    _matrix->setTextColor(color);
-    for (size_t i = 0; i < (size_t)text.length(); ++i)
+    // One-off text (clock, messages) goes through a reused scratch strip.
+    _scratchStrip.render(text);
+    drawStrip(_scratchStrip, x, y, RenderSurface::from565(color));
+}
+
+void NeoMatrixDisplay::drawArrow(int16_t x, int16_t y, const RenderSurface::Color &color)
+{
+    for (int row = 0; row < CHAR_HEIGHT; ++row)
     {
-        _matrix->write(text[i]);
+        int16_t x0 = x;
+        int16_t x1 = x + ARROW_SPANS[row];
+        if (x0 < _clipX0) x0 = _clipX0;
+        if (x1 > _clipX1) x1 = _clipX1;
+        if (x1 > x0)
+            _target->hline(x0, y + row, x1 - x0, color);
     }
 }
 
@@ -237,157 +376,71 @@ String NeoMatrixDisplay::airportCity(const AirportInfo &a) const
     return String("Unknown");
 }
 
-bool NeoMatrixDisplay::fetchWeatherIfNeeded(float &outC, String &outSymbol, uint16_t &outColor)
+bool NeoMatrixDisplay::updateWeather(const WeatherInfo &weather)
 {
-    const unsigned long CACHE_MS = 10UL * 60UL * 1000UL; // 10 minutes
-    const unsigned long FAIL_RETRY_MS = 2UL * 60UL * 1000UL; // back off on repeated failures
-    static unsigned long s_lastWeatherFailMs = 0;
-    unsigned long now = millis();
-    if (!isnan(_lastTempC) && _lastWeatherCode >= 0 && now - _lastTempFetchMs < CACHE_MS)
-    {
-        outC = _lastTempC;
-        outSymbol = _lastWeatherSymbol;
-        outColor = _lastWeatherColor;
-        return true;
-    }
-    if (now - s_lastWeatherFailMs < FAIL_RETRY_MS)
-    {
-        return false; // recent failure; avoid hammering TLS/heap
-    }
+    if (_matrix == nullptr || weather.fetchedMs == _weather.fetchedMs)
+        return false;
+    _weather = weather;
 
-    if (WiFi.status() != WL_CONNECTED)
+    // Map to human-readable labels and colors
+    const int code = _weather.weatherCode;
+    if (code < 0)
     {
-        return false;
+        _weatherSymbol = String();
+        _weatherColor = _matrix->color565(
+            UserConfiguration::TEXT_COLOR_R,
+            UserConfiguration::TEXT_COLOR_G,
+            UserConfiguration::TEXT_COLOR_B);
+        return true;
     }
-
-    NetLock::Guard guard(500); // low priority: yield quickly if network busy
-    if (!guard.locked())
+    if (code == 0)
     {
-        return false;
+        _weatherSymbol = String("Sunny");
+        _weatherColor = _matrix->color565(255, 215, 0); // golden yellow
+        return true;
     }
-
-    // Use plain HTTP to avoid TLS RAM spikes on ESP32 for this small request.
-    WiFiClient client;
-    HTTPClient http;
-
-    const auto &cfg = RuntimeSettings::current();
-    String url = String("http://api.open-meteo.com/v1/forecast?latitude=") +
-                 String(cfg.weatherLat, 6) +
-                 "&longitude=" + String(cfg.weatherLon, 6) +
-                 "&current=temperature_2m,weathercode";
-
-    http.setReuse(false);
-    http.useHTTP10(true);
-    http.addHeader("Accept-Encoding", "identity");
-
-    if (!http.begin(client, url))
-        return false;
-
-    int code = http.GET();
-    if (code != 200)
+    if (code == 1 || code == 2 || code == 3)
     {
-        http.end();
-        s_lastWeatherFailMs = now;
-        return false;
+        _weatherSymbol = String("Cloudy");
+        _weatherColor = _matrix->color565(160, 160, 160); // gray
+        return true;
     }
-
-    String payload = http.getString();
-    http.end();
-
-    StaticJsonDocument<1024> doc;
-    DeserializationError err = deserializeJson(doc, payload);
-    if (err)
+    if (code == 45 || code == 48)
     {
-        s_lastWeatherFailMs = now;
-        return false;
+        _weatherSymbol = String("Fog");
+        _weatherColor = _matrix->color565(160, 160, 160); // gray
+        return true;
     }
-
-    auto weatherAppearanceForCode = [&](int code, String &symbol, uint16_t &color) {
-        // Map to human-readable labels and colors
-        if (code == 0)
-        {
-            symbol = String("Sunny");
-            color = _matrix->color565(255, 215, 0); // golden yellow
-            return;
-        }
-        if (code == 1 || code == 2 || code == 3)
-        {
-            symbol = String("Cloudy");
-            color = _matrix->color565(160, 160, 160); // gray
-            return;
-        }
-        if (code == 45 || code == 48)
-        {
-            symbol = String("Fog");
-            color = _matrix->color565(160, 160, 160); // gray
-            return;
-        }
-        if (code >= 51 && code <= 55)
-        {
-            symbol = String("Drizzle");
-            color = _matrix->color565(135, 206, 235); // sky blue
-            return;
-        }
-        if (code >= 56 && code <= 57)
-        {
-            symbol = String("Freezing Drizzle");
-            color = _matrix->color565(135, 206, 235);
-            return;
-        }
-        if ((code >= 61 && code <= 67) || (code >= 80 && code <= 82))
-        {
-            symbol = String("Rain");
-            color = _matrix->color565(135, 206, 235);
-            return;
-        }
-        if ((code >= 71 && code <= 77) || code == 85 || code == 86)
-        {
-            symbol = String("Snow");
-            color = _matrix->color565(255, 255, 255); // white
-            return;
-        }
-        symbol = String("Unknown");
-        color = _matrix->color565(
-            UserConfiguration::TEXT_COLOR_R,
-            UserConfiguration::TEXT_COLOR_G,
-            UserConfiguration::TEXT_COLOR_B);
-    };
-
-    bool ok = false;
-
-    if (doc["current"]["temperature_2m"].is<float>())
+    if (code >= 51 && code <= 55)
     {
-        _lastTempC = doc["current"]["temperature_2m"].as<float>();
-        _lastTempFetchMs = now;
-        outC = _lastTempC;
-        ok = true;
+        _weatherSymbol = String("Drizzle");
+        _weatherColor = _matrix->color565(135, 206, 235); // sky blue
+        return true;
     }
-
-    if (doc["current"]["weathercode"].is<int>())
+    if (code >= 56 && code <= 57)
     {
-        _lastWeatherCode = doc["current"]["weathercode"].as<int>();
-        weatherAppearanceForCode(_lastWeatherCode, _lastWeatherSymbol, _lastWeatherColor);
-        outSymbol = _lastWeatherSymbol;
-        outColor = _lastWeatherColor;
-        ok = true;
+        _weatherSymbol = String("Freezing Drizzle");
+        _weatherColor = _matrix->color565(135, 206, 235);
+        return true;
     }
-    else
+    if ((code >= 61 && code <= 67) || (code >= 80 && code <= 82))
     {
-        // Clear stale symbol if weather code missing
-        _lastWeatherCode = -1;
-        _lastWeatherSymbol = String();
-        _lastWeatherColor = _matrix->color565(
-            UserConfiguration::TEXT_COLOR_R,
-            UserConfiguration::TEXT_COLOR_G,
-            UserConfiguration::TEXT_COLOR_B);
+        _weatherSymbol = String("Rain");
+        _weatherColor = _matrix->color565(135, 206, 235);
+        return true;
     }
-
-    if (!ok)
+    if ((code >= 71 && code <= 77) || code == 85 || code == 86)
     {
-        s_lastWeatherFailMs = now;
+        _weatherSymbol = String("Snow");
+        _weatherColor = _matrix->color565(255, 255, 255); // white
+        return true;
     }
-
-    return ok;
+    _weatherSymbol = String("Unknown");
+    _weatherColor = _matrix->color565(
+        UserConfiguration::TEXT_COLOR_R,
+        UserConfiguration::TEXT_COLOR_G,
+        UserConfiguration::TEXT_COLOR_B);
+    return true;
 }
 
 void NeoMatrixDisplay::drawWeatherIcon(int16_t originX, int16_t originY, int weatherCode, uint16_t color)
@@ -395,191 +448,111 @@ void NeoMatrixDisplay::drawWeatherIcon(int16_t originX, int16_t originY, int wea
     if (_matrix == nullptr)
         return;
 
-    auto setPx = [&](int16_t dx, int16_t dy) {
-        int16_t x = originX + dx;
-        int16_t y = originY + dy;
-        if (x >= 0 && x < _matrixWidth && y >= 0 && y < _matrixHeight)
-        {
-            _matrix->drawPixel(x, y, color);
-        }
-    };
-
-    // Icon canvas ~8x8 pixels
-    auto drawSun = [&]() {
-        setPx(3, 3); // center
-        setPx(2, 3); setPx(4, 3);
-        setPx(3, 2); setPx(3, 4);
-        setPx(2, 2); setPx(4, 2);
-        setPx(2, 4); setPx(4, 4);
-        setPx(3, 1); setPx(3, 5);
-        setPx(1, 3); setPx(5, 3);
-    };
-
-    auto drawCloud = [&]() {
-        // Upper puff
-        setPx(2, 1); setPx(3, 0); setPx(4, 1);
-        // Body
-        setPx(1, 2); setPx(2, 2); setPx(3, 2); setPx(4, 2); setPx(5, 2);
-        setPx(0, 3); setPx(1, 3); setPx(2, 3); setPx(3, 3); setPx(4, 3); setPx(5, 3); setPx(6, 3);
-        setPx(1, 4); setPx(2, 4); setPx(3, 4); setPx(4, 4); setPx(5, 4);
-    };
-
-    auto drawRain = [&]() {
-        drawCloud();
-        setPx(2, 6);
-        setPx(4, 6);
-        setPx(6, 6);
-    };
-
-    auto drawSnow = [&]() {
-        drawCloud();
-        // simple snow dots under cloud
-        setPx(2, 6);
-        setPx(3, 7);
-        setPx(4, 6);
-    };
+    const RenderSurface::Color iconColor = RenderSurface::from565(color);
+    // Map weather code categories to icon
+    uint8_t icon = Sprite::WeatherUnknown;
+    if (weatherCode == 0)
+        icon = Sprite::WeatherSun;
+    else if (weatherCode == 1 || weatherCode == 2 || weatherCode == 3 || weatherCode == 45 || weatherCode == 48)
+        icon = Sprite::WeatherCloud;
+    else if ((weatherCode >= 51 && weatherCode <= 67) || (weatherCode >= 80 && weatherCode <= 82))
+        icon = Sprite::WeatherRain;
+    else if ((weatherCode >= 71 && weatherCode <= 77) || weatherCode == 85 || weatherCode == 86)
+        icon = Sprite::WeatherSnow;
+    SpriteAtlas::draw(*_surface, icon, originX, originY, 0, _surface->width(), &iconColor);
+}
 
-    auto drawFog = [&]() {
-        setPx(0, 2); setPx(1, 2); setPx(2, 2); setPx(3, 2); setPx(4, 2); setPx(5, 2); setPx(6, 2);
-        setPx(0, 4); setPx(1, 4); setPx(2, 4); setPx(3, 4); setPx(4, 4); setPx(5, 4); setPx(6, 4);
-        setPx(0, 6); setPx(1, 6); setPx(2, 6); setPx(3, 6); setPx(4, 6); setPx(5, 6); setPx(6, 6);
-    };
 
-    auto drawUnknown = [&]() {
-        setPx(3, 1); setPx(2, 2); setPx(4, 2); setPx(3, 3); setPx(3, 5); setPx(3, 7);
+void NeoMatrixDisplay::layoutPanes()
+{
+    const int chainColumns = _matrixWidth / HardwareConfiguration::DISPLAY_MATRIX_WIDTH;
+    const int chainRows = _matrixHeight / HardwareConfiguration::DISPLAY_MATRIX_HEIGHT;
+    const bool radarMode = RuntimeSettings::current().displayMode == 1;
+    const bool listMode = RuntimeSettings::current().displayMode == 2;
+    const int16_t w = _matrixWidth;
+    const int16_t h = _matrixHeight;
+
+    auto place = [](CardPane &c, int16_t x, int16_t y, int16_t pw, int16_t ph) {
+        c.x = x;
+        c.y = y;
+        c.w = pw;
+        c.h = ph;
     };
 
-    // Map weather code categories to icon
-    if (weatherCode == 0)
+    _radarPane = false;
+    _listPane = false;
+    if (chainRows > 1)
     {
-        drawSun();
-        return;
+        // Stacked panels: card on top, radar (or list) below.
+        _paneLayout = PaneLayout::Tall;
+        _cardCount = 1;
+        place(_cards[0], 0, 0, w, h / 2);
+        if (listMode)
+        {
+            _listPane = true;
+            _list.setViewport(0, h / 2, w, h - h / 2);
+        }
+        else
+        {
+            _radarPane = true;
+            _radar.setViewport(0, h / 2, w, h - h / 2);
+        }
     }
-    if (weatherCode == 1 || weatherCode == 2 || weatherCode == 3 || weatherCode == 45 || weatherCode == 48)
+    else if (chainColumns > 1)
     {
-        drawCloud();
-        return;
+        _paneLayout = PaneLayout::Wide;
+        place(_cards[0], 0, 0, w / 2, h);
+        if (radarMode)
+        {
+            _cardCount = 1;
+            _radarPane = true;
+            _radar.setViewport(w / 2, 0, w - w / 2, h);
+        }
+        else if (listMode)
+        {
+            _cardCount = 1;
+            _listPane = true;
+            _list.setViewport(w / 2, 0, w - w / 2, h);
+        }
+        else
+        {
+            _cardCount = 2;
+            place(_cards[1], w / 2, 0, w - w / 2, h);
+        }
     }
-    if ((weatherCode >= 51 && weatherCode <= 67) || (weatherCode >= 80 && weatherCode <= 82))
+    else
     {
-        drawRain();
-        return;
+        _paneLayout = PaneLayout::Single;
+        if (radarMode)
+        {
+            _cardCount = 0;
+            _radarPane = true;
+            _radar.setViewport(0, 0, w, h);
+        }
+        else if (listMode)
+        {
+            _cardCount = 0;
+            _listPane = true;
+            _list.setViewport(0, 0, w, h);
+        }
+        else
+        {
+            _cardCount = 1;
+            place(_cards[0], 0, 0, w, h);
+        }
     }
-    if ((weatherCode >= 71 && weatherCode <= 77) || weatherCode == 85 || weatherCode == 86)
+    for (uint8_t i = 0; i < kMaxCardPanes; ++i)
     {
-        drawSnow();
-        return;
+        _cards[i].layoutValid = false;
+        _cards[i].fullRedraw = true;
     }
-    drawUnknown();
-}
-
-
-String NeoMatrixDisplay::flightCacheKey(const FlightInfo &f, size_t ordinal, size_t total) const
-{
-    String key;
-    key.reserve(128);
-    key += f.ident;
-    key += '|';
-    key += f.ident_icao;
-    key += '|';
-    key += f.ident_iata;
-    key += '|';
-    key += f.operator_code;
-    key += '|';
-    key += f.operator_iata;
-    key += '|';
-    key += f.operator_icao;
-    key += '|';
-    key += f.airline_display_name_full;
-    key += '|';
-    key += f.aircraft_display_name_short;
-    key += '|';
-    key += f.aircraft_code;
-    key += '|';
-    key += f.origin.code_iata;
-    key += '|';
-    key += f.origin.code_icao;
-    key += '|';
-    key += f.destination.code_iata;
-    key += '|';
-    key += f.destination.code_icao;
-    key += '|';
-    key += String(ordinal);
-    key += '/';
-    key += String(total);
-    key += '|';
-    key += String(f.baro_altitude_m, 1);
-    key += '|';
-    key += String(f.velocity_mps, 1);
-    const auto &cfg = RuntimeSettings::current();
-    key += '|';
-    key += cfg.altitudeFeet ? String("ft") : String("m");
-    key += '|';
-    key += cfg.speedKts ? String("kts") : String("kmh");
-    return key;
+    Serial.printf("NeoMatrixDisplay: %ux%u, %u card pane(s)%s\n",
+                  (unsigned)_matrixWidth, (unsigned)_matrixHeight, (unsigned)_cardCount,
+                  _radarPane ? " + radar" : (_listPane ? " + list" : ""));
 }
 
-void NeoMatrixDisplay::prepareFlightLayout(const FlightInfo &f, size_t ordinal, size_t total)
+String NeoMatrixDisplay::aircraftName(const FlightInfo &f) const
 {
-    const int viewWidth = _matrixWidth - 2 * BORDER;
-    const int viewHeight = _matrixHeight - 2 * BORDER;
-    const int maxCols = viewWidth / CHAR_WIDTH;
-    String originCode = airportCodePreferred(f.origin);
-    String destCode   = airportCodePreferred(f.destination);
-
-    bool sameFlight = _layoutValid &&
-                      _lastLayoutOrdinal == ordinal &&
-                      _lastLayoutTotal == total &&
-                      _lastIdent == f.ident &&
-                      _lastIdentIata == f.ident_iata &&
-                      _lastIdentIcao == f.ident_icao &&
-                      _lastOriginCode == originCode &&
-                      _lastDestCode == destCode &&
-                      _lastAirlineFull == f.airline_display_name_full &&
-                      _lastOperatorIata == f.operator_iata &&
-                      _lastOperatorIcao == f.operator_icao &&
-                      _lastAircraftDisplay == f.aircraft_display_name_short &&
-                      _lastAircraftCode == f.aircraft_code;
-    if (sameFlight)
-    {
-        return;
-    }
-
-    _layoutKey = flightCacheKey(f, ordinal, total);
-    _layoutValid = true;
-    _lastLayoutOrdinal = ordinal;
-    _lastLayoutTotal = total;
-    _lastIdent = f.ident;
-    _lastIdentIata = f.ident_iata;
-    _lastIdentIcao = f.ident_icao;
-    _lastOriginCode = originCode;
-    _lastDestCode = destCode;
-    _lastAirlineFull = f.airline_display_name_full;
-    _lastOperatorIata = f.operator_iata;
-    _lastOperatorIcao = f.operator_icao;
-    _lastAircraftDisplay = f.aircraft_display_name_short;
-    _lastAircraftCode = f.aircraft_code;
-
-    _layout.airline = chooseAirlineName(f);
-    if (_layout.airline.length() == 0)
-    {
-        _layout.airline = String("Unknown");
-    }
-    _layout.airlineWidth = _layout.airline.length() * CHAR_WIDTH;
-    _layout.airlineY = BORDER + PROGRESS_BAR_HEIGHT + 1;
-    _airlineScrollActive = _layout.airlineWidth > viewWidth;
-    _airlineScrollX = BORDER;
-    _lastAirlineScrollMs = millis();
-
-    String routeGap = String("   "); // add extra spacing so arrow tip does not touch destination
-    _layout.route = truncateToColumns(originCode + routeGap + destCode, maxCols);
-    _layout.routeX = BORDER + (viewWidth - (int)_layout.route.length() * CHAR_WIDTH) / 2;
-    if (_layout.routeX < BORDER) _layout.routeX = BORDER;
-    _layout.routeY = _layout.airlineY + CHAR_HEIGHT + LINE_GAP + 2;
-    int originChars = originCode.length();
-    _layout.arrowX = _layout.routeX + originChars * CHAR_WIDTH + CHAR_WIDTH; // one character gap before arrow
-    _layout.arrowY = _layout.routeY; // fits within the 8px text row
-
     auto detectMaker = [&](const String &code, const String &display) -> String {
         String first = firstWord(display);
         String lower = first;
@@ -624,262 +597,633 @@ void NeoMatrixDisplay::prepareFlightLayout(const FlightInfo &f, size_t ordinal,
         if (modelOnly.length() == 0)
             modelOnly = displayModel;
     }
+    return maker.length() ? (maker + String(" ") + modelOnly) : modelOnly;
+}
 
-    String combined = maker.length() ? (maker + String(" ") + modelOnly) : modelOnly;
-    bool combinedFits = ((int)combined.length() * CHAR_WIDTH) <= viewWidth;
-    int16_t modelY = _layout.routeY + CHAR_HEIGHT + LINE_GAP;
-
-    _layout.hasModel2 = false;
-    if (combinedFits)
+String NeoMatrixDisplay::cardFieldText(CardLayout::Field field, const FlightInfo &f, double altitudeM) const
+{
+    using CardLayout::Field;
+    switch (field)
+    {
+    case Field::Airline:
     {
-        _layout.modelLine1 = truncateToColumns(combined, maxCols);
-        _layout.model1X = BORDER + (viewWidth - (int)_layout.modelLine1.length() * CHAR_WIDTH) / 2;
-        if (_layout.model1X < BORDER) _layout.model1X = BORDER;
-        _layout.model1Y = modelY;
+        String airline = chooseAirlineName(f);
+        return airline.length() ? airline : String("Unknown");
     }
-    else
+    case Field::OriginCode:
+        return airportCodePreferred(f.origin);
+    case Field::DestCode:
+        return airportCodePreferred(f.destination);
+    case Field::OriginCity:
+    case Field::DestCity:
     {
-        String makerLine = maker.length() ? maker : firstWord(modelOnly);
-        makerLine = truncateToColumns(makerLine, maxCols);
-        _layout.modelLine1 = makerLine;
-        _layout.model1X = BORDER + (viewWidth - (int)makerLine.length() * CHAR_WIDTH) / 2;
-        if (_layout.model1X < BORDER) _layout.model1X = BORDER;
-        _layout.model1Y = modelY;
-
-        String modelLine = truncateToColumns(modelOnly, maxCols);
-        _layout.modelLine2 = modelLine;
-        _layout.model2X = BORDER + (viewWidth - (int)modelLine.length() * CHAR_WIDTH) / 2;
-        if (_layout.model2X < BORDER) _layout.model2X = BORDER;
-        _layout.model2Y = modelY + CHAR_HEIGHT + 1;
-        _layout.hasModel2 = (_layout.model2Y + CHAR_HEIGHT <= (_matrixHeight - BORDER));
-    }
-
-    String originFull = airportCity(f.origin);
-    originFull.trim();
-    if (!originFull.length())
-        originFull = String("---");
-    String destFull = airportCity(f.destination);
-    destFull.trim();
-    if (!destFull.length())
-        destFull = String("---");
-
-    String cityLine = originFull + String("   ") + destFull;
-    const int originCityChars = originFull.length();
-    const int destCityChars = destFull.length();
-    const int cityGapChars = 3;
-
-    auto chooseCallsign = [&]() -> String {
+        String city = airportCity(field == Field::OriginCity ? f.origin : f.destination);
+        city.trim();
+        return city.length() ? city : String("---");
+    }
+    case Field::Aircraft:
+        return aircraftName(f);
+    case Field::AircraftCode:
+        return f.aircraft_code.length() ? f.aircraft_code : String("--");
+    case Field::Callsign:
         if (f.ident_iata.length()) return f.ident_iata;
         if (f.ident.length()) return f.ident;
         if (f.ident_icao.length()) return f.ident_icao;
         return String("--");
+    case Field::Altitude:
+        if (isnan(altitudeM))
+            return String("--");
+        if (RuntimeSettings::current().altitudeFeet)
+            return String(lround(altitudeM * 3.28084)) + String("ft");
+        return String(lround(altitudeM)) + String("m");
+    case Field::Speed:
+        if (isnan(f.velocity_mps))
+            return String("--");
+        if (RuntimeSettings::current().speedKts)
+            return String(lround(f.velocity_mps * 1.943844f)) + String("kt");
+        return String(lround(f.velocity_mps * 3.6)) + String("km/h");
+    default:
+        return String();
+    }
+}
+
+String NeoMatrixDisplay::truncateToWidth(const String &text, int16_t width, TextStrip::Font font)
+{
+    if (font == TextStrip::Font::Glcd)
+        return truncateToColumns(text, width / CHAR_WIDTH);
+    if (TextStrip::measure(text, font) <= width)
+        return text;
+    String cut = text;
+    while (cut.length() > 0)
+    {
+        cut.remove(cut.length() - 1);
+        String candidate = cut + String("...");
+        if (TextStrip::measure(candidate, font) <= width)
+            return candidate;
+    }
+    return String();
+}
+
+NeoMatrixDisplay::LayoutChange NeoMatrixDisplay::prepareFlightLayout(CardPane &c, const FlightInfo &f, double altitudeM,
+                                                                     size_t ordinal, size_t total)
+{
+    using namespace CardLayout;
+
+    // Flights from the fetcher carry a version stamp; hash anything else on the fly.
+    const uint32_t version = f.version != 0 ? f.version : flightDisplayVersion(f);
+    // The altitude shown is extrapolated, so it is part of the metrics stamp too.
+    const uint32_t metrics = fnv1a(flightMetricsVersion(f), &altitudeM, sizeof(altitudeM));
+    const uint8_t designIndex = RuntimeSettings::current().cardDesign;
+    const bool sameCard = c.layoutValid && c.layoutVersion == version && c.design == designIndex;
+    const bool progressMoved = c.ordinal != ordinal || c.total != total;
+    if (sameCard && c.metricsVersion == metrics)
+    {
+        if (!progressMoved)
+            return LayoutChange::None;
+        // Same card, new place in the cycle: only the progress bar changes.
+        c.ordinal = ordinal;
+        c.total = total;
+        c.progressDirty = true;
+        return LayoutChange::Partial;
+    }
+
+    // New live metrics on the same card are laid out again too; lines that come out the
+    // same keep their marquee position and are not repainted (see the end).
+    CardLine previous[kMaxLines];
+    const uint8_t previousCount = sameCard ? c.lineCount : 0;
+    const bool previousScrolling = c.scrolling;
+    const unsigned long previousScrollMs = c.lastScrollMs;
+    for (uint8_t i = 0; i < previousCount; ++i)
+        previous[i] = c.lines[i];
+
+    c.layoutValid = true;
+    c.layoutVersion = version;
+    c.metricsVersion = metrics;
+    c.dirtyLines = 0;
+    c.progressDirty = false;
+    c.ordinal = ordinal;
+    c.total = total;
+    c.design = designIndex;
+    c.lineCount = 0;
+    c.pieceCount = 0;
+    c.stripCount = 0;
+    c.progressHeight = 0;
+    c.scrolling = false;
+    c.lastScrollMs = millis();
+
+    // Everything is placed relative to the pane, so the same design fits any pane size.
+    const Design &design = CardLayout::design(designIndex);
+    const int16_t left = c.x + BORDER;
+    const int16_t top = c.y + BORDER;
+    const int16_t bottom = c.y + c.h - BORDER;
+    const int16_t viewWidth = c.w - 2 * BORDER;
+    const bool compact = FW_CARD_COMPACT_FONT;
+
+    auto rowHeight = [](const Row &r) -> int16_t {
+        return r.kind == RowKind::Progress ? r.height : TextStrip::kHeight;
     };
 
-    String altStr("--");
-    if (!isnan(f.baro_altitude_m))
+    // Top rows stack down from the pane top; bottom rows fill up to the pane bottom.
+    int16_t topCursor = top;
+    int16_t bottomCursor = bottom;
+    for (uint8_t i = 0; i < design.rowCount; ++i)
     {
-        const auto &cfg = RuntimeSettings::current();
-        if (cfg.altitudeFeet)
+        const Row &r = row(design, i);
+        if (r.anchor == Anchor::Bottom)
+            bottomCursor -= r.gap + rowHeight(r);
+    }
+
+    struct Draft
+    {
+        Field field;
+        String text;
+        int16_t gap;
+        int16_t width;
+        ColorRole role;
+    };
+    Draft drafts[kMaxPieces];
+
+    // Adds one laid-out line (and its pieces and strips) if it fits above the pane bottom
+    // and in the card's tables. A line that is dropped takes its fixed pieces with it.
+    auto addLine = [&](const Row &r, int16_t y, const Draft *parts, uint8_t partCount,
+                       int16_t fixedWidth, uint8_t fixedPieces, uint8_t fixedFirst) {
+        uint8_t strips = 0;
+        for (uint8_t p = 0; p < partCount; ++p)
+            strips += parts[p].field != Field::Arrow ? 1 : 0;
+        if (y < top || y + TextStrip::kHeight > bottom || c.lineCount >= kMaxLines ||
+            c.pieceCount + partCount > kMaxPieces || c.stripCount + strips > kMaxStrips)
         {
-            long altFeet = lround(f.baro_altitude_m * 3.28084);
-            altStr = String(altFeet) + String("ft");
+            c.pieceCount = fixedFirst;
+            return;
         }
-        else
+        const TextStrip::Font font = compact ? r.font : TextStrip::Font::Glcd;
+        CardLine &line = c.lines[c.lineCount++];
+        line = CardLine();
+        line.y = y;
+        line.firstPiece = fixedFirst;
+        line.fixedPieces = fixedPieces;
+        line.home = left + fixedWidth;
+        line.clipX0 = fixedPieces > 0 ? line.home : c.x;
+
+        int16_t cursor = 0;
+        uint32_t hash = 2166136261u;
+        for (uint8_t p = 0; p < partCount; ++p)
         {
-            long altMeters = lround(f.baro_altitude_m);
-            altStr = String(altMeters) + String("m");
+            hash = fnv1a(hash, parts[p].text.c_str(), parts[p].text.length() + 1);
+            hash = fnv1a(hash, &parts[p].gap, sizeof(parts[p].gap));
+            hash = fnv1a(hash, &parts[p].role, sizeof(parts[p].role));
+            CardPiece &piece = c.pieces[c.pieceCount++];
+            piece.field = parts[p].field;
+            piece.color = cardColor(parts[p].role);
+            piece.offset = cursor + parts[p].gap;
+            if (piece.field != Field::Arrow)
+            {
+                piece.strip = c.stripCount++;
+                c.strips[piece.strip].render(parts[p].text, font);
+            }
+            cursor = piece.offset + parts[p].width;
         }
-    }
+        line.pieceCount = fixedPieces + partCount;
+        line.width = cursor;
+        line.contentHash = hash;
+
+        const int16_t room = viewWidth - fixedWidth;
+        line.marquee = r.overflow == Overflow::Marquee && line.width > room;
+        line.x = line.home;
+        if (!line.marquee && line.width < room)
+        {
+            if (r.align == Align::Center)
+                line.x += (room - line.width) / 2;
+            else if (r.align == Align::Right)
+                line.x += room - line.width;
+        }
+        line.scrollX = line.x;
+        line.drawnX = line.x;
+        c.scrolling = c.scrolling || line.marquee;
+    };
 
-    String speedStr("--");
-    if (!isnan(f.velocity_mps))
+    for (uint8_t i = 0; i < design.rowCount; ++i)
     {
-        const auto &cfg = RuntimeSettings::current();
-        if (cfg.speedKts)
+        const Row &r = row(design, i);
+        int16_t y = 0;
+        if (r.anchor == Anchor::Top)
         {
-            long kts = lround(f.velocity_mps * 1.943844f);
-            speedStr = String(kts) + String("kt");
+            topCursor += r.gap;
+            y = topCursor;
+            topCursor += rowHeight(r);
         }
         else
         {
-            long kmh = lround(f.velocity_mps * 3.6);
-            speedStr = String(kmh) + String("km/h");
+            y = bottomCursor;
+            bottomCursor += rowHeight(r) + r.gap;
         }
-    }
-
-    String callsign = chooseCallsign();
-    String metricsLine = callsign + String("  -  ") + altStr + String("  -  ") + speedStr;
-
-    int16_t bottomY1 = BORDER + viewHeight - (2 * CHAR_HEIGHT) - LINE_GAP;
-    if (bottomY1 < BORDER) bottomY1 = BORDER;
-    _layout.originY = bottomY1;
-    _layout.destY = bottomY1 + CHAR_HEIGHT + 1;
-    _layout.showDest = (_layout.destY + CHAR_HEIGHT <= (_matrixHeight - BORDER));
-
-    _layout.originName = cityLine;
-    _layout.destName   = metricsLine;
-
-    _layout.originWidth = _layout.originName.length() * CHAR_WIDTH;
-    _layout.destWidth = _layout.destName.length() * CHAR_WIDTH;
-    _layout.originCityChars = originCityChars;
-    _layout.destCityChars = destCityChars;
-    _layout.cityArrowOffset = originCityChars * CHAR_WIDTH + CHAR_WIDTH; // one character gap after origin
-    _layout.originScrollActive = _layout.originWidth > viewWidth;
-    _layout.destScrollActive = _layout.showDest && (_layout.destWidth > viewWidth);
-    _originScrollX = BORDER;
-    _destScrollX = BORDER;
-    _lastCityScrollMs = millis();
-}
 
-void NeoMatrixDisplay::updateAirlineScroll(unsigned long now)
-{
-    if (!_airlineScrollActive || !_layoutValid)
-        return;
+        if (r.kind == RowKind::Progress)
+        {
+            c.progressY = y;
+            c.progressHeight = r.height;
+            continue;
+        }
 
-    if (_lastAirlineScrollMs == 0)
-    {
-        _lastAirlineScrollMs = now;
-    }
+        const TextStrip::Font font = compact ? r.font : TextStrip::Font::Glcd;
+        const uint8_t fixedFirst = c.pieceCount;
+        uint8_t fixedPieces = 0;
+        int16_t fixedWidth = 0;
+        uint8_t count = 0;
 
-    if (now <= _lastAirlineScrollMs)
-        return;
+        // Fields become drafts; adjacent text of one color merges into a single strip.
+        for (uint8_t s = 0; s < r.segmentCount; ++s)
+        {
+            const Segment &seg = segment(r, s);
+            if (seg.field == Field::AirlineFin)
+            {
+                const int sprite = SpriteAtlas::airlineSprite(f.operator_icao);
+                if (sprite < 0 || c.pieceCount >= kMaxPieces)
+                    continue;
+                CardPiece &piece = c.pieces[c.pieceCount++];
+                piece.field = Field::AirlineFin;
+                piece.sprite = (uint8_t)sprite;
+                piece.offset = fixedWidth;
+                fixedWidth += SpriteAtlas::width((uint8_t)sprite);
+                fixedPieces++;
+                continue;
+            }
 
-    unsigned long delta = now - _lastAirlineScrollMs;
-    if (delta < MARQUEE_FRAME_MS)
-        return;
+            int16_t gap = seg.gap;
+            if (count == 0)
+            {
+                // A leading gap only separates the line from a fixed piece before it.
+                if (fixedPieces > 0)
+                    fixedWidth += gap;
+                gap = 0;
+            }
+            if (seg.field == Field::Arrow)
+            {
+                drafts[count++] = Draft{Field::Arrow, String(), gap, ARROW_WIDTH, seg.color};
+                continue;
+            }
+            const String text = seg.field == Field::Literal ? String(seg.text) : cardFieldText(seg.field, f, altitudeM);
+            Draft *prev = count > 0 ? &drafts[count - 1] : nullptr;
+            if (prev && prev->field != Field::Arrow && gap == 0 && prev->role == seg.color)
+            {
+                prev->text += text;
+                continue;
+            }
+            drafts[count++] = Draft{Field::Literal, text, gap, 0, seg.color};
+        }
 
-    unsigned long steps = delta / MARQUEE_FRAME_MS;
-    _lastAirlineScrollMs += steps * MARQUEE_FRAME_MS;
+        int16_t width = 0;
+        for (uint8_t d = 0; d < count; ++d)
+        {
+            if (drafts[d].field != Field::Arrow)
+                drafts[d].width = TextStrip::measure(drafts[d].text, font);
+            width += drafts[d].gap + drafts[d].width;
+        }
+        const int16_t room = viewWidth - fixedWidth;
 
-    const int viewWidth = _matrixWidth - 2 * BORDER;
+        if (r.overflow == Overflow::Wrap && count == 1 && width > room)
+        {
+            // Break at the first space ("Airbus" / "A350-900"), each line truncated to fit.
+            const String &text = drafts[0].text;
+            const int space = text.indexOf(' ');
+            if (space > 0)
+            {
+                Draft second = drafts[0];
+                second.text = truncateToWidth(text.substring(space + 1), room, font);
+                second.width = TextStrip::measure(second.text, font);
+                drafts[0].text = truncateToWidth(text.substring(0, space), room, font);
+                drafts[0].width = TextStrip::measure(drafts[0].text, font);
+                addLine(r, y, drafts, 1, fixedWidth, fixedPieces, fixedFirst);
+                const int16_t secondY = y + TextStrip::kHeight + r.lineGap;
+                addLine(r, secondY, &second, 1, fixedWidth, 0, c.pieceCount);
+                // The second line pushes the rows after it on the same side.
+                const int16_t extra = secondY + TextStrip::kHeight - (y + rowHeight(r));
+                if (r.anchor == Anchor::Top)
+                    topCursor += extra;
+                else
+                    bottomCursor += extra;
+                continue;
+            }
+        }
+        if ((r.overflow == Overflow::Wrap || r.overflow == Overflow::Truncate) && width > room)
+        {
+            for (int d = count - 1; d >= 0; --d)
+            {
+                if (drafts[d].field == Field::Arrow)
+                    continue;
+                const int16_t others = width - drafts[d].width;
+                drafts[d].text = truncateToWidth(drafts[d].text, room - others, font);
+                drafts[d].width = TextStrip::measure(drafts[d].text, font);
+                break;
+            }
+        }
+        addLine(r, y, drafts, count, fixedWidth, fixedPieces, fixedFirst);
+    }
 
-    _airlineScrollX -= (int16_t)(steps * MARQUEE_SPEED_PX);
-    int16_t reset = BORDER + viewWidth + MARQUEE_GAP_PX;
-    int16_t minX = BORDER - (_layout.airlineWidth + MARQUEE_GAP_PX);
-    if (_airlineScrollX < minX)
+    if (!sameCard || c.lineCount != previousCount)
+        return LayoutChange::Full;
+    for (uint8_t i = 0; i < c.lineCount; ++i)
     {
-        _airlineScrollX = reset;
+        CardLine &line = c.lines[i];
+        const CardLine &old = previous[i];
+        if (line.y != old.y)
+            return LayoutChange::Full;
+        if (line.contentHash == old.contentHash && line.x == old.x && line.marquee == old.marquee)
+        {
+            line.scrollX = old.scrollX;
+            line.drawnX = old.drawnX;
+            continue;
+        }
+        // A marquee whose text changed keeps scrolling from where it was.
+        if (line.marquee && old.marquee)
+            line.scrollX = old.scrollX;
+        c.dirtyLines |= (uint8_t)(1u << i);
     }
+    if (c.scrolling && previousScrolling)
+        c.lastScrollMs = previousScrollMs;
+    c.progressDirty = progressMoved;
+    return LayoutChange::Partial;
 }
 
-void NeoMatrixDisplay::updateCityScrolls(unsigned long now)
+void NeoMatrixDisplay::updateMarquees(CardPane &c, unsigned long now)
 {
-    bool anyScroll = (_layout.originScrollActive || _layout.destScrollActive);
-    if (!anyScroll || !_layoutValid)
+    if (!c.scrolling || !c.layoutValid)
         return;
 
-    const int viewWidth = _matrixWidth - 2 * BORDER;
-
-    if (_lastCityScrollMs == 0)
+    if (c.lastScrollMs == 0)
     {
-        _lastCityScrollMs = now;
+        c.lastScrollMs = now;
     }
 
-    if (now <= _lastCityScrollMs)
+    if (now <= c.lastScrollMs)
         return;
 
-    unsigned long delta = now - _lastCityScrollMs;
+    unsigned long delta = now - c.lastScrollMs;
     if (delta < MARQUEE_FRAME_MS)
         return;
 
     unsigned long steps = delta / MARQUEE_FRAME_MS;
-    _lastCityScrollMs += steps * MARQUEE_FRAME_MS;
+    c.lastScrollMs += steps * MARQUEE_FRAME_MS;
 
-    auto advance = [&](int16_t &x, int16_t width) {
-        x -= (int16_t)(steps * MARQUEE_SPEED_PX);
-        int16_t reset = BORDER + viewWidth + MARQUEE_GAP_PX;
-        int16_t minX = BORDER - (width + MARQUEE_GAP_PX);
-        if (x < minX)
+    const int16_t left = c.x + BORDER;
+    const int viewWidth = c.w - 2 * BORDER;
+
+    for (uint8_t i = 0; i < c.lineCount; ++i)
+    {
+        CardLine &line = c.lines[i];
+        if (!line.marquee)
+            continue;
+        line.scrollX -= (int16_t)(steps * MARQUEE_SPEED_PX);
+        int16_t reset = left + viewWidth + MARQUEE_GAP_PX;
+        int16_t minX = line.home - (line.width + MARQUEE_GAP_PX);
+        if (line.scrollX < minX)
         {
-            x = reset;
+            line.scrollX = reset;
         }
-    };
+    }
+}
 
-    if (_layout.originScrollActive)
+void NeoMatrixDisplay::drawCardLine(const CardPane &c, const CardLine &line)
+{
+    const int16_t left = c.x + BORDER;
+    for (uint8_t p = 0; p < line.fixedPieces; ++p)
     {
-        advance(_originScrollX, _layout.originWidth);
+        const CardPiece &piece = c.pieces[line.firstPiece + p];
+        SpriteAtlas::draw(*_target, piece.sprite, left + piece.offset, line.y, _clipX0, _clipX1);
     }
-    if (_layout.destScrollActive)
+
+    // The scrolling part passes behind fixed pieces, not over them.
+    const int16_t paneClipX0 = _clipX0;
+    if (line.clipX0 > _clipX0)
+        _clipX0 = line.clipX0;
+    for (uint8_t p = line.fixedPieces; p < line.pieceCount; ++p)
     {
-        advance(_destScrollX, _layout.destWidth);
+        const CardPiece &piece = c.pieces[line.firstPiece + p];
+        if (piece.field == CardLayout::Field::Arrow)
+            drawArrow(line.scrollX + piece.offset, line.y, piece.color);
+        else
+            drawStrip(c.strips[piece.strip], line.scrollX + piece.offset, line.y, piece.color);
     }
+    _clipX0 = paneClipX0;
 }
 
-void NeoMatrixDisplay::displaySingleFlightCard(const FlightInfo &f, size_t ordinal, size_t total)
+void NeoMatrixDisplay::drawCardContent(const CardPane &c, bool all)
 {
-    const uint16_t textColor = _matrix->color565(
-        UserConfiguration::TEXT_COLOR_R,
-        UserConfiguration::TEXT_COLOR_G,
-        UserConfiguration::TEXT_COLOR_B);
-    const uint16_t originAccent = _matrix->color565(80, 200, 200); // soft teal
-    const uint16_t destAccent = _matrix->color565(255, 200, 80);   // soft amber
-    const uint16_t arrowColor = _matrix->color565(255, 255, 255);  // keep arrows white
-    const uint16_t dimTextColor = _matrix->color565(
-        UserConfiguration::TEXT_COLOR_R / 3,
-        UserConfiguration::TEXT_COLOR_G / 3,
-        UserConfiguration::TEXT_COLOR_B / 3);
-    unsigned long now    = millis();
-
-    prepareFlightLayout(f, ordinal, total);
-    updateAirlineScroll(now);
-    updateCityScrolls(now);
-
-    _matrix->fillScreen(0);
-
     // Progress bar at top showing current flight when multiple flights
-    const int viewWidth = _matrixWidth - 2 * BORDER;
-    if (total > 1)
+    const int16_t left = c.x + BORDER;
+    const int viewWidth = c.w - 2 * BORDER;
+    if ((all || c.progressDirty) && c.total > 1 && c.progressHeight > 0)
     {
+        const RenderSurface::Color textColor = cardColor(CardLayout::ColorRole::Text);
+        const RenderSurface::Color dimTextColor = cardColor(CardLayout::ColorRole::Dim);
         const int gap = 1;
-        const int available = viewWidth - gap * (int)(total - 1);
-        int baseWidth = available / (int)total;
-        int remainder = available - baseWidth * (int)total;
-        int16_t segmentX = BORDER;
-        for (size_t i = 0; i < total; ++i)
+        const int available = viewWidth - gap * (int)(c.total - 1);
+        int baseWidth = available / (int)c.total;
+        int remainder = available - baseWidth * (int)c.total;
+        int16_t segmentX = left;
+        for (size_t i = 0; i < c.total; ++i)
         {
             int segWidth = baseWidth + (remainder > 0 ? 1 : 0);
             if (remainder > 0) remainder--;
-            uint16_t color = (i == (ordinal - 1)) ? textColor : dimTextColor;
-            _matrix->fillRect(segmentX, BORDER, segWidth, PROGRESS_BAR_HEIGHT, color);
+            const RenderSurface::Color &color = (i == (c.ordinal - 1)) ? textColor : dimTextColor;
+            _target->fillRect(segmentX, c.progressY, segWidth, c.progressHeight, color);
             segmentX += segWidth + gap;
         }
     }
 
-    int16_t airlineX = _airlineScrollActive ? _airlineScrollX : BORDER;
-    drawTextLine(airlineX, _layout.airlineY, _layout.airline, textColor);
+    // Static lines only change with the layout or their text; marquees whenever they moved.
+    for (uint8_t i = 0; i < c.lineCount; ++i)
+    {
+        const CardLine &line = c.lines[i];
+        if (all || (c.dirtyLines & (1u << i)) || (line.marquee && line.scrollX != line.drawnX))
+            drawCardLine(c, line);
+    }
+}
+
+bool NeoMatrixDisplay::displaySingleFlightCard(CardPane &c, const FlightInfo &f, size_t ordinal, size_t total)
+{
+    unsigned long now    = millis();
 
-    // Draw route with per-segment colors
-    int16_t routeDestX = _layout.routeX + (int16_t)(_lastOriginCode.length() * CHAR_WIDTH) + (int16_t)(3 * CHAR_WIDTH);
-    drawTextLine(_layout.routeX, _layout.routeY, _lastOriginCode, originAccent);
-    auto drawArrow = [&](int16_t x, int16_t y, uint16_t color) {
-        // Solid right-pointing triangle, 6px wide, 7px tall
-        _matrix->fillTriangle(
-            x,     y,          // point A
-            x,     y + 7,      // point B
-            x + 6, y + 3,      // tip
-            color);
-    };
-    drawArrow(_layout.arrowX, _layout.arrowY, arrowColor);
-    drawTextLine(routeDestX, _layout.routeY, _lastDestCode, destAccent);
-    drawTextLine(_layout.model1X, _layout.model1Y, _layout.modelLine1, textColor);
-    if (_layout.hasModel2)
+    const double altitudeM = cardAltitude(f, now, c.nextAltitudeMs);
+    if (prepareFlightLayout(c, f, altitudeM, ordinal, total) == LayoutChange::Full)
+    {
+        c.fullRedraw = true;
+    }
+    updateMarquees(c, now);
+
+    // Marquee rows are pane-wide bands (text may run into the border column); otherwise
+    // only lines whose text changed in place and the progress bar are repainted until the
+    // layout is rebuilt. With double buffering, a card painted last frame is still old in
+    // the buffer now behind, so it is repainted whole there once.
+    bool anyMoved = c.dirtyLines != 0 || c.progressDirty;
+    for (uint8_t i = 0; i < c.lineCount; ++i)
+        anyMoved = anyMoved || c.lines[i].scrollX != c.lines[i].drawnX;
+    const bool changed = c.fullRedraw || anyMoved;
+    const bool full = c.fullRedraw || c.backStale;
+    _damage.clear();
+    if (full)
+    {
+        _damage.add(c.x, c.y, c.w, c.h);
+    }
+    else
     {
-        drawTextLine(_layout.model2X, _layout.model2Y, _layout.modelLine2, textColor);
+        if (c.progressDirty && c.progressHeight > 0)
+            _damage.add(c.x, c.progressY, c.w, c.progressHeight);
+        for (uint8_t i = 0; i < c.lineCount; ++i)
+        {
+            if (c.lines[i].scrollX != c.lines[i].drawnX || (c.dirtyLines & (1u << i)))
+                _damage.add(c.x, c.lines[i].y, c.w, TextStrip::kHeight);
+        }
+    }
+    if (_damage.empty())
+    {
+        recordFrame(false, 0);
+        return false;
     }
 
-    int16_t originX = _layout.originScrollActive ? _originScrollX : BORDER;
-    const int16_t cityDestOffset = (int16_t)(_layout.originCityChars * CHAR_WIDTH) + (int16_t)(3 * CHAR_WIDTH);
+    // Marquees scroll through the pane only, never into a neighbouring card.
+    _clipX0 = c.x;
+    _clipX1 = c.x + c.w;
 
-    drawTextLine(originX, _layout.originY, _layout.originName.substring(0, _layout.originCityChars), originAccent);
-    drawArrow(originX + _layout.cityArrowOffset, _layout.originY, arrowColor);
-    int16_t cityDestX = originX + cityDestOffset;
-    drawTextLine(cityDestX, _layout.originY, _layout.originName.substring(_layout.originCityChars + 3), destAccent);
-    if (_layout.showDest)
+    uint32_t visibleWriteUs = 0;
+    if (!full && _band.ready())
     {
-        int16_t destX = _layout.destScrollActive ? _destScrollX : BORDER;
-        drawTextLine(destX, _layout.destY, _layout.destName, textColor);
+        // Compose each damaged band off-screen; only the commit touches the panel.
+        for (uint8_t i = 0; i < _damage.count(); ++i)
+        {
+            const DirtyRegion::Rect &r = _damage[i];
+            for (int16_t bandY = r.y; bandY < r.y + r.h; bandY += BandSurface::kRows)
+            {
+                _band.setOrigin(bandY);
+                _band.clear();
+                _target = &_band;
+                drawCardContent(c, true); // the commit writes whole band rows
+                _target = _surface;
+                const uint32_t startUs = micros();
+                _band.commit(*_surface, c.x, c.x + c.w);
+                const uint32_t commitUs = micros() - startUs;
+                if (commitUs > visibleWriteUs)
+                    visibleWriteUs = commitUs;
+            }
+        }
+    }
+    else
+    {
+        const uint32_t startUs = micros();
+        if (full)
+        {
+            _surface->fillRect(c.x, c.y, c.w, c.h, RenderSurface::Color());
+        }
+        else
+        {
+            for (uint8_t i = 0; i < _damage.count(); ++i)
+            {
+                const DirtyRegion::Rect &r = _damage[i];
+                _surface->fillRect(r.x, r.y, r.w, r.h, RenderSurface::Color());
+            }
+        }
+        drawCardContent(c, full);
+        visibleWriteUs = micros() - startUs;
+    }
+    if (!full && visibleWriteUs > _renderStats.maxVisibleWriteUs)
+    {
+        _renderStats.maxVisibleWriteUs = visibleWriteUs;
     }
 
+    _clipX0 = 0;
+    _clipX1 = _matrixWidth;
+
+    for (uint8_t i = 0; i < c.lineCount; ++i)
+        c.lines[i].drawnX = c.lines[i].scrollX;
+    c.fullRedraw = false;
+    c.dirtyLines = 0;
+    c.progressDirty = false;
+    c.blank = false;
+    c.backStale = FW_DISPLAY_TEAR_MODE == 2 && changed;
+    recordFrame(full, (uint32_t)_damage.area());
+    return true;
+}
+
+bool NeoMatrixDisplay::clearCardPane(CardPane &c)
+{
+    if (c.blank && !c.fullRedraw && !c.backStale)
+        return false;
+    const bool changed = !c.blank || c.fullRedraw;
+    _surface->fillRect(c.x, c.y, c.w, c.h, RenderSurface::Color());
+    c.layoutValid = false;
+    c.fullRedraw = false;
+    c.blank = true;
+    c.backStale = FW_DISPLAY_TEAR_MODE == 2 && changed;
+    return true;
+}
+
+void NeoMatrixDisplay::mirrorBackBuffer()
+{
+#if FW_DISPLAY_TEAR_MODE == 2
+    // Panes as last painted, from their cached state; nothing advances.
+    for (uint8_t i = 0; i < _cardCount; ++i)
+    {
+        CardPane &c = _cards[i];
+        if (!c.backStale)
+            continue;
+        _surface->fillRect(c.x, c.y, c.w, c.h, RenderSurface::Color());
+        if (!c.blank && c.layoutValid)
+        {
+            _clipX0 = c.x;
+            _clipX1 = c.x + c.w;
+            drawCardContent(c, true);
+            _clipX0 = 0;
+            _clipX1 = _matrixWidth;
+        }
+        c.backStale = false;
+    }
+    if (_radarPane && _radarBackStale)
+    {
+        _surface->fillRect(_radar.viewX(), _radar.viewY(), _radar.viewWidth(), _radar.viewHeight(), RenderSurface::Color());
+        _radar.draw(*_surface);
+        _radarBackStale = false;
+    }
+    if (_listPane && _listBackStale)
+    {
+        _surface->fillRect(_list.viewX(), _list.viewY(), _list.viewWidth(), _list.viewHeight(), RenderSurface::Color());
+        for (uint8_t row = 0; row < _list.rows(); ++row)
+            _list.draw(*_surface, row);
+        _listBackStale = false;
+    }
+#endif
+}
+
+void NeoMatrixDisplay::recordFrame(bool full, uint32_t pixelWrites)
+{
+    RenderStats &st = _renderStats;
+    if (full)
+        st.fullFrames++;
+    else if (pixelWrites > 0)
+        st.partialFrames++;
+    else
+        st.idleFrames++;
+    st.pixelWrites += pixelWrites;
+
+    const unsigned long now = millis();
+    if (st.windowStartMs == 0)
+    {
+        st.windowStartMs = now;
+        return;
+    }
+    if (now - st.windowStartMs < RENDER_STATS_WINDOW_MS)
+        return;
+
+    const uint32_t frames = st.fullFrames + st.partialFrames + st.idleFrames;
+    Serial.printf("NeoMatrixDisplay: %u frames in %lu ms (full %u, partial %u, unchanged %u), %u px written/frame, longest partial write %u us\n",
+                  frames,
+                  now - st.windowStartMs,
+                  st.fullFrames,
+                  st.partialFrames,
+                  st.idleFrames,
+                  frames ? st.pixelWrites / frames : 0,
+                  st.maxVisibleWriteUs);
+    st = RenderStats();
+    st.windowStartMs = now;
 }
 
 void NeoMatrixDisplay::displayFlights(const std::vector<FlightInfo> &flights)
@@ -887,38 +1231,272 @@ void NeoMatrixDisplay::displayFlights(const std::vector<FlightInfo> &flights)
     if (_matrix == nullptr)
         return;
 
-    if (flights.empty())
+    // A running animation owns the panel; the screen underneath resumes when it ends.
+    if (_anim.active() && tickAnimation())
+        return;
+#if FW_DISPLAY_TEAR_MODE == 2
+    if (millis() - _lastFlipMs < FLIP_SETTLE_MS)
     {
-        _layoutValid = false;
-        _layoutKey = String();
+        _nextChangeMs = _lastFlipMs + FLIP_SETTLE_MS;
+        return;
+    }
+#endif
+
+    // The radar and list are worth showing with unenriched aircraft too; with nothing at
+    // all, show the clock.
+    const bool radarShown = _radarPane && _radar.count() > 0;
+    const bool listShown = _listPane && _list.count() > 0;
+    const unsigned long now         = millis();
+    const unsigned long baseDwellMs = TimingConfiguration::DISPLAY_CYCLE_SECONDS * 1000UL;
+    if (_snapshot.update(flights))
+    {
+        // Same aircraft stay current; only their changed metrics get repainted.
+        _playlist.update(flights, _snapshot, (float)RuntimeSettings::current().radiusKm, baseDwellMs);
+    }
+    const size_t shown = _playlist.size();
+    if (shown == 0 && !radarShown && !listShown)
+    {
+        for (uint8_t i = 0; i < _cardCount; ++i)
+        {
+            _cards[i].layoutValid = false;
+        }
         displayLoadingScreen();
         return;
     }
 
-    const unsigned long now        = millis();
-    const unsigned long intervalMs = TimingConfiguration::DISPLAY_CYCLE_SECONDS * 1000UL;
-
-    if (flights.size() > 1)
+    // Each step of the cycle shows the next _cardCount flights of the playlist, for as
+    // long as the most relevant of them dwells.
+    const bool cycling = _cardCount > 0 && shown > _cardCount;
+    if (cycling)
     {
-        if (now - _lastCycleMs >= intervalMs)
+        if (now - _lastCycleMs >= _playlist.dwellMs(_cardCount))
         {
             _lastCycleMs = now;
-            _currentFlightIndex = (_currentFlightIndex + 1) % flights.size();
+            _playlist.advance(_cardCount);
         }
     }
     else
     {
-        _currentFlightIndex = 0;
+        _playlist.rewind();
     }
 
-    const size_t index = _currentFlightIndex % flights.size();
-    if (_lastDisplayedFlightIndex >= 0 && _lastDisplayedFlightIndex != (int)index)
+    if (_cardCount > 0 && _lastDisplayedStep != 0 && _lastDisplayedStep != _playlist.step())
     {
-        runWipeTransition();
+        // Wipe the old card first; the new one is drawn on the tick the wipe ends and
+        // gets a full dwell (the step may come from the old flight leaving the snapshot).
+        _lastDisplayedStep = _playlist.step();
+        _lastCycleMs = now;
+        mirrorBackBuffer(); // the wipe leaves part of whichever buffer it draws in showing
+        startAnimation(AnimKind::Wipe, now);
+        tickAnimation();
+        return;
     }
-    displaySingleFlightCard(flights[index], index + 1, flights.size());
-    _lastDisplayedFlightIndex = (int)index;
-    present();
+#if FW_DISPLAY_TEAR_MODE == 2
+    if (_buffersToClear > 0)
+    {
+        _surface->clear();
+        --_buffersToClear;
+        _fullRedraw = true;
+    }
+#endif
+    if (_fullRedraw)
+    {
+        for (uint8_t i = 0; i < _cardCount; ++i)
+        {
+            _cards[i].fullRedraw = true;
+        }
+        _radarFullRedraw = true;
+        _listFullRedraw = true;
+        _fullRedraw = false;
+    }
+    bool painted = false;
+    for (uint8_t i = 0; i < _cardCount; ++i)
+    {
+        if (i < shown)
+        {
+            const size_t ordinal = (_playlist.position() + i) % shown + 1;
+            painted |= displaySingleFlightCard(_cards[i], flights[_playlist.flightAt(i)], ordinal, shown);
+        }
+        else
+        {
+            painted |= clearCardPane(_cards[i]);
+        }
+    }
+    if (_radarPane)
+    {
+        painted |= drawRadarPane(now);
+    }
+    if (_listPane)
+    {
+        painted |= drawListPane();
+    }
+    if (_cardCount > 0 && shown > 0)
+        _lastDisplayedStep = _playlist.step();
+    if (painted)
+    {
+        present();
+    }
+
+    // Next visible change: a marquee step, an altitude step or the next card.
+    unsigned long nextMs = now + MAX_RENDER_WAIT_MS;
+    auto consider = [&](unsigned long dueMs) {
+        if ((long)(dueMs - nextMs) < 0)
+            nextMs = dueMs;
+    };
+    for (uint8_t i = 0; i < _cardCount; ++i)
+    {
+        const CardPane &c = _cards[i];
+        if (!c.layoutValid)
+            continue;
+        if (c.scrolling)
+            consider(c.lastScrollMs + MARQUEE_FRAME_MS);
+        if (c.nextAltitudeMs != 0)
+            consider(c.nextAltitudeMs);
+    }
+    if (cycling)
+        consider(_lastCycleMs + _playlist.dwellMs(_cardCount));
+    if (radarShown)
+        consider(now + RADAR_FRAME_MS);
+    _nextChangeMs = nextMs;
+}
+
+void NeoMatrixDisplay::updateTraffic(const std::vector<StateVector> &states, const std::vector<FlightInfo> &flights)
+{
+    const FlightWatchSettings &settings = RuntimeSettings::current();
+    const unsigned long now = millis();
+    _tracks.update(states, now);
+    if (_radarPane)
+    {
+        _radar.update(states,
+                      _tracks,
+                      settings.centerLat,
+                      settings.centerLon,
+                      (float)settings.radiusKm,
+                      RADAR_GLIDE_MS,
+                      now);
+    }
+    if (_listPane)
+    {
+        _list.update(states, flights, settings.altitudeFeet, settings.speedKts);
+    }
+}
+
+bool NeoMatrixDisplay::drawRadarPane(unsigned long now)
+{
+    // Contacts move by a pixel every second or two; most ticks change nothing.
+    const bool changed = _radar.advance(now) || _radarFullRedraw;
+    if (!changed && !_radarBackStale)
+        return false;
+
+    const int16_t x = _radar.viewX();
+    const int16_t y = _radar.viewY();
+    const int16_t w = _radar.viewWidth();
+    const int16_t h = _radar.viewHeight();
+    const uint32_t startUs = micros();
+    uint32_t visibleWriteUs = 0;
+    if (_band.ready() && !_radarFullRedraw)
+    {
+        // Compose band by band so the panel never shows the cleared pane.
+        for (int16_t bandY = y; bandY < y + h; bandY += BandSurface::kRows)
+        {
+            _band.setOrigin(bandY);
+            _band.clear();
+            _radar.draw(_band);
+            const uint32_t commitStartUs = micros();
+            _band.commit(*_surface, x, x + w);
+            const uint32_t commitUs = micros() - commitStartUs;
+            if (commitUs > visibleWriteUs)
+                visibleWriteUs = commitUs;
+        }
+    }
+    else
+    {
+        _surface->fillRect(x, y, w, h, RenderSurface::Color());
+        _radar.draw(*_surface);
+        visibleWriteUs = micros() - startUs;
+    }
+    if (!_radarFullRedraw && visibleWriteUs > _renderStats.maxVisibleWriteUs)
+    {
+        _renderStats.maxVisibleWriteUs = visibleWriteUs;
+    }
+    recordFrame(_radarFullRedraw, (uint32_t)w * h);
+    _radarFullRedraw = false;
+    _radarBackStale = FW_DISPLAY_TEAR_MODE == 2 && changed;
+    return true;
+}
+
+bool NeoMatrixDisplay::drawListPane()
+{
+    // Rows change only when a fetch lands, and then usually only a few of them.
+    const bool changed = _list.dirty() || _listFullRedraw;
+    if (!changed && !_listBackStale)
+        return false;
+
+    const int16_t x = _list.viewX();
+    const int16_t w = _list.viewWidth();
+    const bool full = _listFullRedraw || _listBackStale;
+    uint32_t visibleWriteUs = 0;
+    uint32_t area = 0;
+    if (full)
+    {
+        _surface->fillRect(x, _list.viewY(), w, _list.viewHeight(), RenderSurface::Color());
+        for (uint8_t row = 0; row < _list.rows(); ++row)
+        {
+            _list.draw(*_surface, row);
+        }
+        area = (uint32_t)w * _list.viewHeight();
+    }
+    else
+    {
+        // Repaint the changed rows only, each composed in one band.
+        static_assert(ListView::kRowHeight <= BandSurface::kRows, "a list row must fit one band");
+        for (uint8_t row = 0; row < _list.rows(); ++row)
+        {
+            if (!_list.rowDirty(row))
+                continue;
+            const int16_t rowY = _list.rowY(row);
+            uint32_t rowUs = 0;
+            if (_band.ready())
+            {
+                _band.setOrigin(rowY);
+                _band.clear();
+                _list.draw(_band, row);
+                const uint32_t commitStartUs = micros();
+                _band.commit(*_surface, x, x + w);
+                rowUs = micros() - commitStartUs;
+            }
+            else
+            {
+                const uint32_t rowStartUs = micros();
+                _surface->fillRect(x, rowY, w, ListView::kRowHeight, RenderSurface::Color());
+                _list.draw(*_surface, row);
+                rowUs = micros() - rowStartUs;
+            }
+            if (rowUs > visibleWriteUs)
+                visibleWriteUs = rowUs;
+            area += (uint32_t)w * ListView::kRowHeight;
+        }
+    }
+    if (!full && visibleWriteUs > _renderStats.maxVisibleWriteUs)
+    {
+        _renderStats.maxVisibleWriteUs = visibleWriteUs;
+    }
+    recordFrame(full, area);
+    _list.markClean();
+    _listFullRedraw = false;
+    _listBackStale = FW_DISPLAY_TEAR_MODE == 2 && changed;
+    return true;
+}
+
+unsigned long NeoMatrixDisplay::msUntilNextChange(unsigned long now) const
+{
+    const unsigned long dueMs = _anim.active() ? _anim.nextStepMs() : _nextChangeMs;
+    const long remaining = (long)(dueMs - now);
+    if (remaining <= 0)
+        return 0;
+    if ((unsigned long)remaining > MAX_RENDER_WAIT_MS)
+        return MAX_RENDER_WAIT_MS;
+    return (unsigned long)remaining;
 }
 
 void NeoMatrixDisplay::displayLoadingScreen()
@@ -926,7 +1504,8 @@ void NeoMatrixDisplay::displayLoadingScreen()
     if (_matrix == nullptr)
         return;
 
-    _matrix->fillScreen(0);
+    _fullRedraw = true; // the flight card must repaint from scratch afterwards
+    _surface->clear();
 
     const int charWidth  = 6;
     const int charHeight = 8;
@@ -940,31 +1519,42 @@ void NeoMatrixDisplay::displayLoadingScreen()
     const uint16_t boisenberry = _matrix->color565(135, 50, 96);
     const uint16_t lavender = _matrix->color565(230, 230, 250);
 
-    // Build time/date strings using RTC/NTP if available
-    char timeBuf[16];
-    char dateBuf[16];
-    char dayBuf[16];
-    struct tm t;
-    bool timeValid = getLocalTime(&t, 0);
-    if (timeValid)
+    // Build time/date strings using RTC/NTP if available; only re-format on a new minute
+    const time_t nowSec = time(nullptr);
+    if (!_clockValid || nowSec / 60 != _clockMinute)
     {
-        strftime(timeBuf, sizeof(timeBuf), "%H:%M", &t);
-        strftime(dateBuf, sizeof(dateBuf), "%d.%m.%Y", &t);
-        strftime(dayBuf, sizeof(dayBuf), "%A", &t);
-    }
-    else
-    {
-        snprintf(timeBuf, sizeof(timeBuf), "--:--");
-        snprintf(dateBuf, sizeof(dateBuf), "--.--.----");
-        snprintf(dayBuf, sizeof(dayBuf), "------");
+        char timeBuf[16];
+        char dateBuf[16];
+        char dayBuf[16];
+        struct tm t;
+        _clockValid = getLocalTime(&t, 0);
+        if (_clockValid)
+        {
+            strftime(timeBuf, sizeof(timeBuf), "%H:%M", &t);
+            strftime(dateBuf, sizeof(dateBuf), "%d.%m.%Y", &t);
+            strftime(dayBuf, sizeof(dayBuf), "%A", &t);
+            _clockMinute = nowSec / 60;
+        }
+        else
+        {
+            snprintf(timeBuf, sizeof(timeBuf), "--:--");
+            snprintf(dateBuf, sizeof(dateBuf), "--.--.----");
+            snprintf(dayBuf, sizeof(dayBuf), "------");
+        }
+        _clockTime = timeBuf;
+        _clockDate = dateBuf;
+        _clockDay = dayBuf;
     }
 
-    String timeStr(timeBuf);
-    String dateStr(dateBuf);
-    String dayStr(dayBuf);
+    const String &timeStr = _clockTime;
+    const String &dateStr = _clockDate;
+    const String &dayStr = _clockDay;
 
     // Blink colon every second and render slightly bolder by double-drawing
-    bool colonOn = ((millis() / 1000UL) % 2UL) == 0;
+    const unsigned long nowMs = millis();
+    bool colonOn = ((nowMs / 1000UL) % 2UL) == 0;
+    // Nothing on this screen changes faster than the colon (minute rollovers land on a tick).
+    _nextChangeMs = (nowMs / 1000UL + 1UL) * 1000UL;
     String timeDisplay = timeStr;
     if (!colonOn)
     {
@@ -983,11 +1573,13 @@ void NeoMatrixDisplay::displayLoadingScreen()
     }
 
     // Temperature in top-right, rounded to whole degrees, with text weather description under it
-    float tempC = NAN;
-    String weatherSymbol;
-    uint16_t weatherColor = textColor;
-    if (fetchWeatherIfNeeded(tempC, weatherSymbol, weatherColor))
+    const unsigned long WEATHER_STALE_MS = 30UL * 60UL * 1000UL; // hide after ~3 missed refreshes
+    const bool weatherFresh = _weather.valid() && nowMs - _weather.fetchedMs < WEATHER_STALE_MS;
+    if (weatherFresh)
     {
+        const float tempC = _weather.temperatureC;
+        const String &weatherSymbol = _weatherSymbol;
+        const uint16_t weatherColor = _weatherColor;
         if (!isnan(tempC))
         {
             long rounded = lroundf(tempC);
@@ -1025,8 +1617,15 @@ void NeoMatrixDisplay::displayMessage(const String &message)
 {
     if (_matrix == nullptr)
         return;
+    if (_anim.active())
+    {
+        // The boot animation keeps the panel; status still goes to the log.
+        Serial.printf("NeoMatrixDisplay: %s\n", message.c_str());
+        return;
+    }
 
-    _matrix->fillScreen(0);
+    _fullRedraw = true;
+    _surface->clear();
 
     const int charWidth  = 6;
     const int charHeight = 6;
@@ -1050,37 +1649,22 @@ void NeoMatrixDisplay::displayStartup()
     if (_matrix == nullptr)
         return;
 
-    _matrix->fillScreen(0);
+    _fullRedraw = true;
+    _surface->clear();
 
-    const int charWidth  = 6;
-    const int charHeight = 6;
-    const uint16_t textColor = _matrix->color565(
+    const RenderSurface::Color textColor = RenderSurface::rgb(
         UserConfiguration::TEXT_COLOR_R,
         UserConfiguration::TEXT_COLOR_G,
         UserConfiguration::TEXT_COLOR_B);
 
-    // Draw logo (64x64 mono) centered
-    const int logoW = 64;
-    const int logoH = 64;
+    // Draw logo (64x64 mono) centered, in the theme text color
+    const int16_t logoW = SpriteAtlas::width(Sprite::Logo);
+    const int16_t logoH = SpriteAtlas::height(Sprite::Logo);
     int16_t logoX = (_matrixWidth - logoW) / 2;
     if (logoX < 0) logoX = 0;
     int16_t logoY = (_matrixHeight - logoH) / 2;
     if (logoY < 0) logoY = 0;
-    const uint8_t *logo = FLIGHTWATCH_LOGO_64x64;
-    for (int y = 0; y < logoH && (logoY + y) < _matrixHeight; ++y)
-    {
-        for (int x = 0; x < logoW && (logoX + x) < _matrixWidth; ++x)
-        {
-            // Each byte holds 8 pixels, MSB first
-            int byteIndex = (y * logoW + x) / 8;
-            int bitIndex = 7 - (x % 8);
-            bool white = (logo[byteIndex] >> bitIndex) & 0x01;
-            if (!white)
-            {
-                _matrix->drawPixel(logoX + x, logoY + y, textColor);
-            }
-        }
-    }
+    SpriteAtlas::draw(*_surface, Sprite::Logo, logoX, logoY, 0, _matrixWidth, &textColor);
 
     present();
 }
@@ -1097,54 +1681,198 @@ void NeoMatrixDisplay::present()
 
     // With double buffering enabled, this pushes the back buffer to the panel.
     _matrix->flipDMABuffer();
+    _lastFlipMs = millis();
 }
 
-void NeoMatrixDisplay::runWipeTransition()
+void NeoMatrixDisplay::startBootSequence()
 {
     if (_matrix == nullptr)
         return;
+    startAnimation(AnimKind::BootTest, millis());
+    tickAnimation();
+}
+
+bool NeoMatrixDisplay::tickAnimation()
+{
+    if (_matrix == nullptr || !_anim.active())
+        return false;
 
-    const int wipeWidth = 6; // pixel band; small to keep transition light
-    for (int x = 0; x < _matrixWidth; x += wipeWidth)
+    const unsigned long now = millis();
+    uint16_t step = 0;
+    if (_anim.advance(now, step) && drawAnimationStep(step))
     {
-        _matrix->fillRect(x, 0, wipeWidth, _matrixHeight, 0);
         present();
-        delay(8); // brief delay to show movement without stressing refresh
     }
-    _matrix->fillScreen(0);
-    present();
+    if (_anim.finished(now))
+    {
+        finishAnimation(now);
+        if (_anim.advance(now, step) && drawAnimationStep(step))
+        {
+            present();
+        }
+    }
+    return _anim.active();
 }
 
-void NeoMatrixDisplay::runBootTest()
+void NeoMatrixDisplay::cancelAnimation()
 {
-    if (_matrix == nullptr)
+    if (!_anim.active())
         return;
+    _anim.stop();
+    _animKind = AnimKind::None;
+    _matrix->setBrightness8(RuntimeSettings::current().displayBrightness);
+    _fullRedraw = true;
+}
 
-    const uint16_t red   = _matrix->color565(255, 0, 0);
-    const uint16_t green = _matrix->color565(0, 255, 0);
-    const uint16_t blue  = _matrix->color565(0, 0, 255);
-    const uint16_t white = _matrix->color565(255, 255, 255);
+void NeoMatrixDisplay::startAnimation(AnimKind kind, unsigned long now)
+{
+    _animKind = kind;
+    switch (kind)
+    {
+    case AnimKind::BootTest:
+        _anim.start(BOOT_TEST_STEPS, BOOT_TEST_STEP_MS, now);
+        break;
+    case AnimKind::LogoFade:
+        // The logo is drawn once; the fade only ramps brightness.
+        _matrix->setBrightness8(0);
+        displayStartup();
+        _anim.start(LOGO_FADE_STEPS, LOGO_FADE_STEP_MS, now);
+        break;
+    case AnimKind::LogoHold:
+        _anim.start(1, LOGO_HOLD_MS, now);
+        break;
+    case AnimKind::Wipe:
+        _anim.start((_matrixWidth + WIPE_BAND_PX - 1) / WIPE_BAND_PX, WIPE_STEP_MS, now);
+        break;
+    case AnimKind::None:
+        _anim.stop();
+        break;
+    }
+}
 
-    uint16_t colors[] = {red, green, blue, white};
-    for (uint8_t i = 0; i < 4; ++i)
+bool NeoMatrixDisplay::drawAnimationStep(uint16_t step)
+{
+    switch (_animKind)
     {
-        _matrix->fillScreen(colors[i]);
-        present();
-        delay(1000);
+    case AnimKind::BootTest:
+    {
+        if (step < 4)
+        {
+            const uint16_t colors[] = {
+                _matrix->color565(255, 0, 0),
+                _matrix->color565(0, 255, 0),
+                _matrix->color565(0, 0, 255),
+                _matrix->color565(255, 255, 255)};
+            _matrix->fillScreen(colors[step]);
+            return true;
+        }
+        // Checkerboard, one pixel per span so every panel in the chain is exercised
+        const RenderSurface::Color white = RenderSurface::rgb(255, 255, 255);
+        _surface->clear();
+        for (int16_t y = 0; y < (int16_t)_matrixHeight; ++y)
+        {
+            for (int16_t x = y & 1; x < (int16_t)_matrixWidth; x += 2)
+            {
+                _surface->hline(x, y, 1, white);
+            }
+        }
+        return true;
+    }
+    case AnimKind::LogoFade:
+        // Brightness only: a flip would show the other DMA buffer's checkerboard.
+        _matrix->setBrightness8((uint8_t)((uint32_t)RuntimeSettings::current().displayBrightness * (step + 1) / LOGO_FADE_STEPS));
+        return false;
+    case AnimKind::Wipe:
+        // Clear everything wiped so far, so each step is complete in either DMA buffer.
+        _surface->fillRect(0, 0, (step + 1) * WIPE_BAND_PX, _matrixHeight, RenderSurface::Color());
+        return true;
+    case AnimKind::LogoHold:
+    case AnimKind::None:
+        break;
     }
+    return false;
+}
 
-    // Checkerboard using drawPixel
-    _matrix->fillScreen(0);
-    for (uint16_t y = 0; y < _matrixHeight; ++y)
+void NeoMatrixDisplay::finishAnimation(unsigned long now)
+{
+    switch (_animKind)
     {
-        for (uint16_t x = 0; x < _matrixWidth; ++x)
+    case AnimKind::BootTest:
+        startAnimation(AnimKind::LogoFade, now);
+        return;
+    case AnimKind::LogoFade:
+        _matrix->setBrightness8(RuntimeSettings::current().displayBrightness);
+        startAnimation(AnimKind::LogoHold, now);
+        return;
+    case AnimKind::LogoHold:
+    case AnimKind::Wipe:
+    case AnimKind::None:
+        break;
+    }
+    _anim.stop();
+    _animKind = AnimKind::None;
+    _matrix->setBrightness8(RuntimeSettings::current().displayBrightness);
+#if FW_DISPLAY_TEAR_MODE == 2
+    // Flipping to a cleared buffer would flash black between the wipe and the card; each
+    // buffer is cleared when its turn to be painted comes instead.
+    _buffersToClear = 2;
+    _fullRedraw = true;
+#else
+    clear();
+#endif
+}
+
+void NeoMatrixDisplay::runRenderBenchmark()
+{
+#if FW_RENDER_BENCH
+    // One marquee row per frame, scrolled like the card does, drawn both ways.
+    const char *const samples[][2] = {
+        {"typical", "Lufthansa"},
+        {"long marquee", "DLH4KM  -  36000ft  -  842km/h  -  San Francisco   Munich"},
+    };
+    const int kFrames = 200;
+    const uint16_t color = _matrix->color565(255, 255, 255);
+
+    for (const auto &sample : samples)
+    {
+        const String text(sample[1]);
+        TextStrip strip;
+        uint32_t startUs = micros();
+        strip.render(text);
+        const uint32_t buildUs = micros() - startUs;
+        const int16_t span = strip.width() + _matrixWidth;
+
+        startUs = micros();
+        for (int i = 0; i < kFrames; ++i)
         {
-            if (((x + y) & 1) == 0)
+            const int16_t x = _matrixWidth - (int16_t)(i % span);
+            _matrix->fillRect(0, 0, _matrixWidth, CHAR_HEIGHT, 0);
+            _matrix->setCursor(x, 0);
+            _matrix->setTextColor(color);
+            for (size_t c = 0; c < (size_t)text.length(); ++c)
             {
-                _matrix->drawPixel(x, y, white);
+                _matrix->write(text[c]);
             }
         }
+        const uint32_t glyphUs = micros() - startUs;
+
+        startUs = micros();
+        for (int i = 0; i < kFrames; ++i)
+        {
+            const int16_t x = _matrixWidth - (int16_t)(i % span);
+            _surface->fillRect(0, 0, _matrixWidth, CHAR_HEIGHT, RenderSurface::Color());
+            drawStrip(strip, x, 0, RenderSurface::from565(color));
+        }
+        const uint32_t stripUs = micros() - startUs;
+
+        Serial.printf("NeoMatrixDisplay bench: %s (%u chars): GFX glyphs %u us/frame, strip spans %u us/frame, build %u us, %u bytes\n",
+                      sample[0],
+                      (unsigned)text.length(),
+                      (unsigned)(glyphUs / kFrames),
+                      (unsigned)(stripUs / kFrames),
+                      (unsigned)buildUs,
+                      (unsigned)strip.bytes());
     }
-    present();
-    delay(1000);
+    _matrix->fillScreen(0);
+#endif
 }
@@ -3,8 +3,19 @@
 #include <stdint.h>
 #include <vector>
 #include "interfaces/BaseDisplay.h"
+#include "models/WeatherInfo.h"
+#include "utils/DirtyRegion.h"
+#include "utils/TextStrip.h"
+#include "utils/BandSurface.h"
+#include "utils/Animation.h"
+#include "utils/RadarView.h"
+#include "utils/TrackStore.h"
+#include "utils/ListView.h"
+#include "utils/FlightPlaylist.h"
+#include "utils/CardLayout.h"
 
 class MatrixPanel_I2S_DMA;
+class Hub75Surface;
 
 class NeoMatrixDisplay : public BaseDisplay
 {
@@ -18,105 +29,216 @@ public:
     void displayMessage(const String &message);
     void displayStartup();
     void showLoading();
+    // Latest Open-Meteo reading from the fetch task; shown on the clock screen.
+    // Returns true if it differs from the reading already shown.
+    bool updateWeather(const WeatherInfo &weather);
+    // State vectors of the latest fetch pass with the flights published alongside them.
+    // Files them in the track store, and feeds the radar or list pane if there is one.
+    void updateTraffic(const std::vector<StateVector> &states, const std::vector<FlightInfo> &flights);
+    // Time until the last rendered screen next changes on its own (marquee step, flight
+    // cycle, colon blink); capped at one second. New data should be rendered immediately.
+    unsigned long msUntilNextChange(unsigned long now) const;
+
+    // Panel test pattern, logo fade-in, then a logo hold. Runs step by step from
+    // tickAnimation()/displayFlights(), so setup can connect WiFi meanwhile.
+    void startBootSequence();
+    // Draws the due step of the running animation; returns true while one is running.
+    bool tickAnimation();
+    bool animating() const { return _anim.active(); }
+    // Ends the running animation at once (e.g. the WiFi portal needs the panel).
+    void cancelAnimation();
 
 private:
-    struct FlightCardLayout
+    enum class AnimKind : uint8_t
     {
-        String airline;
-        int16_t airlineWidth = 0;
-        int16_t airlineY = 0;
-
-        String route;
-        int16_t routeX = 0;
-        int16_t routeY = 0;
-        int16_t arrowX = 0;
-        int16_t arrowY = 0;
-
-        String modelLine1;
-        String modelLine2;
-        int16_t model1X = 0;
-        int16_t model1Y = 0;
-        int16_t model2X = 0;
-        int16_t model2Y = 0;
-        bool hasModel2 = false;
-
-        String originName;
-        String destName;
-        int16_t originCityChars = 0;
-        int16_t destCityChars = 0;
-        int16_t originWidth = 0;
-        int16_t destWidth = 0;
-        int16_t cityArrowOffset = 0;
-        bool originScrollActive = false;
-        bool destScrollActive = false;
-        int16_t originY = 0;
-        int16_t destY = 0;
-        bool showDest = false;
-
-        String counter;
-        int16_t counterX = 0;
-        int16_t counterY = 0;
-        bool showCounter = false;
+        None,
+        BootTest,
+        LogoFade,
+        LogoHold,
+        Wipe,
     };
 
-    MatrixPanel_I2S_DMA *_matrix = nullptr;
+    // One drawable piece of a card line: a text strip, an arrow or a sprite.
+    struct CardPiece
+    {
+        CardLayout::Field field = CardLayout::Field::Literal; // Arrow, AirlineFin, else text
+        int16_t offset = 0; // from the line's scroll position (fixed pieces: the pane's left edge)
+        uint8_t strip = 0;  // text: index into CardPane::strips
+        uint8_t sprite = 0; // AirlineFin: SpriteAtlas id
+        RenderSurface::Color color;
+    };
 
-    uint16_t _matrixWidth = 0;
-    uint16_t _matrixHeight = 0;
+    // A laid-out card line. Leading sprites are fixed; the rest is placed (or scrolls) as one.
+    struct CardLine
+    {
+        int16_t y = 0;
+        int16_t x = 0;      // aligned start when static
+        int16_t home = 0;   // left edge of the scrolling part (after fixed pieces)
+        int16_t clipX0 = 0; // the scrolling part is cut left of this
+        int16_t width = 0;  // of the scrolling part
+        uint8_t firstPiece = 0;
+        uint8_t fixedPieces = 0;
+        uint8_t pieceCount = 0;
+        bool marquee = false;
+        int16_t scrollX = 0;
+        int16_t drawnX = 0;
+        uint32_t contentHash = 0; // texts, gaps and colors of the scrolling part
+    };
+
+    // One flight card and its animation state, placed in a rectangle of the panel.
+    struct CardPane
+    {
+        int16_t x = 0;
+        int16_t y = 0;
+        int16_t w = 0;
+        int16_t h = 0;
+
+        // Cached layout, keyed on the flight's content version, its live metrics, its place
+        // in the cycle and the card design. Lines, pieces and strips are laid out from the
+        // design's tables.
+        bool layoutValid = false;
+        uint32_t layoutVersion = 0;
+        uint32_t metricsVersion = 0;
+        size_t ordinal = 0;
+        size_t total = 0;
+        uint8_t design = 0;
+
+        CardLine lines[CardLayout::kMaxLines];
+        CardPiece pieces[CardLayout::kMaxPieces];
+        TextStrip strips[CardLayout::kMaxStrips]; // rasterized once per layout; frames only blit
+        uint8_t lineCount = 0;
+        uint8_t pieceCount = 0;
+        uint8_t stripCount = 0;
+        int16_t progressY = 0;
+        uint8_t progressHeight = 0; // 0: the design has no progress bar
+
+        bool scrolling = false; // any line is a running marquee
+        unsigned long lastScrollMs = 0;
+        unsigned long nextAltitudeMs = 0; // next step of the extrapolated altitude; 0 if it holds
+
+        // Damage tracking: only rows whose content moved or changed are cleared and redrawn.
+        bool fullRedraw = true;
+        uint8_t dirtyLines = 0;     // bit per line whose text changed in place
+        bool progressDirty = false; // same card, new place in the cycle
+        bool blank = false; // no flight for this pane; cleared once
+        bool backStale = false; // double buffer: the hidden buffer predates the last paint
+    };
+
+    // How the panel is split into panes, chosen from the chained geometry.
+    enum class PaneLayout : uint8_t
+    {
+        Single, // one card (or, in radar/list mode, the radar/list) fills the panel
+        Wide,   // panels side by side: two cards, or a card and the radar/list
+        Tall,   // panels stacked: card on top, radar (or list, in list mode) below
+    };
+
+    static const uint8_t kMaxCardPanes = 2;
+    static_assert(CardLayout::kMaxLines <= 8, "CardPane::dirtyLines has a bit per line");
+
+    // What a card needs repainted after prepareFlightLayout.
+    enum class LayoutChange : uint8_t
+    {
+        None,
+        Partial, // CardPane::dirtyLines and progressDirty
+        Full,
+    };
 
-    size_t _currentFlightIndex = 0;
+    // Per-window render counters, logged every RENDER_STATS_WINDOW_MS.
+    struct RenderStats
+    {
+        uint32_t fullFrames = 0;
+        uint32_t partialFrames = 0;
+        uint32_t idleFrames = 0;
+        uint32_t pixelWrites = 0; // pixels cleared and repainted
+        uint32_t maxVisibleWriteUs = 0; // longest partial update on the shown buffer (tear window)
+        unsigned long windowStartMs = 0;
+    };
+
+    MatrixPanel_I2S_DMA *_matrix = nullptr;
+    Hub75Surface *_surface = nullptr; // span primitives over _matrix's DMA buffer
+    TextStrip _scratchStrip;
+    BandSurface _band;                 // allocated only in band tear mode
+    RenderSurface *_target = nullptr;  // where drawStrip/drawArrow draw: _surface or _band
+    int16_t _clipX0 = 0;               // drawStrip/drawArrow column clip, [_clipX0, _clipX1)
+    int16_t _clipX1 = 0;
+
+    uint16_t _matrixWidth = 0;  // whole chained display, in pixels
+    uint16_t _matrixHeight = 0;
+    PaneLayout _paneLayout = PaneLayout::Single;
+    CardPane _cards[kMaxCardPanes];
+    uint8_t _cardCount = 1;
+    RadarView _radar;
+    bool _radarPane = false; // viewport is set on _radar
+    bool _radarFullRedraw = true;
+    bool _radarBackStale = false;
+    ListView _list;
+    bool _listPane = false; // viewport is set on _list
+    bool _listFullRedraw = true;
+    bool _listBackStale = false;
+    TrackStore _tracks; // recent fixes of every aircraft seen, for the radar trails
+
+    SnapshotDiff _snapshot;
+    FlightPlaylist _playlist;
     unsigned long _lastCycleMs = 0;
-    int _lastDisplayedFlightIndex = -1;
-
-    // Cached layout to avoid recomputing strings every frame
-    FlightCardLayout _layout;
-    String _layoutKey;
-    bool _layoutValid = false;
-    String _lastIdent;
-    String _lastIdentIata;
-    String _lastIdentIcao;
-    String _lastOriginCode;
-    String _lastDestCode;
-    String _lastAirlineFull;
-    String _lastOperatorIata;
-    String _lastOperatorIcao;
-    String _lastAircraftDisplay;
-    String _lastAircraftCode;
-    size_t _lastLayoutOrdinal = 0;
-    size_t _lastLayoutTotal = 0;
-    bool _airlineScrollActive = false;
-    int16_t _airlineScrollX = 0;
-    unsigned long _lastAirlineScrollMs = 0;
-    int16_t _originScrollX = 0;
-    int16_t _destScrollX = 0;
-    unsigned long _lastCityScrollMs = 0;
-
-    float _lastTempC = NAN;
-    unsigned long _lastTempFetchMs = 0;
-    int _lastWeatherCode = -1;
-    String _lastWeatherSymbol;
-    uint16_t _lastWeatherColor = 0;
+    uint32_t _lastDisplayedStep = 0; // _playlist.step() last drawn; 0 = no flight drawn yet
+
+    DirtyRegion _damage;     // reused per pane
+    bool _fullRedraw = true; // another screen was shown: every pane repaints
+    RenderStats _renderStats;
+
+    unsigned long _nextChangeMs = 0;
+    unsigned long _lastFlipMs = 0;
+    uint8_t _buffersToClear = 0; // double buffer: cleared at the start of their next paint
+
+    Animation _anim;
+    AnimKind _animKind = AnimKind::None;
+
+    // Clock screen strings, re-formatted once per minute.
+    String _clockTime;
+    String _clockDate;
+    String _clockDay;
+    long _clockMinute = -1;
+    bool _clockValid = false;
+
+    WeatherInfo _weather;
+    String _weatherSymbol;
+    uint16_t _weatherColor = 0;
 
     void drawTextLine(int16_t x, int16_t y, const String &text, uint16_t color);
+    void drawStrip(const TextStrip &strip, int16_t x, int16_t y, const RenderSurface::Color &color);
+    void drawArrow(int16_t x, int16_t y, const RenderSurface::Color &color);
     String makeFlightLine(const FlightInfo &f);
     String truncateToColumns(const String &text, int maxColumns);
     String firstWord(const String &text) const;
-    void displaySingleFlightCard(const FlightInfo &f);
-    void runWipeTransition();
     void drawWeatherIcon(int16_t originX, int16_t originY, int weatherCode, uint16_t color);
     void displayLoadingScreen();
     String chooseAirlineName(const FlightInfo &f) const;
     String airportCodePreferred(const AirportInfo &a) const;
     String airportNamePreferred(const AirportInfo &a) const;
     String airportCity(const AirportInfo &a) const;
-    bool fetchWeatherIfNeeded(float &outC, String &outSymbol, uint16_t &outColor);
     void present();
-    void runBootTest();
-
-    String flightCacheKey(const FlightInfo &f, size_t ordinal, size_t total) const;
-    void prepareFlightLayout(const FlightInfo &f, size_t ordinal, size_t total);
-    void updateAirlineScroll(unsigned long now);
-    void updateCityScrolls(unsigned long now);
-
-    void displaySingleFlightCard(const FlightInfo &f, size_t ordinal, size_t total);
+    void startAnimation(AnimKind kind, unsigned long now);
+    // Returns false when the step only changed the brightness and there is nothing to flip.
+    bool drawAnimationStep(uint16_t step);
+    void finishAnimation(unsigned long now);
+    void runRenderBenchmark();
+
+    void layoutPanes();
+    LayoutChange prepareFlightLayout(CardPane &c, const FlightInfo &f, double altitudeM,
+                                     size_t ordinal, size_t total);
+    String cardFieldText(CardLayout::Field field, const FlightInfo &f, double altitudeM) const;
+    String aircraftName(const FlightInfo &f) const;
+    String truncateToWidth(const String &text, int16_t width, TextStrip::Font font);
+    void updateMarquees(CardPane &c, unsigned long now);
+    void drawCardLine(const CardPane &c, const CardLine &line);
+    // Progress bar and lines from the cached layout; all: every line, else the damaged ones.
+    void drawCardContent(const CardPane &c, bool all);
+
+    bool displaySingleFlightCard(CardPane &c, const FlightInfo &f, size_t ordinal, size_t total);
+    bool clearCardPane(CardPane &c);
+    bool drawRadarPane(unsigned long now);
+    bool drawListPane();
+    // Double buffer: repaints panes changed in the last flip into the buffer it hid.
+    void mirrorBackBuffer();
+    void recordFrame(bool full, uint32_t pixelWrites);
 };
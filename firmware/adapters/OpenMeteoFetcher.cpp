@@ -0,0 +1,83 @@
+/*
+Purpose: Fetch current temperature and weather code from Open-Meteo.
+Responsibilities:
+- Plain-HTTP GET of /v1/forecast (avoids a TLS RAM spike for this small request).
+- Parse current.temperature_2m and current.weathercode into WeatherInfo.
+Input: weather latitude/longitude from RuntimeSettings.
+Output: Populates WeatherInfo on success and returns true.
+*/
+#include "adapters/OpenMeteoFetcher.h"
+#include <WiFi.h>
+#include <ArduinoJson.h>
+#include "utils/ApiHttpClient.h"
+#include "utils/NetLock.h"
+
+bool OpenMeteoFetcher::fetchCurrent(double lat, double lon, WeatherInfo &outWeather)
+{
+    if (!ApiHttp::available(ApiHttp::Host::OpenMeteo))
+    {
+        return false;
+    }
+
+    NetLock::Guard guard(500); // low priority: yield quickly if network busy
+    if (!guard.locked())
+    {
+        return false;
+    }
+
+    WiFiClient client;
+    ApiHttp::Request request(ApiHttp::Host::OpenMeteo, client);
+    if (!request.setUrl("http://api.open-meteo.com/v1/forecast?latitude=%.6f&longitude=%.6f&current=temperature_2m,weathercode",
+                        lat,
+                        lon))
+    {
+        return false;
+    }
+    request.addHeader("Accept-Encoding", "identity");
+
+    int code = request.get();
+    if (code != 200)
+    {
+        Serial.printf("OpenMeteoFetcher: HTTP %d\n", code);
+        return false;
+    }
+
+    Stream *stream = request.body();
+    if (!stream)
+    {
+        return false;
+    }
+
+    StaticJsonDocument<1024> doc;
+    DeserializationError err = deserializeJson(doc, *stream);
+    if (!err && !request.bodyIntact())
+    {
+        err = DeserializationError::InvalidInput;
+    }
+    request.end();
+    if (err)
+    {
+        Serial.print("OpenMeteoFetcher: JSON parse error: ");
+        Serial.println(err.c_str());
+        return false;
+    }
+
+    WeatherInfo fresh;
+    if (doc["current"]["temperature_2m"].is<float>())
+    {
+        fresh.temperatureC = doc["current"]["temperature_2m"].as<float>();
+    }
+    if (doc["current"]["weathercode"].is<int>())
+    {
+        fresh.weatherCode = doc["current"]["weathercode"].as<int>();
+    }
+    if (!fresh.valid())
+    {
+        Serial.println("OpenMeteoFetcher: response missing current fields");
+        return false;
+    }
+
+    fresh.fetchedMs = millis();
+    outWeather = fresh;
+    return true;
+}
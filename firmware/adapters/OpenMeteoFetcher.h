@@ -0,0 +1,12 @@
+#pragma once
+
+#include <Arduino.h>
+#include "models/WeatherInfo.h"
+
+class OpenMeteoFetcher
+{
+public:
+    OpenMeteoFetcher() = default;
+
+    bool fetchCurrent(double lat, double lon, WeatherInfo &outWeather);
+};
@@ -5,40 +5,118 @@ Responsibilities:
 - Build geographic bounding box around a center point and query states/all.
 - Parse JSON into StateVector objects and compute distance/bearing.
 - Filter by radius and bearing using GeoUtils helpers.
+- Match each kept state against the watchlist while parsing.
 Inputs: centerLat, centerLon, radiusKm, min/max bearing; APIConfiguration creds/URLs.
 Outputs: Populates outStateVectors with filtered results (distance_km, bearing_deg set).
 */
 #include "adapters/OpenSkyFetcher.h"
 #include "config/RuntimeSettings.h"
 #include <WiFiClientSecure.h>
+#include "utils/ApiHttpClient.h"
 #include "utils/NetLock.h"
+#include "utils/PipelinedStream.h"
+#include "utils/Watchlist.h"
 
-static unsigned long s_lastTlsFailMs = 0;
-static const unsigned long kTlsBackoffMs = 120000UL; // 2 minutes
-
-static String urlEncodeForm(const String &value)
+// Appends value to out[pos..] using application/x-www-form-urlencoded rules.
+static bool appendFormEncoded(char *out, size_t capacity, size_t &pos, const char *value)
 {
-    String out;
     const char *hex = "0123456789ABCDEF";
-    for (size_t i = 0; i < value.length(); ++i)
+    for (const char *p = value; *p; ++p)
     {
-        char c = value[i];
-        if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '-' || c == '_' || c == '.' || c == '~')
+        char c = *p;
+        bool plain = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '-' || c == '_' || c == '.' || c == '~';
+        size_t need = (plain || c == ' ') ? 1 : 3;
+        if (pos + need >= capacity)
+            return false;
+        if (plain)
         {
-            out += c;
+            out[pos++] = c;
         }
         else if (c == ' ')
         {
-            out += '+';
+            out[pos++] = '+';
         }
         else
         {
-            out += '%';
-            out += hex[(c >> 4) & 0x0F];
-            out += hex[c & 0x0F];
+            out[pos++] = '%';
+            out[pos++] = hex[(c >> 4) & 0x0F];
+            out[pos++] = hex[c & 0x0F];
         }
     }
-    return out;
+    out[pos] = '\0';
+    return true;
+}
+
+static bool appendLiteral(char *out, size_t capacity, size_t &pos, const char *literal)
+{
+    size_t len = strlen(literal);
+    if (pos + len >= capacity)
+        return false;
+    memcpy(out + pos, literal, len + 1);
+    pos += len;
+    return true;
+}
+
+static void appendStateVectors(JsonArray states,
+                               double centerLat,
+                               double centerLon,
+                               double radiusKm,
+                               long responseTime,
+                               unsigned long receivedMs,
+                               std::vector<StateVector> &outStateVectors)
+{
+    for (JsonVariant v : states)
+    {
+        if (!v.is<JsonArray>())
+        {
+            Serial.println("OpenSkyFetcher: Expected array element in states");
+            continue;
+        }
+        JsonArray a = v.as<JsonArray>();
+        if (a.size() < 17)
+        {
+            Serial.println("OpenSkyFetcher: State vector array has insufficient elements");
+            continue;
+        }
+
+        StateVector s;
+        s.icao24 = a[0].as<const char *>();
+        s.callsign = a[1].isNull() ? String("") : String(a[1].as<const char *>());
+        s.callsign.trim();
+        s.origin_country = a[2].isNull() ? String("") : String(a[2].as<const char *>());
+        s.time_position = a[3].isNull() ? 0 : a[3].as<long>();
+        s.last_contact = a[4].isNull() ? 0 : a[4].as<long>();
+        s.lon = a[5].isNull() ? NAN : a[5].as<double>();
+        s.lat = a[6].isNull() ? NAN : a[6].as<double>();
+        s.baro_altitude = a[7].isNull() ? NAN : a[7].as<double>();
+        s.on_ground = a[8].isNull() ? false : a[8].as<bool>();
+        s.velocity = a[9].isNull() ? NAN : a[9].as<double>();
+        s.heading = a[10].isNull() ? NAN : a[10].as<double>();
+        s.vertical_rate = a[11].isNull() ? NAN : a[11].as<double>();
+        s.sensors = a[12].isNull() ? 0 : a[12].as<long>();
+        s.geo_altitude = a[13].isNull() ? NAN : a[13].as<double>();
+        s.squawk = a[14].isNull() ? String("") : String(a[14].as<const char *>());
+        s.spi = a[15].isNull() ? false : a[15].as<bool>();
+        s.position_source = a[16].isNull() ? 0 : a[16].as<int>();
+        // Fix time on the local clock, taking the response's "time" as received now, so
+        // positions can be extrapolated without the device knowing the wall clock.
+        if (responseTime > 0 && s.time_position > 0 && s.time_position <= responseTime)
+            s.position_ms = receivedMs - (unsigned long)(responseTime - s.time_position) * 1000UL;
+
+        if (isnan(s.lat) || isnan(s.lon))
+        {
+            Serial.println("OpenSkyFetcher: Skipping state vector with invalid coordinates");
+            continue;
+        }
+
+        s.distance_km = haversineKm(centerLat, centerLon, s.lat, s.lon);
+        if (s.distance_km > radiusKm)
+            continue;
+        s.bearing_deg = computeBearingDeg(centerLat, centerLon, s.lat, s.lon);
+        s.watch = Watchlist::active().match(s);
+
+        outStateVectors.push_back(s);
+    }
 }
 
 bool OpenSkyFetcher::ensureAccessToken(bool forceRefresh)
@@ -52,11 +130,10 @@ bool OpenSkyFetcher::ensureAccessToken(bool forceRefresh)
     }
 
     unsigned long nowMs = millis();
-    const unsigned long safetySkewMs = 60UL * 1000UL; // refresh 60s early
-    if (!forceRefresh && m_accessToken.length() > 0 && nowMs + safetySkewMs < m_tokenExpiryMs)
+    if (!forceRefresh && m_accessToken.length() > 0 && nowMs + kTokenSafetySkewMs < m_tokenExpiryMs)
     {
         Serial.print("OpenSkyFetcher: Using cached token. ms until refresh window: ");
-        Serial.println((long)(m_tokenExpiryMs - safetySkewMs - nowMs));
+        Serial.println((long)(m_tokenExpiryMs - kTokenSafetySkewMs - nowMs));
         return true;
     }
 
@@ -81,6 +158,11 @@ bool OpenSkyFetcher::ensureAuthenticated(bool forceRefresh)
     return ensureAccessToken(forceRefresh);
 }
 
+bool OpenSkyFetcher::tokenRefreshDue(unsigned long nowMs) const
+{
+    return m_accessToken.length() > 0 && nowMs + 2 * kTokenSafetySkewMs >= m_tokenExpiryMs;
+}
+
 bool OpenSkyFetcher::requestAccessToken(String &outToken, unsigned long &outExpiryMs)
 {
     const auto &cfg = RuntimeSettings::current();
@@ -90,15 +172,14 @@ bool OpenSkyFetcher::requestAccessToken(String &outToken, unsigned long &outExpi
         return false;
     }
 
-    unsigned long nowMs = millis();
-    if (s_lastTlsFailMs != 0 && nowMs - s_lastTlsFailMs < kTlsBackoffMs)
+    if (!ApiHttp::available(ApiHttp::Host::OpenSkyAuth))
     {
-        Serial.println("OpenSkyFetcher: backing off token request after TLS failure");
+        Serial.println("OpenSkyFetcher: backing off token request after failure");
         return false;
     }
 
     // Avoid starting TLS if heap is tight; try later.
-    if (ESP.getFreeHeap() < 70000 || ESP.getMaxAllocHeap() < 40000)
+    if (!ApiHttp::tlsHeapAvailable())
     {
         Serial.printf("OpenSkyFetcher: low heap before token fetch (free=%u, max=%u) -> skip\n",
                       ESP.getFreeHeap(),
@@ -106,20 +187,31 @@ bool OpenSkyFetcher::requestAccessToken(String &outToken, unsigned long &outExpi
         return false;
     }
 
+    static char body[384];
+    size_t bodyLen = 0;
+    bool bodyOk = appendLiteral(body, sizeof(body), bodyLen, "grant_type=client_credentials&client_id=") &&
+                  appendFormEncoded(body, sizeof(body), bodyLen, cfg.openSkyClientId.c_str()) &&
+                  appendLiteral(body, sizeof(body), bodyLen, "&client_secret=") &&
+                  appendFormEncoded(body, sizeof(body), bodyLen, cfg.openSkyClientSecret.c_str());
+    if (!bodyOk)
+    {
+        Serial.println("OpenSkyFetcher: OAuth credentials too long for token request buffer");
+        return false;
+    }
+
     static WiFiClientSecure client;
     client.setInsecure();
-    HTTPClient http;
+    ApiHttp::Request request(ApiHttp::Host::OpenSkyAuth, client);
     Serial.print("OpenSkyFetcher: Token URL: ");
     Serial.println(APIConfiguration::OPENSKY_TOKEN_URL);
-    http.begin(client, APIConfiguration::OPENSKY_TOKEN_URL);
-    http.addHeader("Content-Type", "application/x-www-form-urlencoded");
-    http.addHeader("Accept", "application/json");
-    http.useHTTP10(true);
-    http.setReuse(false);
-    http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
-
-    String body = String("grant_type=client_credentials&client_id=") + urlEncodeForm(cfg.openSkyClientId) +
-                  "&client_secret=" + urlEncodeForm(cfg.openSkyClientSecret);
+    if (!request.setUrl("%s", APIConfiguration::OPENSKY_TOKEN_URL))
+    {
+        return false;
+    }
+    request.addHeader("Content-Type", "application/x-www-form-urlencoded");
+    request.addHeader("Accept", "application/json");
+    request.setFollowRedirects(true);
+    request.setTimeout(15000);
 
     // Debug: show request (without exposing secret)
     Serial.print("OpenSkyFetcher: Using client_id: ");
@@ -127,41 +219,37 @@ bool OpenSkyFetcher::requestAccessToken(String &outToken, unsigned long &outExpi
     Serial.print("OpenSkyFetcher: client_secret length: ");
     Serial.println((int)cfg.openSkyClientSecret.length());
     Serial.print("OpenSkyFetcher: POST body length: ");
-    Serial.println((int)body.length());
-    http.setTimeout(15000);
+    Serial.println((int)bodyLen);
 
-    int code = http.POST(body);
-    String payload = http.getString();
+    int code = request.post(reinterpret_cast<const uint8_t *>(body), bodyLen);
     if (code != 200)
     {
-        if (code < 0)
-        {
-            s_lastTlsFailMs = nowMs;
-        }
+        char errorBody[ApiHttp::kMaxErrorBodyLen];
+        size_t errorLen = code > 0 ? request.readBody(errorBody, sizeof(errorBody)) : 0;
         Serial.print("OpenSkyFetcher: Token request failed, code: ");
         Serial.println(code);
         Serial.print("OpenSkyFetcher: Error payload: ");
-        if (payload.length() > 0)
-        {
-            Serial.println(payload);
-        }
-        else
-        {
-            Serial.println("<empty>");
-        }
-        http.end();
+        Serial.println(errorLen > 0 ? errorBody : "<empty>");
+        return false;
+    }
+
+    Stream *stream = request.body();
+    if (!stream)
+    {
         return false;
     }
-    http.end();
 
     DynamicJsonDocument doc(12288);
-    DeserializationError err = deserializeJson(doc, payload);
+    DeserializationError err = deserializeJson(doc, *stream);
+    if (!err && !request.bodyIntact())
+    {
+        err = DeserializationError::InvalidInput;
+    }
+    request.end();
     if (err)
     {
         Serial.print("OpenSkyFetcher: Token JSON parse error: ");
         Serial.println(err.c_str());
-        Serial.print("OpenSkyFetcher: Raw token response: ");
-        Serial.println(payload);
         return false;
     }
 
@@ -170,8 +258,6 @@ bool OpenSkyFetcher::requestAccessToken(String &outToken, unsigned long &outExpi
     if (tokenStr.length() == 0)
     {
         Serial.println("OpenSkyFetcher: access_token missing in response");
-        Serial.print("OpenSkyFetcher: Full response: ");
-        Serial.println(payload);
         if (doc.is<JsonObject>())
         {
             Serial.println("OpenSkyFetcher: Response keys:");
@@ -198,14 +284,13 @@ bool OpenSkyFetcher::fetchStateVectors(double centerLat,
                                        double radiusKm,
                                        std::vector<StateVector> &outStateVectors)
 {
-    unsigned long nowMs = millis();
-    if (s_lastTlsFailMs != 0 && nowMs - s_lastTlsFailMs < kTlsBackoffMs)
+    if (!ApiHttp::available(ApiHttp::Host::OpenSky))
     {
-        Serial.println("OpenSkyFetcher: backing off state fetch after TLS failure");
+        Serial.println("OpenSkyFetcher: backing off state fetch after failure");
         return false;
     }
 
-    if (ESP.getFreeHeap() < 70000 || ESP.getMaxAllocHeap() < 40000)
+    if (!ApiHttp::tlsHeapAvailable())
     {
         Serial.printf("OpenSkyFetcher: low heap before state fetch (free=%u, max=%u) -> skip\n",
                       ESP.getFreeHeap(),
@@ -230,209 +315,88 @@ bool OpenSkyFetcher::fetchStateVectors(double centerLat,
     double latMin, latMax, lonMin, lonMax;
     centeredBoundingBox(centerLat, centerLon, radiusKm, latMin, latMax, lonMin, lonMax);
 
-    String url = String(APIConfiguration::OPENSKY_BASE_URL) + "/api/states/all?lamin=" + String(latMin, 6) +
-                 "&lamax=" + String(latMax, 6) +
-                 "&lomin=" + String(lonMin, 6) +
-                 "&lomax=" + String(lonMax, 6);
-
     static WiFiClientSecure client;
     client.setInsecure();
 
-    HTTPClient http;
-    http.begin(client, url);
-    // OAuth Bearer required
-    http.addHeader("Authorization", String("Bearer ") + m_accessToken);
-    http.useHTTP10(true);
-    http.setReuse(false);
-    http.setTimeout(15000);
-
-    int code = http.GET();
-    if (code != 200)
+    // Second attempt only runs after a 401 forced a token refresh.
+    for (int attempt = 0; attempt < 2; ++attempt)
     {
-        if (code < 0)
+        ApiHttp::Request request(ApiHttp::Host::OpenSky, client);
+        if (!request.setUrl("%s/api/states/all?lamin=%.6f&lamax=%.6f&lomin=%.6f&lomax=%.6f",
+                            APIConfiguration::OPENSKY_BASE_URL,
+                            latMin,
+                            latMax,
+                            lonMin,
+                            lonMax))
         {
-            s_lastTlsFailMs = millis();
+            return false;
         }
-        bool attemptedRefresh = false;
-        if (code == 401 && m_accessToken.length() > 0)
+        // OAuth Bearer required; formatted in place rather than through a String temporary.
+        static char bearer[kMaxAuthorizationLen];
+        const int bearerLen = snprintf(bearer, sizeof(bearer), "Bearer %s", m_accessToken.c_str());
+        if (bearerLen < 0 || (size_t)bearerLen >= sizeof(bearer))
         {
-            // Try refresh once
-            http.end();
+            Serial.printf("OpenSkyFetcher: access token exceeds %u bytes\n", (unsigned)sizeof(bearer));
+            return false;
+        }
+        request.addHeader("Authorization", bearer);
+        request.acceptCompressed();
+        request.setTimeout(15000);
+
+        int code = request.get();
+        if (code == 401 && attempt == 0 && m_accessToken.length() > 0)
+        {
+            request.end();
             if (ensureAccessToken(true))
             {
-                WiFiClientSecure retryClient;
-                retryClient.setInsecure();
-                HTTPClient retry;
-                retry.begin(retryClient, url);
-                retry.addHeader("Authorization", String("Bearer ") + m_accessToken);
-                retry.useHTTP10(true);
-                retry.setReuse(false);
-                retry.setTimeout(15000);
-                code = retry.GET();
-                if (code != 200)
-                {
-                    Serial.print("OpenSkyFetcher: HTTP retry failed with code: ");
-                    Serial.println(code);
-                    retry.end();
-                    return false;
-                }
-                WiFiClient *retryStream = retry.getStreamPtr();
-                if (!retryStream)
-                {
-                    retry.end();
-                    return false;
-                }
-                retryStream->setTimeout(15000);
-
-                DynamicJsonDocument doc(12288);
-                DeserializationError err = deserializeJson(doc, *retryStream);
-                retry.end();
-                if (err)
-                {
-                    Serial.print("OpenSkyFetcher: JSON deserialization error: ");
-                    Serial.println(err.c_str());
-                    return false;
-                }
-
-                JsonArray states = doc["states"].as<JsonArray>();
-                if (states.isNull())
-                {
-                    return true; // no states is not an error
-                }
-
-                for (JsonVariant v : states)
-                {
-                    if (!v.is<JsonArray>())
-                    {
-                        Serial.println("OpenSkyFetcher: Expected array element in states");
-                        continue;
-                    }
-                    JsonArray a = v.as<JsonArray>();
-                    if (a.size() < 17)
-                    {
-                        Serial.println("OpenSkyFetcher: State vector array has insufficient elements");
-                        continue;
-                    }
-
-                    StateVector s;
-                    s.icao24 = a[0].as<const char *>();
-                    s.callsign = a[1].isNull() ? String("") : String(a[1].as<const char *>());
-                    s.callsign.trim();
-                    s.origin_country = a[2].isNull() ? String("") : String(a[2].as<const char *>());
-                    s.time_position = a[3].isNull() ? 0 : a[3].as<long>();
-                    s.last_contact = a[4].isNull() ? 0 : a[4].as<long>();
-                    s.lon = a[5].isNull() ? NAN : a[5].as<double>();
-                    s.lat = a[6].isNull() ? NAN : a[6].as<double>();
-                    s.baro_altitude = a[7].isNull() ? NAN : a[7].as<double>();
-                    s.on_ground = a[8].isNull() ? false : a[8].as<bool>();
-                    s.velocity = a[9].isNull() ? NAN : a[9].as<double>();
-                    s.heading = a[10].isNull() ? NAN : a[10].as<double>();
-                    s.vertical_rate = a[11].isNull() ? NAN : a[11].as<double>();
-                    s.sensors = a[12].isNull() ? 0 : a[12].as<long>();
-                    s.geo_altitude = a[13].isNull() ? NAN : a[13].as<double>();
-                    s.squawk = a[14].isNull() ? String("") : String(a[14].as<const char *>());
-                    s.spi = a[15].isNull() ? false : a[15].as<bool>();
-                    s.position_source = a[16].isNull() ? 0 : a[16].as<int>();
-
-                    if (isnan(s.lat) || isnan(s.lon))
-                    {
-                        Serial.println("OpenSkyFetcher: Skipping state vector with invalid coordinates");
-                        continue;
-                    }
-
-                    s.distance_km = haversineKm(centerLat, centerLon, s.lat, s.lon);
-                    if (s.distance_km > radiusKm)
-                        continue;
-                    s.bearing_deg = computeBearingDeg(centerLat, centerLon, s.lat, s.lon);
-
-                    outStateVectors.push_back(s);
-                }
-
-                return true;
+                continue;
             }
-            attemptedRefresh = true;
+            Serial.println("OpenSkyFetcher: Token refresh attempt failed");
+            return false;
         }
-
-        Serial.print("OpenSkyFetcher: HTTP request failed with code: ");
-        Serial.println(code);
-        http.end();
-        if (attemptedRefresh)
+        if (code != 200)
         {
-            Serial.println("OpenSkyFetcher: Token refresh attempt failed");
+            Serial.print(attempt == 0 ? "OpenSkyFetcher: HTTP request failed with code: "
+                                      : "OpenSkyFetcher: HTTP retry failed with code: ");
+            Serial.println(code);
+            return false;
         }
-        return false;
-    }
-    WiFiClient *stream = http.getStreamPtr();
-    if (!stream)
-    {
-        http.end();
-        return false;
-    }
-    stream->setTimeout(15000);
 
-    DynamicJsonDocument doc(12288);
-    DeserializationError err = deserializeJson(doc, *stream);
-    http.end();
-    if (err)
-    {
-        Serial.print("OpenSkyFetcher: JSON deserialization error: ");
-        Serial.println(err.c_str());
-        return false;
-    }
+        Stream *stream = request.body();
+        if (!stream)
+        {
+            return false;
+        }
 
-    JsonArray states = doc["states"].as<JsonArray>();
-    if (states.isNull())
-    {
-        return true; // no states is not an error
-    }
+        // Socket reads run on the other core while this task parses.
+        PipelinedStream pipeline;
+        Stream *input = pipeline.begin(*stream, request.timeoutMs(), &request.connection()) ? static_cast<Stream *>(&pipeline) : stream;
 
-    for (JsonVariant v : states)
-    {
-        if (!v.is<JsonArray>())
+        DynamicJsonDocument doc(12288);
+        DeserializationError err = deserializeJson(doc, *input);
+        const unsigned long receivedMs = millis();
+        pipeline.end();
+        if (!err && !request.bodyIntact())
         {
-            Serial.println("OpenSkyFetcher: Expected array element in states");
-            continue;
+            err = DeserializationError::InvalidInput;
         }
-        JsonArray a = v.as<JsonArray>();
-        if (a.size() < 17)
+        request.end();
+        if (err)
         {
-            Serial.println("OpenSkyFetcher: State vector array has insufficient elements");
-            continue;
+            Serial.print("OpenSkyFetcher: JSON deserialization error: ");
+            Serial.println(err.c_str());
+            return false;
         }
 
-        StateVector s;
-        s.icao24 = a[0].as<const char *>();
-        s.callsign = a[1].isNull() ? String("") : String(a[1].as<const char *>());
-        s.callsign.trim();
-        s.origin_country = a[2].isNull() ? String("") : String(a[2].as<const char *>());
-        s.time_position = a[3].isNull() ? 0 : a[3].as<long>();
-        s.last_contact = a[4].isNull() ? 0 : a[4].as<long>();
-        s.lon = a[5].isNull() ? NAN : a[5].as<double>();
-        s.lat = a[6].isNull() ? NAN : a[6].as<double>();
-        s.baro_altitude = a[7].isNull() ? NAN : a[7].as<double>();
-        s.on_ground = a[8].isNull() ? false : a[8].as<bool>();
-        s.velocity = a[9].isNull() ? NAN : a[9].as<double>();
-        s.heading = a[10].isNull() ? NAN : a[10].as<double>();
-        s.vertical_rate = a[11].isNull() ? NAN : a[11].as<double>();
-        s.sensors = a[12].isNull() ? 0 : a[12].as<long>();
-        s.geo_altitude = a[13].isNull() ? NAN : a[13].as<double>();
-        s.squawk = a[14].isNull() ? String("") : String(a[14].as<const char *>());
-        s.spi = a[15].isNull() ? false : a[15].as<bool>();
-        s.position_source = a[16].isNull() ? 0 : a[16].as<int>();
-
-        if (isnan(s.lat) || isnan(s.lon))
+        JsonArray states = doc["states"].as<JsonArray>();
+        if (states.isNull())
         {
-            Serial.println("OpenSkyFetcher: Skipping state vector with invalid coordinates");
-            continue;
+            return true; // no states is not an error
         }
 
-        s.distance_km = haversineKm(centerLat, centerLon, s.lat, s.lon);
-        if (s.distance_km > radiusKm)
-            continue;
-        s.bearing_deg = computeBearingDeg(centerLat, centerLon, s.lat, s.lon);
-
-        outStateVectors.push_back(s);
+        const long responseTime = doc["time"] | 0L;
+        appendStateVectors(states, centerLat, centerLon, radiusKm, responseTime, receivedMs, outStateVectors);
+        return true;
     }
-
-    return true;
+    return false;
 }
@@ -21,7 +21,16 @@ public:
 
     bool ensureAuthenticated(bool forceRefresh = false);
 
+    // Tokens are renewed this long before they expire.
+    static const unsigned long kTokenSafetySkewMs = 60UL * 1000UL;
+    // True when a cached token is close enough to the refresh window that it should be
+    // renewed off the flight-fetch path.
+    bool tokenRefreshDue(unsigned long nowMs) const;
+
 private:
+    // Authorization header buffer; OpenSky's access tokens are JWTs of well over 1 KB.
+    static const size_t kMaxAuthorizationLen = 2048;
+
     String m_accessToken;
     unsigned long m_tokenExpiryMs = 0;
 
@@ -7,6 +7,10 @@ namespace HardwareConfiguration
     // Trinity HUB75 panel configuration
     static const uint16_t DISPLAY_MATRIX_WIDTH = 64;
     static const uint16_t DISPLAY_MATRIX_HEIGHT = 64;
+    // Panels in the chain and how many rows they are stacked in. The chain fills each
+    // row left to right, then continues at the left of the next row (64x64 panels:
+    // 2 in 1 row = 128x64, 4 in 2 rows = 128x128, 2 in 2 rows = 64x128).
     static const uint8_t DISPLAY_CHAIN_LENGTH = 1;
+    static const uint8_t DISPLAY_CHAIN_ROWS = 1;
     static const uint8_t DISPLAY_GPIO_E = 18; // Trinity maps E pin to GPIO18
 }
@@ -48,6 +48,9 @@ void RuntimeSettings::load()
     g_settings.textColorB = UserConfiguration::TEXT_COLOR_B;
     g_settings.altitudeFeet = UserConfiguration::ALTITUDE_FEET;
     g_settings.speedKts = UserConfiguration::SPEED_KTS;
+    g_settings.displayMode = UserConfiguration::DISPLAY_MODE;
+    g_settings.cardDesign = UserConfiguration::CARD_DESIGN;
+    g_settings.watchlist = UserConfiguration::WATCHLIST;
 
     g_settings.timezoneIana = UserConfiguration::TIMEZONE_IANA;
     g_settings.timezonePosix = resolvePosixFromIana(g_settings.timezoneIana, UserConfiguration::TIMEZONE_TZ);
@@ -75,6 +78,9 @@ void RuntimeSettings::load()
     g_settings.textColorB = prefs.getUInt("colorB", g_settings.textColorB);
     g_settings.altitudeFeet = prefs.getBool("altFeet", g_settings.altitudeFeet);
     g_settings.speedKts = prefs.getBool("spdKts", g_settings.speedKts);
+    g_settings.displayMode = prefs.getUInt("dispMode", g_settings.displayMode);
+    g_settings.cardDesign = prefs.getUInt("cardDesign", g_settings.cardDesign);
+    g_settings.watchlist = prefs.getString("watchlist", g_settings.watchlist);
 
     g_settings.timezoneIana = prefs.getString("tzIana", g_settings.timezoneIana);
     g_settings.timezonePosix = resolvePosixFromIana(g_settings.timezoneIana, g_settings.timezonePosix);
@@ -110,6 +116,9 @@ bool RuntimeSettings::save(const FlightWatchSettings &newSettings)
     prefs.putUInt("colorB", copy.textColorB);
     prefs.putBool("altFeet", copy.altitudeFeet);
     prefs.putBool("spdKts", copy.speedKts);
+    prefs.putUInt("dispMode", copy.displayMode);
+    prefs.putUInt("cardDesign", copy.cardDesign);
+    prefs.putString("watchlist", copy.watchlist);
 
     prefs.putString("tzIana", copy.timezoneIana);
     prefs.putString("tzPosix", copy.timezonePosix);
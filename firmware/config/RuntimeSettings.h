@@ -20,6 +20,9 @@ struct FlightWatchSettings
     uint8_t textColorB;
     bool altitudeFeet;
     bool speedKts;
+    uint8_t displayMode; // UserConfiguration::DISPLAY_MODE values
+    uint8_t cardDesign;  // CardLayout design index
+    String watchlist;    // utils/Watchlist syntax
 
     String timezoneIana;
     String timezonePosix;
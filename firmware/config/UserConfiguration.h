@@ -22,6 +22,19 @@ namespace UserConfiguration
     static const bool ALTITUDE_FEET = false; // false = meters, true = feet
     static const bool SPEED_KTS = false;     // false = km/h, true = knots
 
+    // Main screen: 0 = flight cards, 1 = radar (plan view of all aircraft in range),
+    // 2 = list of the nearest aircraft (callsign, type, altitude, distance).
+    // Stacked panel walls always show a card above the radar (or the list in mode 2).
+    static const uint8_t DISPLAY_MODE = 0;
+
+    // Flight card design: index into tools/card_designs.json (0 = classic).
+    static const uint8_t CARD_DESIGN = 0;
+
+    // Watchlist: aircraft to bring to the front as soon as they are in range (see
+    // utils/Watchlist.h), e.g. "DLH438, BAW, type:A388, type:B74*, hex:ae*, sq:7000".
+    // Emergency squawks 7500/7600/7700 are always watched.
+    static constexpr const char *WATCHLIST = "";
+
     // Timezone defaults
     static constexpr const char *TIMEZONE_IANA = "Europe/Berlin";
     // POSIX/TZ format. Example: Berlin CET/CEST
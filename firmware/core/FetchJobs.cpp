@@ -0,0 +1,125 @@
+/*
+Purpose: The network jobs run by FetchScheduler on the fetch task.
+Responsibilities:
+- FlightFetchJob: OpenSky states, then AeroAPI enrichment one ident per step; publish the result.
+- TokenRefreshJob: renew the OpenSky OAuth token ahead of expiry.
+- WeatherJob: refresh Open-Meteo current conditions for the clock screen.
+- WifiWatchdogJob: reconnect WiFi when the connection drops.
+*/
+#include "core/FetchJobs.h"
+#include <WiFi.h>
+#include "config/RuntimeSettings.h"
+#include "utils/NetLock.h"
+
+FlightFetchJob::FlightFetchJob(FlightDataFetcher &fetcher, unsigned long intervalMs, PublishFn publish)
+    : _fetcher(fetcher), _intervalMs(intervalMs), _publish(publish) {}
+
+bool FlightFetchJob::due(unsigned long nowMs)
+{
+    // The first pass starts as soon as WiFi is up, overlapping the boot animation.
+    if (!_started)
+        return true;
+    return nowMs - _lastStartMs >= _intervalMs;
+}
+
+void FlightFetchJob::start(unsigned long nowMs)
+{
+    _started = true;
+    _lastStartMs = nowMs;
+    _phase = Phase::States;
+    _states.clear();
+    _flights.clear();
+}
+
+bool FlightFetchJob::step(unsigned long nowMs)
+{
+    (void)nowMs;
+    if (_phase == Phase::States)
+    {
+        if (!_fetcher.beginPass(_states))
+        {
+            publish();
+            return false;
+        }
+        _phase = Phase::Enrich;
+        return true;
+    }
+
+    if (_fetcher.enrichNext(_flights))
+        return true;
+    publish();
+    return false;
+}
+
+void FlightFetchJob::cancel()
+{
+    publish();
+}
+
+void FlightFetchJob::publish()
+{
+    if (_publish)
+    {
+        _publish(_states, _flights, _flights.size());
+    }
+    // Drop the pass's buffers until the next start.
+    std::vector<StateVector>().swap(_states);
+    std::vector<FlightInfo>().swap(_flights);
+}
+
+bool TokenRefreshJob::due(unsigned long nowMs)
+{
+    if (!_openSky.tokenRefreshDue(nowMs))
+        return false;
+    return !_attempted || nowMs - _lastAttemptMs >= kRetryMs;
+}
+
+bool TokenRefreshJob::step(unsigned long nowMs)
+{
+    (void)nowMs;
+    _attempted = true;
+    NetLock::Guard guard(5000);
+    if (!guard.locked())
+        return false;
+    _openSky.ensureAuthenticated(true);
+    return false;
+}
+
+bool WeatherJob::due(unsigned long nowMs)
+{
+    if (!_attempted)
+        return true;
+    if (_lastOk)
+        return nowMs - _lastAttemptMs >= kRefreshMs;
+    return nowMs - _lastAttemptMs >= kFailRetryMs;
+}
+
+bool WeatherJob::step(unsigned long nowMs)
+{
+    (void)nowMs;
+    _attempted = true;
+    const auto &cfg = RuntimeSettings::current();
+    WeatherInfo weather;
+    _lastOk = _meteo.fetchCurrent(cfg.weatherLat, cfg.weatherLon, weather);
+    if (_lastOk && _publish)
+    {
+        _publish(weather);
+    }
+    return false;
+}
+
+bool WifiWatchdogJob::step(unsigned long nowMs)
+{
+    (void)nowMs;
+    bool badStatus = (WiFi.status() != WL_CONNECTED);
+    bool missingIp = (WiFi.localIP().toString() == "0.0.0.0");
+    if (badStatus || missingIp)
+    {
+        Serial.println("WiFi watchdog: connection lost; attempting reconnect");
+        Serial.printf("Current status=%d, ip=%s\n", (int)WiFi.status(), WiFi.localIP().toString().c_str());
+        WiFi.disconnect(true);
+        delay(200);
+        WiFi.begin(); // reconnect using stored credentials
+    }
+    return false;
+}
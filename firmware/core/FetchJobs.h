@@ -0,0 +1,108 @@
+#pragma once
+
+#include <Arduino.h>
+#include <functional>
+#include <vector>
+#include "interfaces/BaseFetchJob.h"
+#include "core/FlightDataFetcher.h"
+#include "adapters/OpenSkyFetcher.h"
+#include "adapters/OpenMeteoFetcher.h"
+#include "models/StateVector.h"
+#include "models/FlightInfo.h"
+#include "models/WeatherInfo.h"
+
+// OpenSky state vectors, then one AeroAPI enrichment per step. A cancelled pass still
+// publishes the flights enriched so far.
+class FlightFetchJob : public BaseFetchJob
+{
+public:
+    using PublishFn = std::function<void(const std::vector<StateVector> &states,
+                                         const std::vector<FlightInfo> &flights,
+                                         size_t enriched)>;
+
+    FlightFetchJob(FlightDataFetcher &fetcher, unsigned long intervalMs, PublishFn publish);
+
+    const char *name() const override { return "flights"; }
+    bool due(unsigned long nowMs) override;
+    void start(unsigned long nowMs) override;
+    bool step(unsigned long nowMs) override;
+    void cancel() override;
+
+private:
+    enum class Phase : uint8_t
+    {
+        States,
+        Enrich,
+    };
+
+    void publish();
+
+    FlightDataFetcher &_fetcher;
+    unsigned long _intervalMs;
+    PublishFn _publish;
+    unsigned long _lastStartMs = 0;
+    bool _started = false;
+    Phase _phase = Phase::States;
+    std::vector<StateVector> _states;
+    std::vector<FlightInfo> _flights;
+};
+
+// Renews the OpenSky token shortly before its refresh window so flight passes never
+// pay for the auth round trip.
+class TokenRefreshJob : public BaseFetchJob
+{
+public:
+    explicit TokenRefreshJob(OpenSkyFetcher &openSky) : _openSky(openSky) {}
+
+    const char *name() const override { return "token"; }
+    bool due(unsigned long nowMs) override;
+    void start(unsigned long nowMs) override { _lastAttemptMs = nowMs; }
+    bool step(unsigned long nowMs) override;
+
+private:
+    static const unsigned long kRetryMs = 30UL * 1000UL;
+
+    OpenSkyFetcher &_openSky;
+    unsigned long _lastAttemptMs = 0;
+    bool _attempted = false;
+};
+
+// Current conditions from Open-Meteo every 10 minutes, retrying failures after 2.
+class WeatherJob : public BaseFetchJob
+{
+public:
+    using PublishFn = std::function<void(const WeatherInfo &weather)>;
+
+    WeatherJob(OpenMeteoFetcher &meteo, PublishFn publish) : _meteo(meteo), _publish(publish) {}
+
+    const char *name() const override { return "weather"; }
+    bool due(unsigned long nowMs) override;
+    void start(unsigned long nowMs) override { _lastAttemptMs = nowMs; }
+    bool step(unsigned long nowMs) override;
+
+private:
+    static const unsigned long kRefreshMs = 10UL * 60UL * 1000UL;
+    static const unsigned long kFailRetryMs = 2UL * 60UL * 1000UL;
+
+    OpenMeteoFetcher &_meteo;
+    PublishFn _publish;
+    unsigned long _lastAttemptMs = 0;
+    bool _attempted = false;
+    bool _lastOk = false;
+};
+
+// Reconnects WiFi from stored credentials when the link or the DHCP lease is lost.
+class WifiWatchdogJob : public BaseFetchJob
+{
+public:
+    const char *name() const override { return "wifi"; }
+    bool needsNetwork() const override { return false; }
+    bool due(unsigned long nowMs) override { return nowMs - _lastCheckMs >= kCheckEveryMs; }
+    void start(unsigned long nowMs) override { _lastCheckMs = nowMs; }
+    bool step(unsigned long nowMs) override;
+
+private:
+    static const unsigned long kCheckEveryMs = 10000UL;
+
+    unsigned long _lastCheckMs = 0;
+};
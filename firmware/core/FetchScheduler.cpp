@@ -0,0 +1,85 @@
+/*
+Purpose: Drive every network job (flights, token refresh, weather, WiFi watchdog) from the fetch task.
+Responsibilities:
+- Start jobs when due and WiFi allows, one pass at a time per job.
+- Interleave running jobs one step at a time (round robin).
+- Enforce each pass's deadline: clamp HTTP timeouts through ApiHttp::setDeadline and
+  cancel passes that overrun or lose WiFi.
+*/
+#include "core/FetchScheduler.h"
+#include <WiFi.h>
+#include "utils/ApiHttpClient.h"
+
+bool FetchScheduler::addJob(BaseFetchJob *job, unsigned long passBudgetMs)
+{
+    if (job == nullptr || _count >= kMaxJobs)
+    {
+        Serial.println("FetchScheduler: job table full");
+        return false;
+    }
+    Slot &slot = _slots[_count++];
+    slot.job = job;
+    slot.budgetMs = passBudgetMs;
+    return true;
+}
+
+void FetchScheduler::finish(Slot &slot, bool cancelled, const char *reason)
+{
+    slot.running = false;
+    if (cancelled)
+    {
+        Serial.printf("FetchScheduler: %s cancelled after %lu ms (%s)\n",
+                      slot.job->name(),
+                      millis() - slot.startedMs,
+                      reason);
+        slot.job->cancel();
+    }
+}
+
+bool FetchScheduler::tick()
+{
+    const unsigned long now = millis();
+    const bool wifiUp = WiFi.status() == WL_CONNECTED;
+
+    for (size_t i = 0; i < _count; ++i)
+    {
+        Slot &slot = _slots[i];
+        const bool offline = slot.job->needsNetwork() && !wifiUp;
+        if (slot.running)
+        {
+            if (offline)
+            {
+                finish(slot, true, "WiFi down");
+            }
+            else if ((long)(now - slot.deadlineMs) >= 0)
+            {
+                finish(slot, true, "deadline");
+            }
+        }
+        else if (!offline && slot.job->due(now))
+        {
+            slot.running = true;
+            slot.startedMs = now;
+            slot.deadlineMs = now + slot.budgetMs;
+            slot.job->start(now);
+        }
+    }
+
+    for (size_t n = 0; n < _count; ++n)
+    {
+        Slot &slot = _slots[(_next + n) % _count];
+        if (!slot.running)
+            continue;
+        _next = (_next + n + 1) % _count;
+
+        ApiHttp::setDeadline(slot.deadlineMs);
+        const bool more = slot.job->step(now);
+        ApiHttp::setDeadline(0);
+        if (!more)
+        {
+            finish(slot, false, nullptr);
+        }
+        return true;
+    }
+    return false;
+}
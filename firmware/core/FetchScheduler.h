@@ -0,0 +1,35 @@
+#pragma once
+
+#include <Arduino.h>
+#include "interfaces/BaseFetchJob.h"
+
+// Cooperative round-robin driver for the fetch task. Each job pass gets a hard deadline:
+// ApiHttp clamps request timeouts to it, and a pass still running when it expires is
+// cancelled instead of stacking another full timeout.
+class FetchScheduler
+{
+public:
+    static const size_t kMaxJobs = 6;
+
+    bool addJob(BaseFetchJob *job, unsigned long passBudgetMs);
+
+    // Starts due jobs, cancels expired ones and runs at most one step.
+    // Returns true if a step ran, so the caller can skip its idle delay.
+    bool tick();
+
+private:
+    struct Slot
+    {
+        BaseFetchJob *job = nullptr;
+        unsigned long budgetMs = 0;
+        unsigned long startedMs = 0;
+        unsigned long deadlineMs = 0;
+        bool running = false;
+    };
+
+    void finish(Slot &slot, bool cancelled, const char *reason);
+
+    Slot _slots[kMaxJobs];
+    size_t _count = 0;
+    size_t _next = 0;
+};
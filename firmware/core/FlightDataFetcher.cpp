@@ -2,13 +2,22 @@
 Purpose: Orchestrate fetching and enrichment of flight data for display.
 Flow:
 1) Use BaseStateVectorFetcher to fetch nearby state vectors by geo filter.
-2) For each callsign, use BaseFlightFetcher (e.g., AeroAPI) to retrieve FlightInfo.
+2) For each callsign, use BaseFlightFetcher (e.g., AeroAPI) to retrieve FlightInfo. States
+   are visited watchlist matches first, then in order of predicted closest pass
+   (ClosestApproach), so the few AeroAPI calls of a pass go to the aircraft about to fly
+   overhead. Watchlist matches are enriched regardless of the per-pass call limit.
 3) Enrich names using AeroAPI data when present, with embedded lookup tables (no CDN dependency).
+4) Stamp each FlightInfo with a content version so the display can skip relayout cheaply.
 Output: Returns count of enriched flights and fills outStates/outFlights.
+The same flow is exposed step by step (beginPass/enrichNext) so the fetch scheduler can
+interleave other jobs and enforce a deadline between AeroAPI calls.
 */
 #include "core/FlightDataFetcher.h"
 #include "config/RuntimeSettings.h"
+#include "utils/ClosestApproach.h"
+#include "utils/Watchlist.h"
 #include <strings.h>
+#include <algorithm>
 
 struct LookupEntry { const char *icao; const char *name; };
 
@@ -165,6 +174,76 @@ static String deriveAirlineFromCallsign(const String &callsign)
     return String("");
 }
 
+static void applyDisplayNames(const StateVector &s, FlightInfo &info)
+{
+    // Carry forward live metrics from the state vector
+    info.icao24 = s.icao24;
+    info.baro_altitude_m = s.baro_altitude;
+    info.velocity_mps = s.velocity;
+    info.track_deg = s.heading;
+    info.vertical_rate_mps = s.vertical_rate;
+    info.position_ms = s.position_ms;
+    info.distance_km = s.distance_km;
+    info.bearing_deg = s.bearing_deg;
+    info.cpa_distance_km = s.cpa_distance_km;
+    info.cpa_time_s = s.cpa_time_s;
+    info.watch = s.watch | Watchlist::active().matchType(info.aircraft_code);
+
+    // Prefer AeroAPI operator_icao mapped to full name; fall back to operator_code; then callsign-derived prefix.
+    if (info.operator_icao.length())
+    {
+        String opIcao = info.operator_icao;
+        opIcao.trim();
+        String airline = lookupFromTable(kAirlineLookup, kAirlineLookup_COUNT, opIcao);
+        if (airline.length() == 0)
+        {
+            airline = opIcao; // last-resort code for readability
+        }
+        info.airline_display_name_full = airline;
+    }
+    else if (info.operator_code.length())
+    {
+        info.airline_display_name_full = info.operator_code;
+    }
+    else
+    {
+        // Derive from callsign prefix if AeroAPI returned nothing.
+        String prefix = deriveAirlineFromCallsign(s.callsign);
+        if (prefix.length())
+        {
+            String airline = lookupFromTable(kAirlineLookup, kAirlineLookup_COUNT, prefix);
+            info.airline_display_name_full = airline.length() ? airline : prefix;
+        }
+        else
+        {
+            // Debug: AeroAPI returned no operator info; log once for visibility.
+            static int missingOpLogCount = 0;
+            if (missingOpLogCount < 5)
+            {
+                Serial.printf("Enrichment: missing operator for ident=%s\n", s.callsign.c_str());
+                missingOpLogCount++;
+            }
+        }
+    }
+
+    if (info.aircraft_code.length())
+    {
+        String acIcao = info.aircraft_code;
+        acIcao.trim();
+        String aircraftShort = lookupFromTable(kAircraftLookup, kAircraftLookup_COUNT, acIcao);
+        if (aircraftShort.length() == 0)
+        {
+            aircraftShort = acIcao; // last-resort code
+        }
+        aircraftShort = normalizeAircraftLabel(aircraftShort);
+        if (aircraftShort.length() == 0)
+        {
+            aircraftShort = acIcao; // ensure non-empty label
+        }
+        info.aircraft_display_name_short = aircraftShort;
+    }
+}
+
 FlightDataFetcher::FlightDataFetcher(BaseStateVectorFetcher *stateFetcher,
                                      BaseFlightFetcher *flightFetcher)
     : _stateFetcher(stateFetcher), _flightFetcher(flightFetcher) {}
@@ -172,12 +251,25 @@ FlightDataFetcher::FlightDataFetcher(BaseStateVectorFetcher *stateFetcher,
 size_t FlightDataFetcher::fetchFlights(std::vector<StateVector> &outStates,
                                        std::vector<FlightInfo> &outFlights)
 {
-    outStates.clear();
     outFlights.clear();
-    const unsigned long nowMs = millis();
-    pruneCache(nowMs);
-    std::vector<String> seenIdents;
-    size_t aeroFetchesThisPass = 0;
+    if (!beginPass(outStates))
+        return 0;
+    while (enrichNext(outFlights))
+    {
+    }
+    return _enriched;
+}
+
+bool FlightDataFetcher::beginPass(std::vector<StateVector> &outStates)
+{
+    outStates.clear();
+    _passStates = nullptr;
+    _nextState = 0;
+    _enriched = 0;
+    _aeroFetchesThisPass = 0;
+    _seenIdents.clear();
+    _passStartMs = millis();
+    pruneCache(_passStartMs);
 
     const auto &cfg = RuntimeSettings::current();
     bool ok = _stateFetcher->fetchStateVectors(
@@ -186,91 +278,56 @@ size_t FlightDataFetcher::fetchFlights(std::vector<StateVector> &outStates,
         cfg.radiusKm,
         outStates);
     if (!ok)
-        return 0;
+        return false;
+
+    ClosestApproach::predict(outStates);
+    std::stable_sort(outStates.begin(), outStates.end(), [](const StateVector &a, const StateVector &b) {
+        if ((a.watch != 0) != (b.watch != 0))
+            return a.watch != 0;
+        return ClosestApproach::before(a, b);
+    });
+    _passStates = &outStates;
+    return true;
+}
+
+bool FlightDataFetcher::enrichNext(std::vector<FlightInfo> &outFlights)
+{
+    if (_passStates == nullptr)
+        return false;
 
-    size_t enriched = 0;
-    for (const StateVector &s : outStates)
+    while (_nextState < _passStates->size())
     {
+        const StateVector &s = (*_passStates)[_nextState++];
         if (s.callsign.length() == 0)
         {
             continue;
         }
-        if (alreadySeenIdent(seenIdents, s.callsign))
+        if (alreadySeenIdent(_seenIdents, s.callsign))
         {
             continue; // skip duplicate ident within the same fetch pass
         }
-        seenIdents.push_back(s.callsign);
+        _seenIdents.push_back(s.callsign);
 
         FlightInfo info;
-        bool cacheHit = getCachedFlight(s.callsign, info, nowMs);
-        if (cacheHit || (aeroFetchesThisPass < kMaxAeroFetchPerPass && _flightFetcher->fetchFlightInfo(s.callsign, info)))
+        bool cacheHit = getCachedFlight(s.callsign, info, _passStartMs);
+        const bool withinLimit = _aeroFetchesThisPass < kMaxAeroFetchPerPass || s.watch != 0;
+        if (cacheHit || (withinLimit && _flightFetcher->fetchFlightInfo(s.callsign, info)))
         {
             if (!cacheHit)
             {
-                aeroFetchesThisPass++;
-                saveCacheEntry(s.callsign, info, nowMs);
-            }
-
-            // Carry forward live metrics from the state vector
-            info.baro_altitude_m = s.baro_altitude;
-            info.velocity_mps = s.velocity;
-
-            // Prefer AeroAPI operator_icao mapped to full name; fall back to operator_code; then callsign-derived prefix.
-            if (info.operator_icao.length())
-            {
-                String opIcao = info.operator_icao;
-                opIcao.trim();
-                String airline = lookupFromTable(kAirlineLookup, kAirlineLookup_COUNT, opIcao);
-                if (airline.length() == 0)
-                {
-                    airline = opIcao; // last-resort code for readability
-                }
-                info.airline_display_name_full = airline;
-            }
-            else if (info.operator_code.length())
-            {
-                info.airline_display_name_full = info.operator_code;
-            }
-            else
-            {
-                // Derive from callsign prefix if AeroAPI returned nothing.
-                String prefix = deriveAirlineFromCallsign(s.callsign);
-                if (prefix.length())
-                {
-                    String airline = lookupFromTable(kAirlineLookup, kAirlineLookup_COUNT, prefix);
-                    info.airline_display_name_full = airline.length() ? airline : prefix;
-                }
-                else
-                {
-                    // Debug: AeroAPI returned no operator info; log once for visibility.
-                    static int missingOpLogCount = 0;
-                    if (missingOpLogCount < 5)
-                    {
-                        Serial.printf("Enrichment: missing operator for ident=%s\n", s.callsign.c_str());
-                        missingOpLogCount++;
-                    }
-                }
-            }
-
-            if (info.aircraft_code.length())
-            {
-                String acIcao = info.aircraft_code;
-                acIcao.trim();
-                String aircraftShort = lookupFromTable(kAircraftLookup, kAircraftLookup_COUNT, acIcao);
-                if (aircraftShort.length() == 0)
-                {
-                    aircraftShort = acIcao; // last-resort code
-                }
-                aircraftShort = normalizeAircraftLabel(aircraftShort);
-                if (aircraftShort.length() == 0)
-                {
-                    aircraftShort = acIcao; // ensure non-empty label
-                }
-                info.aircraft_display_name_short = aircraftShort;
+                _aeroFetchesThisPass++;
+                saveCacheEntry(s.callsign, info, _passStartMs);
             }
+            applyDisplayNames(s, info);
+            info.version = flightDisplayVersion(info);
             outFlights.push_back(info);
-            enriched++;
+            _enriched++;
         }
+        break; // one ident per step
     }
-    return enriched;
+
+    if (_nextState < _passStates->size())
+        return true;
+    _passStates = nullptr;
+    return false;
 }
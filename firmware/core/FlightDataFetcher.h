@@ -16,7 +16,21 @@ public:
     size_t fetchFlights(std::vector<StateVector> &outStates,
                         std::vector<FlightInfo> &outFlights);
 
+    // Step-wise form of fetchFlights for the fetch scheduler. beginPass fetches state
+    // vectors into outStates, which must stay alive until the pass ends; each enrichNext
+    // call then enriches at most one ident. Returns false once every state was visited.
+    bool beginPass(std::vector<StateVector> &outStates);
+    bool enrichNext(std::vector<FlightInfo> &outFlights);
+    size_t enrichedCount() const { return _enriched; }
+
 private:
     BaseStateVectorFetcher *_stateFetcher;
     BaseFlightFetcher *_flightFetcher;
+
+    const std::vector<StateVector> *_passStates = nullptr;
+    size_t _nextState = 0;
+    size_t _enriched = 0;
+    size_t _aeroFetchesThisPass = 0;
+    unsigned long _passStartMs = 0;
+    std::vector<String> _seenIdents;
 };
@@ -0,0 +1,162 @@
+/*
+Purpose: Host (Linux) implementation of the Arduino core pieces the display code needs.
+Responsibilities:
+- Virtual millis() clock advanced by the host runner; real micros() for timing, and a
+  switch that puts millis() on the real clock for the network tests.
+- Serial on stderr; getLocalTime() from a fixed epoch plus the virtual clock.
+- Stream's timed reads, a seeded random(), and the fixed ESP heap figures.
+- In-memory Preferences so RuntimeSettings loads its defaults.
+*/
+#include <Arduino.h>
+#include <Preferences.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+namespace
+{
+    // Atomic because fetch-side tests read the clock from several tasks.
+    std::atomic<unsigned long> g_virtualMs{0};
+    std::atomic<bool> g_realMillis{false};
+    uint32_t g_randomState = 1;
+    const std::chrono::steady_clock::time_point g_start = std::chrono::steady_clock::now();
+
+    // 2024-06-01 12:00:00 UTC: a fixed wall clock keeps clock screens reproducible.
+    constexpr time_t kEpoch = 1717243200;
+
+    std::map<std::string, Preferences::Namespace> &store()
+    {
+        static std::map<std::string, Preferences::Namespace> namespaces;
+        return namespaces;
+    }
+}
+
+static unsigned long realMillis()
+{
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - g_start)
+        .count();
+}
+
+unsigned long millis()
+{
+    return g_realMillis ? realMillis() : g_virtualMs.load();
+}
+
+unsigned long micros()
+{
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - g_start)
+        .count();
+}
+
+void delay(unsigned long ms)
+{
+    // Display code never blocks on the panel; a delay only moves the virtual clock.
+    if (g_realMillis)
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    else
+        g_virtualMs += ms;
+}
+
+void hostSetMillis(unsigned long ms)
+{
+    g_virtualMs = ms;
+}
+
+void hostAdvanceMillis(unsigned long ms)
+{
+    g_virtualMs += ms;
+}
+
+void hostUseRealMillis(bool real)
+{
+    g_realMillis = real;
+}
+
+void randomSeed(unsigned long seed)
+{
+    g_randomState = seed ? (uint32_t)seed : 1;
+}
+
+long random(long howBig)
+{
+    if (howBig <= 0)
+        return 0;
+    // xorshift32: the sequence only has to be repeatable, not good.
+    g_randomState ^= g_randomState << 13;
+    g_randomState ^= g_randomState >> 17;
+    g_randomState ^= g_randomState << 5;
+    return (long)(g_randomState % (uint32_t)howBig);
+}
+
+long random(long howSmall, long howBig)
+{
+    return howSmall >= howBig ? howSmall : howSmall + random(howBig - howSmall);
+}
+
+int Stream::timedRead()
+{
+    const unsigned long start = realMillis();
+    do
+    {
+        const int c = read();
+        if (c >= 0)
+            return c;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    } while (realMillis() - start < m_timeoutMs);
+    return -1;
+}
+
+size_t Stream::readBytes(char *buffer, size_t length)
+{
+    size_t count = 0;
+    while (count < length)
+    {
+        const int c = timedRead();
+        if (c < 0)
+            break;
+        buffer[count++] = (char)c;
+    }
+    return count;
+}
+
+bool getLocalTime(struct tm *info, uint32_t)
+{
+    const time_t now = kEpoch + (time_t)(g_virtualMs / 1000);
+    return gmtime_r(&now, info) != nullptr;
+}
+
+bool Preferences::begin(const char *name, bool readOnly)
+{
+    m_ns = &store()[name ? name : ""];
+    m_readOnly = readOnly;
+    return true;
+}
+
+bool Preferences::clear()
+{
+    if (m_ns == nullptr || m_readOnly)
+        return false;
+    *m_ns = Namespace();
+    return true;
+}
+
+String Preferences::getString(const char *key, String def)
+{
+    if (m_ns == nullptr)
+        return def;
+    auto it = m_ns->strings.find(key);
+    return it == m_ns->strings.end() ? def : String(it->second);
+}
+
+size_t Preferences::putString(const char *key, String v)
+{
+    if (m_ns == nullptr || m_readOnly)
+        return 0;
+    m_ns->strings[key] = v.str();
+    return v.length();
+}
@@ -0,0 +1,106 @@
+/*
+Purpose: Host BaseDisplay backed by an in-memory framebuffer.
+Responsibilities:
+- Drive NeoMatrixDisplay against the host HUB75 panel stand-in.
+- Count pixel writes and time per rendered frame; detect frames that changed.
+- Unfold chained panels into the viewer's layout and dump frames as PPM.
+*/
+#include "host/HostFramebufferDisplay.h"
+#include <ESP32-HUB75-MatrixPanel-I2S-DMA.h>
+#include "config/HardwareConfiguration.h"
+
+bool HostFramebufferDisplay::initialize()
+{
+    if (!m_display.initialize())
+        return false;
+    m_panel = MatrixPanel_I2S_DMA::hostInstance();
+    if (m_panel == nullptr)
+        return false;
+
+    const uint8_t rows = HardwareConfiguration::DISPLAY_CHAIN_ROWS > 0
+                             ? HardwareConfiguration::DISPLAY_CHAIN_ROWS
+                             : 1;
+    m_width = (int16_t)(HardwareConfiguration::DISPLAY_MATRIX_WIDTH *
+                        (HardwareConfiguration::DISPLAY_CHAIN_LENGTH / rows));
+    m_height = (int16_t)(HardwareConfiguration::DISPLAY_MATRIX_HEIGHT * rows);
+    snapshot(m_previous);
+    return true;
+}
+
+void HostFramebufferDisplay::clear()
+{
+    const uint32_t writes = m_panel ? m_panel->hostPixelWrites() : 0;
+    const uint32_t startUs = micros();
+    m_display.clear();
+    measure(writes, startUs);
+}
+
+void HostFramebufferDisplay::displayFlights(const std::vector<FlightInfo> &flights)
+{
+    const uint32_t writes = m_panel ? m_panel->hostPixelWrites() : 0;
+    const uint32_t startUs = micros();
+    m_display.displayFlights(flights);
+    measure(writes, startUs);
+}
+
+void HostFramebufferDisplay::measure(uint32_t writesBefore, uint32_t startUs)
+{
+    m_last.renderUs = micros() - startUs;
+    if (m_panel == nullptr)
+        return;
+    m_last.pixelWrites = m_panel->hostPixelWrites() - writesBefore;
+
+    std::vector<uint8_t> shown;
+    snapshot(shown);
+    m_last.changed = shown != m_previous;
+    m_previous.swap(shown);
+}
+
+void HostFramebufferDisplay::snapshot(std::vector<uint8_t> &rgb) const
+{
+    rgb.assign((size_t)m_width * m_height * 3, 0);
+    if (m_panel == nullptr)
+        return;
+
+    const int16_t tileW = (int16_t)HardwareConfiguration::DISPLAY_MATRIX_WIDTH;
+    const int16_t tileH = (int16_t)HardwareConfiguration::DISPLAY_MATRIX_HEIGHT;
+    const int16_t columns = m_width / tileW;
+    const int16_t chainWidth = m_panel->width();
+    const uint16_t *front = m_panel->hostFrontBuffer();
+    const uint32_t brightness = m_panel->hostBrightness();
+
+    for (int16_t y = 0; y < m_height; ++y)
+    {
+        for (int16_t x = 0; x < m_width; ++x)
+        {
+            // Same mapping as Hub75Surface: panel row r starts at chain tile r * columns.
+            const int16_t tile = (y / tileH) * columns + x / tileW;
+            const int16_t chainX = tile * tileW + x % tileW;
+            const int16_t chainY = y % tileH;
+            const uint16_t c = front[(size_t)chainY * chainWidth + chainX];
+            const uint8_t r5 = (c >> 11) & 0x1F;
+            const uint8_t g6 = (c >> 5) & 0x3F;
+            const uint8_t b5 = c & 0x1F;
+            uint8_t *px = &rgb[((size_t)y * m_width + x) * 3];
+            px[0] = (uint8_t)((((r5 << 3) | (r5 >> 2)) * brightness) / 255);
+            px[1] = (uint8_t)((((g6 << 2) | (g6 >> 4)) * brightness) / 255);
+            px[2] = (uint8_t)((((b5 << 3) | (b5 >> 2)) * brightness) / 255);
+        }
+    }
+}
+
+bool HostFramebufferDisplay::writePpm(const char *path) const
+{
+    std::vector<uint8_t> rgb;
+    snapshot(rgb);
+    FILE *f = fopen(path, "wb");
+    if (f == nullptr)
+    {
+        Serial.printf("HostFramebufferDisplay: cannot write %s\n", path);
+        return false;
+    }
+    fprintf(f, "P6\n%d %d\n255\n", m_width, m_height);
+    const bool ok = fwrite(rgb.data(), 1, rgb.size(), f) == rgb.size();
+    fclose(f);
+    return ok;
+}
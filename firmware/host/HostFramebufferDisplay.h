@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include "interfaces/BaseDisplay.h"
+#include "adapters/NeoMatrixDisplay.h"
+
+class MatrixPanel_I2S_DMA;
+
+// BaseDisplay for Linux: runs the firmware's NeoMatrixDisplay (card layout, marquees,
+// damage tracking, radar) unchanged against the in-memory RGB565 panel from
+// host/include, and measures every frame it renders.
+class HostFramebufferDisplay : public BaseDisplay
+{
+public:
+    struct FrameStats
+    {
+        uint32_t pixelWrites = 0; // pixels written into the panel buffer by this call
+        uint32_t renderUs = 0;    // wall time of the call
+        bool changed = false;     // shown image differs from the previous frame
+    };
+
+    bool initialize() override;
+    void clear() override;
+    void displayFlights(const std::vector<FlightInfo> &flights) override;
+
+    // The wrapped firmware display, for weather/radar updates and msUntilNextChange().
+    NeoMatrixDisplay &display() { return m_display; }
+    const FrameStats &lastFrame() const { return m_last; }
+
+    // Size of the whole display as seen by the viewer (chained panels unfolded).
+    int16_t width() const { return m_width; }
+    int16_t height() const { return m_height; }
+
+    // Shown image as RGB888 rows, brightness applied, chained panel rows unfolded.
+    void snapshot(std::vector<uint8_t> &rgb) const;
+    // Binary PPM (P6) of snapshot().
+    bool writePpm(const char *path) const;
+
+private:
+    void measure(uint32_t writesBefore, uint32_t startUs);
+
+    NeoMatrixDisplay m_display;
+    MatrixPanel_I2S_DMA *m_panel = nullptr;
+    int16_t m_width = 0;
+    int16_t m_height = 0;
+    FrameStats m_last;
+    std::vector<uint8_t> m_previous;
+};
@@ -0,0 +1,259 @@
+/*
+Purpose: Host (Linux) implementation of the FreeRTOS task and semaphore calls.
+Responsibilities:
+- Run each task on a POSIX thread, remembering the core it was pinned to.
+- Task notifications and binary/mutex semaphores on monotonic-clock condition variables.
+- vTaskDelete() of another task cancels it at its next blocking call and joins it, so a
+  caller that frees shared state afterwards sees the same ordering as on the chip.
+*/
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+struct HostTask
+{
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    uint32_t notifications = 0;
+    TaskFunction_t entry = nullptr;
+    void *arg = nullptr;
+    BaseType_t core = APP_CPU_NUM;
+};
+
+struct HostSemaphore
+{
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    unsigned count = 0;
+};
+
+namespace
+{
+    thread_local HostTask *t_self = nullptr;
+
+    void initSync(pthread_mutex_t &lock, pthread_cond_t &wake)
+    {
+        pthread_mutex_init(&lock, nullptr);
+        pthread_condattr_t attr;
+        pthread_condattr_init(&attr);
+        pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+        pthread_cond_init(&wake, &attr);
+        pthread_condattr_destroy(&attr);
+    }
+
+    void destroySync(pthread_mutex_t &lock, pthread_cond_t &wake)
+    {
+        pthread_cond_destroy(&wake);
+        pthread_mutex_destroy(&lock);
+    }
+
+    timespec deadlineAfter(TickType_t ticks)
+    {
+        timespec at;
+        clock_gettime(CLOCK_MONOTONIC, &at);
+        at.tv_sec += ticks / 1000;
+        at.tv_nsec += (long)(ticks % 1000) * 1000000L;
+        if (at.tv_nsec >= 1000000000L)
+        {
+            at.tv_sec += 1;
+            at.tv_nsec -= 1000000000L;
+        }
+        return at;
+    }
+
+    void unlockOnCancel(void *lock)
+    {
+        pthread_mutex_unlock(static_cast<pthread_mutex_t *>(lock));
+    }
+
+    // Waits until ready() holds or the ticks run out; the caller holds lock. Returns ready().
+    template <typename Ready>
+    bool waitFor(pthread_mutex_t &lock, pthread_cond_t &wake, TickType_t ticks, Ready ready)
+    {
+        const timespec deadline = deadlineAfter(ticks == portMAX_DELAY ? 0 : ticks);
+        pthread_cleanup_push(unlockOnCancel, &lock);
+        while (!ready())
+        {
+            if (ticks == portMAX_DELAY)
+                pthread_cond_wait(&wake, &lock);
+            else if (pthread_cond_timedwait(&wake, &lock, &deadline) == ETIMEDOUT)
+                break;
+        }
+        pthread_cleanup_pop(0);
+        return ready();
+    }
+
+    // Threads the tests start themselves (main included) get a record on first use; the
+    // Arduino loop task they stand in for runs on the app core.
+    HostTask *self()
+    {
+        if (t_self == nullptr)
+        {
+            t_self = new HostTask();
+            t_self->thread = pthread_self();
+            initSync(t_self->lock, t_self->wake);
+        }
+        return t_self;
+    }
+
+    void *taskMain(void *arg)
+    {
+        HostTask *task = static_cast<HostTask *>(arg);
+        t_self = task;
+        task->entry(task->arg);
+        // A FreeRTOS task must not return; treat it as deleting itself.
+        vTaskDelete(nullptr);
+        return nullptr;
+    }
+}
+
+BaseType_t xPortGetCoreID()
+{
+    return self()->core;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t entry, const char *, uint32_t, void *arg,
+                                   UBaseType_t, TaskHandle_t *created, BaseType_t core)
+{
+    HostTask *task = new HostTask();
+    task->entry = entry;
+    task->arg = arg;
+    task->core = core;
+    initSync(task->lock, task->wake);
+    // The handle is published before the thread runs, as FreeRTOS does for the caller.
+    if (created)
+        *created = task;
+    if (pthread_create(&task->thread, nullptr, taskMain, task) != 0)
+    {
+        destroySync(task->lock, task->wake);
+        delete task;
+        if (created)
+            *created = nullptr;
+        return pdFAIL;
+    }
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    if (task == nullptr || task == t_self)
+    {
+        HostTask *current = self();
+        t_self = nullptr;
+        pthread_detach(current->thread);
+        destroySync(current->lock, current->wake);
+        delete current;
+        pthread_exit(nullptr);
+    }
+    pthread_cancel(task->thread);
+    pthread_join(task->thread, nullptr);
+    destroySync(task->lock, task->wake);
+    delete task;
+}
+
+void vTaskSuspend(TaskHandle_t)
+{
+    for (;;)
+    {
+        const timespec nap = {1, 0};
+        nanosleep(&nap, nullptr); // cancellation point for vTaskDelete()
+    }
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    if (ticks == 0)
+    {
+        sched_yield();
+        return;
+    }
+    const timespec nap = {(time_t)(ticks / 1000), (long)(ticks % 1000) * 1000000L};
+    nanosleep(&nap, nullptr);
+}
+
+TickType_t xTaskGetTickCount()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (TickType_t)(now.tv_sec * 1000 + now.tv_nsec / 1000000L);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle()
+{
+    return self();
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks)
+{
+    HostTask *task = self();
+    pthread_mutex_lock(&task->lock);
+    waitFor(task->lock, task->wake, ticks, [task] { return task->notifications > 0; });
+    const uint32_t value = task->notifications;
+    if (value > 0)
+        task->notifications = clearOnExit ? 0 : value - 1;
+    pthread_mutex_unlock(&task->lock);
+    return value;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    if (task == nullptr)
+        return pdFAIL;
+    pthread_mutex_lock(&task->lock);
+    task->notifications++;
+    pthread_cond_signal(&task->wake);
+    pthread_mutex_unlock(&task->lock);
+    return pdPASS;
+}
+
+static SemaphoreHandle_t createSemaphore(unsigned initial)
+{
+    HostSemaphore *semaphore = new HostSemaphore();
+    semaphore->count = initial;
+    initSync(semaphore->lock, semaphore->wake);
+    return semaphore;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary()
+{
+    return createSemaphore(0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex()
+{
+    return createSemaphore(1);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks)
+{
+    pthread_mutex_lock(&semaphore->lock);
+    const bool taken = waitFor(semaphore->lock, semaphore->wake, ticks,
+                               [semaphore] { return semaphore->count > 0; });
+    if (taken)
+        semaphore->count--;
+    pthread_mutex_unlock(&semaphore->lock);
+    return taken ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore)
+{
+    pthread_mutex_lock(&semaphore->lock);
+    const bool given = semaphore->count == 0;
+    semaphore->count = 1;
+    pthread_cond_signal(&semaphore->wake);
+    pthread_mutex_unlock(&semaphore->lock);
+    return given ? pdTRUE : pdFALSE;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore)
+{
+    if (semaphore == nullptr)
+        return;
+    destroySync(semaphore->lock, semaphore->wake);
+    delete semaphore;
+}
@@ -0,0 +1,198 @@
+/*
+Purpose: Host implementation of the Adafruit_GFX subset and the HUB75 panel stand-in.
+Responsibilities:
+- Classic 5x7 text (6x8 cell) drawn pixel by pixel, as Adafruit_GFX::write does.
+- GFXcanvas1 1bpp buffer for TextStrip.
+- RGB565 framebuffer panel with optional double buffering and a pixel-write counter.
+*/
+#include <Adafruit_GFX.h>
+#include <ESP32-HUB75-MatrixPanel-I2S-DMA.h>
+
+namespace
+{
+    // Printable ASCII of the classic 5x7 font, one byte per column, bit 0 = top row.
+    const uint8_t kFont5x7[][5] = {
+        {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00}, {0x00, 0x07, 0x00, 0x07, 0x00},
+        {0x14, 0x7F, 0x14, 0x7F, 0x14}, {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62},
+        {0x36, 0x49, 0x56, 0x20, 0x50}, {0x00, 0x08, 0x07, 0x03, 0x00}, {0x00, 0x1C, 0x22, 0x41, 0x00},
+        {0x00, 0x41, 0x22, 0x1C, 0x00}, {0x2A, 0x1C, 0x7F, 0x1C, 0x2A}, {0x08, 0x08, 0x3E, 0x08, 0x08},
+        {0x00, 0x80, 0x70, 0x30, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, {0x00, 0x00, 0x60, 0x60, 0x00},
+        {0x20, 0x10, 0x08, 0x04, 0x02}, {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00},
+        {0x72, 0x49, 0x49, 0x49, 0x46}, {0x21, 0x41, 0x49, 0x4D, 0x33}, {0x18, 0x14, 0x12, 0x7F, 0x10},
+        {0x27, 0x45, 0x45, 0x45, 0x39}, {0x3C, 0x4A, 0x49, 0x49, 0x31}, {0x41, 0x21, 0x11, 0x09, 0x07},
+        {0x36, 0x49, 0x49, 0x49, 0x36}, {0x46, 0x49, 0x49, 0x29, 0x1E}, {0x00, 0x00, 0x14, 0x00, 0x00},
+        {0x00, 0x40, 0x34, 0x00, 0x00}, {0x00, 0x08, 0x14, 0x22, 0x41}, {0x14, 0x14, 0x14, 0x14, 0x14},
+        {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x59, 0x09, 0x06}, {0x3E, 0x41, 0x5D, 0x59, 0x4E},
+        {0x7C, 0x12, 0x11, 0x12, 0x7C}, {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},
+        {0x7F, 0x41, 0x41, 0x41, 0x3E}, {0x7F, 0x49, 0x49, 0x49, 0x41}, {0x7F, 0x09, 0x09, 0x09, 0x01},
+        {0x3E, 0x41, 0x41, 0x51, 0x73}, {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00},
+        {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41}, {0x7F, 0x40, 0x40, 0x40, 0x40},
+        {0x7F, 0x02, 0x1C, 0x02, 0x7F}, {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},
+        {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E}, {0x7F, 0x09, 0x19, 0x29, 0x46},
+        {0x26, 0x49, 0x49, 0x49, 0x32}, {0x03, 0x01, 0x7F, 0x01, 0x03}, {0x3F, 0x40, 0x40, 0x40, 0x3F},
+        {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x3F, 0x40, 0x38, 0x40, 0x3F}, {0x63, 0x14, 0x08, 0x14, 0x63},
+        {0x03, 0x04, 0x78, 0x04, 0x03}, {0x61, 0x59, 0x49, 0x4D, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x41},
+        {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x41, 0x7F}, {0x04, 0x02, 0x01, 0x02, 0x04},
+        {0x40, 0x40, 0x40, 0x40, 0x40}, {0x00, 0x03, 0x07, 0x08, 0x00}, {0x20, 0x54, 0x54, 0x78, 0x40},
+        {0x7F, 0x28, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x28}, {0x38, 0x44, 0x44, 0x28, 0x7F},
+        {0x38, 0x54, 0x54, 0x54, 0x18}, {0x00, 0x08, 0x7E, 0x09, 0x02}, {0x18, 0xA4, 0xA4, 0x9C, 0x78},
+        {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00}, {0x20, 0x40, 0x40, 0x3D, 0x00},
+        {0x7F, 0x10, 0x28, 0x44, 0x00}, {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x78, 0x04, 0x78},
+        {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38}, {0xFC, 0x18, 0x24, 0x24, 0x18},
+        {0x18, 0x24, 0x24, 0x18, 0xFC}, {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x24},
+        {0x04, 0x04, 0x3F, 0x44, 0x24}, {0x3C, 0x40, 0x40, 0x20, 0x7C}, {0x1C, 0x20, 0x40, 0x20, 0x1C},
+        {0x3C, 0x40, 0x30, 0x40, 0x3C}, {0x44, 0x28, 0x10, 0x28, 0x44}, {0x4C, 0x90, 0x90, 0x90, 0x7C},
+        {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00}, {0x00, 0x00, 0x77, 0x00, 0x00},
+        {0x00, 0x41, 0x36, 0x08, 0x00}, {0x02, 0x01, 0x02, 0x04, 0x02},
+    };
+
+    static_assert(sizeof(kFont5x7) / sizeof(kFont5x7[0]) == 0x7F - 0x20, "one glyph per printable character");
+
+    MatrixPanel_I2S_DMA *g_lastPanel = nullptr;
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    for (int16_t i = 0; i < w; ++i)
+        drawPixel(x + i, y, color);
+}
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    for (int16_t i = 0; i < h; ++i)
+        drawPixel(x, y + i, color);
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    for (int16_t row = 0; row < h; ++row)
+        drawFastHLine(x, y + row, w, color);
+}
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size)
+{
+    if (c < 0x20 || c > 0x7E)
+        c = '?';
+    const uint8_t *glyph = kFont5x7[c - 0x20];
+    for (int8_t col = 0; col < 6; ++col)
+    {
+        const uint8_t bits = col < 5 ? glyph[col] : 0;
+        for (int8_t row = 0; row < 8; ++row)
+        {
+            const bool lit = bits & (1 << row);
+            if (!lit && bg == color)
+                continue; // transparent background
+            const uint16_t c565 = lit ? color : bg;
+            if (size == 1)
+                drawPixel(x + col, y + row, c565);
+            else
+                fillRect(x + col * size, y + row * size, size, size, c565);
+        }
+    }
+}
+
+size_t Adafruit_GFX::write(uint8_t c)
+{
+    if (c == '\n')
+    {
+        _cursorX = 0;
+        _cursorY += 8 * _textSize;
+        return 1;
+    }
+    if (c == '\r')
+        return 1;
+    if (_wrap && _cursorX + 6 * _textSize > _width)
+    {
+        _cursorX = 0;
+        _cursorY += 8 * _textSize;
+    }
+    drawChar(_cursorX, _cursorY, c, _textColor, _textBg, _textSize);
+    _cursorX += 6 * _textSize;
+    return 1;
+}
+
+void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    if (x < 0 || y < 0 || x >= _width || y >= _height)
+        return;
+    uint8_t &byte = _buffer[(size_t)(x / 8) + (size_t)y * ((_width + 7) / 8)];
+    if (color)
+        byte |= (uint8_t)(0x80 >> (x & 7));
+    else
+        byte &= (uint8_t)~(0x80 >> (x & 7));
+}
+
+void GFXcanvas1::fillScreen(uint16_t color)
+{
+    std::fill(_buffer.begin(), _buffer.end(), color ? 0xFF : 0x00);
+}
+
+bool GFXcanvas1::getPixel(int16_t x, int16_t y) const
+{
+    if (x < 0 || y < 0 || x >= _width || y >= _height)
+        return false;
+    return _buffer[(size_t)(x / 8) + (size_t)y * ((_width + 7) / 8)] & (0x80 >> (x & 7));
+}
+
+MatrixPanel_I2S_DMA::MatrixPanel_I2S_DMA(const HUB75_I2S_CFG &cfg)
+    : Adafruit_GFX((int16_t)(cfg.mx_width * cfg.chain_length), (int16_t)cfg.mx_height),
+      _doubleBuffered(cfg.double_buff)
+{
+    const size_t pixels = (size_t)_width * _height;
+    _buffers[0].assign(pixels, 0);
+    if (_doubleBuffered)
+        _buffers[1].assign(pixels, 0);
+    _back = _doubleBuffered ? 1 : 0;
+    g_lastPanel = this;
+}
+
+MatrixPanel_I2S_DMA::~MatrixPanel_I2S_DMA()
+{
+    if (g_lastPanel == this)
+        g_lastPanel = nullptr;
+}
+
+void MatrixPanel_I2S_DMA::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    if (x < 0 || y < 0 || x >= _width || y >= _height)
+        return;
+    _buffers[_back][(size_t)y * _width + x] = color;
+    _pixelWrites++;
+}
+
+void MatrixPanel_I2S_DMA::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    if (y < 0 || y >= _height)
+        return;
+    int16_t x1 = x + w;
+    if (x < 0) x = 0;
+    if (x1 > _width) x1 = _width;
+    if (x1 <= x)
+        return;
+    uint16_t *row = _buffers[_back].data() + (size_t)y * _width;
+    std::fill(row + x, row + x1, color);
+    _pixelWrites += (uint32_t)(x1 - x);
+}
+
+void MatrixPanel_I2S_DMA::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    for (int16_t row = 0; row < h; ++row)
+        drawFastHLine(x, y + row, w, color);
+}
+
+void MatrixPanel_I2S_DMA::flipDMABuffer()
+{
+    _flips++;
+    if (_doubleBuffered)
+        _back ^= 1;
+}
+
+MatrixPanel_I2S_DMA *MatrixPanel_I2S_DMA::hostInstance()
+{
+    return g_lastPanel;
+}
+
+const uint16_t *MatrixPanel_I2S_DMA::hostFrontBuffer() const
+{
+    return _buffers[_doubleBuffered ? (_back ^ 1) : 0].data();
+}
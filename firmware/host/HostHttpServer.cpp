@@ -0,0 +1,201 @@
+/*
+Purpose: Local fault-injecting HTTP server for the host network tests.
+Responsibilities:
+- Accept connections on 127.0.0.1 and parse each request's line, headers and body.
+- Answer from a script: plain replies, throttling headers, dropped connections,
+  truncated bodies, and bodies trickled out in delayed chunks.
+- Record requests so tests can assert on what the firmware actually sent.
+*/
+#include "host/HostHttpServer.h"
+#include <arpa/inet.h>
+#include <chrono>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+    void sendAll(int fd, const char *data, size_t length)
+    {
+        while (length > 0)
+        {
+            const ssize_t n = send(fd, data, length, MSG_NOSIGNAL);
+            if (n <= 0)
+                return;
+            data += n;
+            length -= (size_t)n;
+        }
+    }
+
+    const char *reason(int status)
+    {
+        switch (status)
+        {
+        case 200: return "OK";
+        case 401: return "Unauthorized";
+        case 404: return "Not Found";
+        case 429: return "Too Many Requests";
+        case 503: return "Service Unavailable";
+        default: return status >= 500 ? "Server Error" : "Status";
+        }
+    }
+}
+
+bool HostHttpServer::start()
+{
+    m_listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (m_listenFd < 0)
+        return false;
+    const int one = 1;
+    setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (bind(m_listenFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+        listen(m_listenFd, 8) != 0 ||
+        getsockname(m_listenFd, reinterpret_cast<sockaddr *>(&address), &length) != 0)
+    {
+        close(m_listenFd);
+        m_listenFd = -1;
+        return false;
+    }
+    m_port = ntohs(address.sin_port);
+    m_stop = false;
+    m_thread = std::thread(&HostHttpServer::serve, this);
+    return true;
+}
+
+void HostHttpServer::stop()
+{
+    if (m_listenFd < 0)
+        return;
+    m_stop = true;
+    m_thread.join();
+    close(m_listenFd);
+    m_listenFd = -1;
+}
+
+void HostHttpServer::push(Reply reply)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_script.push_back(std::move(reply));
+}
+
+std::vector<HostHttpServer::Received> HostHttpServer::received()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    return m_received;
+}
+
+size_t HostHttpServer::requestCount()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    return m_received.size();
+}
+
+void HostHttpServer::serve()
+{
+    while (!m_stop)
+    {
+        pollfd entry = {m_listenFd, POLLIN, 0};
+        if (poll(&entry, 1, 20) <= 0)
+            continue;
+        const int fd = accept(m_listenFd, nullptr, nullptr);
+        if (fd < 0)
+            continue;
+        answer(fd);
+        close(fd);
+    }
+}
+
+void HostHttpServer::answer(int fd)
+{
+    // Head: everything up to the blank line; the body follows per Content-Length.
+    std::string data;
+    size_t headEnd;
+    char buffer[1024];
+    while ((headEnd = data.find("\r\n\r\n")) == std::string::npos)
+    {
+        pollfd entry = {fd, POLLIN, 0};
+        if (poll(&entry, 1, 2000) <= 0)
+            return;
+        const ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0)
+            return;
+        data.append(buffer, (size_t)n);
+    }
+
+    Received request;
+    const std::string head = data.substr(0, headEnd);
+    size_t lineEnd = head.find("\r\n");
+    const std::string requestLine = head.substr(0, lineEnd);
+    const size_t space = requestLine.find(' ');
+    request.method = requestLine.substr(0, space);
+    request.path = requestLine.substr(space + 1, requestLine.rfind(' ') - space - 1);
+    while (lineEnd != std::string::npos)
+    {
+        const size_t next = head.find("\r\n", lineEnd + 2);
+        const std::string line = head.substr(lineEnd + 2, next == std::string::npos ? std::string::npos : next - lineEnd - 2);
+        const size_t colon = line.find(':');
+        if (colon != std::string::npos)
+        {
+            std::string name = line.substr(0, colon);
+            for (char &c : name)
+                c = (char)tolower((unsigned char)c);
+            const size_t valueStart = line.find_first_not_of(' ', colon + 1);
+            request.headers[name] = valueStart == std::string::npos ? "" : line.substr(valueStart);
+        }
+        lineEnd = next;
+    }
+    const size_t expected = request.headers.count("content-length") ? strtoul(request.headers["content-length"].c_str(), nullptr, 10) : 0;
+    request.body = data.substr(headEnd + 4);
+    while (request.body.size() < expected)
+    {
+        const ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0)
+            break;
+        request.body.append(buffer, (size_t)n);
+    }
+
+    Reply reply;
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_received.push_back(request);
+        if (m_script.empty())
+        {
+            reply.status = 500;
+            reply.body = "unscripted request";
+        }
+        else
+        {
+            reply = std::move(m_script.front());
+            m_script.pop_front();
+        }
+    }
+    if (reply.onRequest)
+        reply.onRequest();
+    if (reply.mode == Reply::Mode::Close)
+        return;
+
+    char statusLine[128];
+    snprintf(statusLine, sizeof(statusLine), "HTTP/1.0 %d %s\r\nContent-Length: %zu\r\n",
+             reply.status, reason(reply.status), reply.body.size());
+    const std::string response = std::string(statusLine) + reply.headers + "\r\n";
+    sendAll(fd, response.data(), response.size());
+
+    const size_t bodyBytes = reply.mode == Reply::Mode::Truncate ? reply.body.size() / 2 : reply.body.size();
+    const size_t piece = reply.chunkBytes ? reply.chunkBytes : (bodyBytes ? bodyBytes : 1);
+    for (size_t sent = 0; sent < bodyBytes && !m_stop; sent += piece)
+    {
+        if (reply.chunkDelayMs)
+            std::this_thread::sleep_for(std::chrono::milliseconds(reply.chunkDelayMs));
+        sendAll(fd, reply.body.data() + sent, std::min(piece, bodyBytes - sent));
+    }
+    shutdown(fd, SHUT_WR);
+}
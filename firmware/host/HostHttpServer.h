@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Scripted HTTP/1.0 server on 127.0.0.1 for the network host tests. Each connection is
+// answered with the next scripted reply (500 once the script runs out) and then closed;
+// every request is recorded. Pair with hostNetRedirect(port()) so the firmware's
+// fetchers reach it under their real host names.
+class HostHttpServer
+{
+public:
+    struct Reply
+    {
+        enum class Mode
+        {
+            Respond,  // status, headers and the whole body
+            Close,    // close the connection without answering
+            Truncate  // announce the whole body, send half of it, close
+        };
+
+        int status = 200;
+        std::string headers; // extra header lines, each ending in "\r\n"
+        std::string body;
+        Mode mode = Mode::Respond;
+        size_t chunkBytes = 0;     // > 0: write the body in pieces of this size...
+        unsigned chunkDelayMs = 0; // ...pausing this long before each (a slow link)
+        std::function<void()> onRequest; // runs on the server thread before replying
+    };
+
+    struct Received
+    {
+        std::string method;
+        std::string path;
+        std::map<std::string, std::string> headers; // names lower-cased
+        std::string body;
+    };
+
+    ~HostHttpServer() { stop(); }
+
+    // Binds an ephemeral port and starts serving.
+    bool start();
+    void stop();
+    uint16_t port() const { return m_port; }
+
+    void push(Reply reply);
+    std::vector<Received> received();
+    size_t requestCount();
+
+private:
+    void serve();
+    void answer(int fd);
+
+    int m_listenFd = -1;
+    uint16_t m_port = 0;
+    std::atomic<bool> m_stop{false};
+    std::thread m_thread;
+    std::mutex m_lock;
+    std::deque<Reply> m_script;
+    std::vector<Received> m_received;
+};
@@ -0,0 +1,303 @@
+/*
+Purpose: Host (Linux) implementation of the network pieces the fetch path uses.
+Responsibilities:
+- WiFiClient over a blocking POSIX socket with poll()-based read timeouts.
+- WiFi.hostByName() through the system resolver, or 127.0.0.1 while redirected.
+- A minimal HTTP/1.0 HTTPClient: request line and headers out, status and the collected
+  headers in, body left on the client.
+- hostNetRedirect() so tests point every outbound connection at a local server.
+*/
+#include <WiFi.h>
+#include <HTTPClient.h>
+#include <arpa/inet.h>
+#include <chrono>
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+WiFiClass WiFi;
+
+namespace
+{
+    uint16_t g_redirectPort = 0;
+
+    unsigned long steadyMs()
+    {
+        return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+}
+
+void hostNetRedirect(uint16_t port)
+{
+    g_redirectPort = port;
+}
+
+int WiFiClass::hostByName(const char *host, IPAddress &result)
+{
+    if (g_redirectPort != 0)
+    {
+        result = IPAddress(127, 0, 0, 1);
+        return 1;
+    }
+    addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    addrinfo *found = nullptr;
+    if (getaddrinfo(host, nullptr, &hints, &found) != 0 || found == nullptr)
+        return 0;
+    result = IPAddress((uint32_t)reinterpret_cast<sockaddr_in *>(found->ai_addr)->sin_addr.s_addr);
+    freeaddrinfo(found);
+    return 1;
+}
+
+WiFiClient::~WiFiClient()
+{
+    stop();
+}
+
+int WiFiClient::connect(IPAddress ip, uint16_t port)
+{
+    stop();
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = g_redirectPort ? htonl(INADDR_LOOPBACK) : (uint32_t)ip;
+    address.sin_port = htons(g_redirectPort ? g_redirectPort : port);
+
+    m_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (m_fd < 0)
+        return 0;
+    if (::connect(m_fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+    {
+        stop();
+        return 0;
+    }
+    const int one = 1;
+    setsockopt(m_fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return 1;
+}
+
+int WiFiClient::connect(const char *host, uint16_t port)
+{
+    IPAddress ip;
+    if (WiFi.hostByName(host, ip) != 1)
+        return 0;
+    return connect(ip, port);
+}
+
+size_t WiFiClient::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t WiFiClient::write(const uint8_t *buffer, size_t size)
+{
+    size_t sent = 0;
+    while (m_fd >= 0 && sent < size)
+    {
+        const ssize_t n = send(m_fd, buffer + sent, size - sent, MSG_NOSIGNAL);
+        if (n <= 0)
+            break;
+        sent += (size_t)n;
+    }
+    return sent;
+}
+
+int WiFiClient::available()
+{
+    int count = 0;
+    if (m_fd < 0 || ioctl(m_fd, FIONREAD, &count) != 0)
+        return 0;
+    return count;
+}
+
+int WiFiClient::read()
+{
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int WiFiClient::read(uint8_t *buffer, size_t size)
+{
+    if (m_fd < 0)
+        return -1;
+    const ssize_t n = recv(m_fd, buffer, size, MSG_DONTWAIT);
+    return n > 0 ? (int)n : -1;
+}
+
+int WiFiClient::peek()
+{
+    uint8_t c;
+    if (m_fd < 0 || recv(m_fd, &c, 1, MSG_PEEK | MSG_DONTWAIT) != 1)
+        return -1;
+    return c;
+}
+
+bool WiFiClient::waitReadable(unsigned long timeoutMs)
+{
+    pollfd entry = {m_fd, POLLIN, 0};
+    return poll(&entry, 1, (int)timeoutMs) > 0;
+}
+
+size_t WiFiClient::readBytes(char *buffer, size_t length)
+{
+    const unsigned long start = steadyMs();
+    size_t count = 0;
+    while (m_fd >= 0 && count < length)
+    {
+        const unsigned long elapsed = steadyMs() - start;
+        if (elapsed >= m_timeoutMs || !waitReadable(m_timeoutMs - elapsed))
+            break;
+        const ssize_t n = recv(m_fd, buffer + count, length - count, 0);
+        if (n <= 0)
+            break; // peer closed
+        count += (size_t)n;
+    }
+    return count;
+}
+
+void WiFiClient::stop()
+{
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+        m_fd = -1;
+    }
+}
+
+uint8_t WiFiClient::connected()
+{
+    if (m_fd < 0)
+        return 0;
+    uint8_t c;
+    const ssize_t n = recv(m_fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (n > 0)
+        return 1;
+    return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) ? 1 : 0;
+}
+
+bool HTTPClient::begin(WiFiClient &client, const String &url)
+{
+    const int scheme = url.indexOf("://");
+    if (scheme < 0)
+        return false;
+    const bool https = url.substring(0, scheme).equalsIgnoreCase("https");
+    const unsigned hostStart = (unsigned)scheme + 3;
+    int pathStart = url.indexOf('/', hostStart);
+    if (pathStart < 0)
+        pathStart = (int)url.length();
+
+    String authority = url.substring(hostStart, (unsigned)pathStart);
+    const int colon = authority.indexOf(':');
+    m_port = https ? 443 : 80;
+    if (colon >= 0)
+    {
+        m_port = (uint16_t)authority.substring((unsigned)colon + 1).toInt();
+        authority = authority.substring(0, (unsigned)colon);
+    }
+    m_host = authority;
+    m_path = pathStart < (int)url.length() ? url.substring((unsigned)pathStart) : String("/");
+    m_client = &client;
+    m_requestHeaders = String();
+    m_collected.clear();
+    m_size = -1;
+    return true;
+}
+
+void HTTPClient::end()
+{
+    if (m_client && !m_reuse)
+        m_client->stop();
+}
+
+void HTTPClient::collectHeaders(const char *names[], size_t count)
+{
+    m_collected.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+        String name(names[i]);
+        name.toLowerCase();
+        m_collected[name] = String();
+    }
+}
+
+void HTTPClient::addHeader(const String &name, const String &value)
+{
+    m_requestHeaders += name + ": " + value + "\r\n";
+}
+
+String HTTPClient::header(const char *name)
+{
+    String key(name);
+    key.toLowerCase();
+    auto it = m_collected.find(key);
+    return it == m_collected.end() ? String() : it->second;
+}
+
+// 1: a line was read (without CRLF); 0: the peer closed; -1: timed out.
+int HTTPClient::readLine(String &line)
+{
+    line = String();
+    for (;;)
+    {
+        char c;
+        if (m_client->readBytes(&c, 1) != 1)
+            return m_client->connected() ? -1 : 0;
+        if (c == '\n')
+            break;
+        if (c != '\r')
+            line += c;
+    }
+    return 1;
+}
+
+int HTTPClient::sendRequest(const char *method, uint8_t *payload, size_t size)
+{
+    if (m_client == nullptr)
+        return HTTPC_ERROR_NOT_CONNECTED;
+    if (!m_client->connected() && !m_client->connect(m_host.c_str(), m_port))
+        return HTTPC_ERROR_CONNECTION_REFUSED;
+
+    String head = String(method) + " " + m_path + " HTTP/1.0\r\nHost: " + m_host +
+                  "\r\nUser-Agent: ESP32HTTPClient\r\nConnection: close\r\n" + m_requestHeaders;
+    if (payload && size)
+        head += String("Content-Length: ") + String((unsigned long)size) + "\r\n";
+    head += "\r\n";
+    if (m_client->write((const uint8_t *)head.c_str(), head.length()) != head.length())
+        return HTTPC_ERROR_SEND_HEADER_FAILED;
+    if (payload && size && m_client->write(payload, size) != size)
+        return HTTPC_ERROR_SEND_PAYLOAD_FAILED;
+
+    m_client->setTimeout(m_timeoutMs);
+    String line;
+    int status = readLine(line);
+    if (status <= 0)
+        return status == 0 ? HTTPC_ERROR_CONNECTION_LOST : HTTPC_ERROR_READ_TIMEOUT;
+    if (!line.startsWith("HTTP/1.") || line.length() < 12)
+        return HTTPC_ERROR_NO_HTTP_SERVER;
+    const int code = (int)line.substring(9, 12).toInt();
+
+    while ((status = readLine(line)) == 1 && line.length() > 0)
+    {
+        const int colon = line.indexOf(':');
+        if (colon <= 0)
+            continue;
+        String name = line.substring(0, (unsigned)colon);
+        String value = line.substring((unsigned)colon + 1);
+        name.toLowerCase();
+        value.trim();
+        if (name == "content-length")
+            m_size = (int)value.toInt();
+        auto it = m_collected.find(name);
+        if (it != m_collected.end())
+            it->second = value;
+    }
+    if (status <= 0)
+        return status == 0 ? HTTPC_ERROR_CONNECTION_LOST : HTTPC_ERROR_READ_TIMEOUT;
+    return code;
+}
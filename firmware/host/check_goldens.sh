@@ -0,0 +1,36 @@
+#!/bin/sh
+# Render the host scenario in every display mode and compare it with the committed goldens
+# in host/golden/<mode>; exits non-zero when any sampled frame differs by a pixel.
+#   host/check_goldens.sh [program]           check (default .pio/build/host/program)
+#   host/check_goldens.sh --record [program]  re-record after an intended rendering change
+set -e
+cd "$(dirname "$0")/.."
+
+record=0
+if [ "$1" = "--record" ]; then
+    record=1
+    shift
+fi
+program=${1:-.pio/build/host/program}
+args="--frames 800 --step-ms 25 --every 20"
+
+status=0
+for entry in 0:cards 1:radar 2:list; do
+    mode=${entry%%:*}
+    dir=host/golden/${entry#*:}
+    if [ $record = 1 ]; then
+        rm -rf "$dir"
+        mkdir -p "$dir"
+        "$program" $args --mode "$mode" --out "$dir" > /dev/null
+        echo "recorded $dir"
+    else
+        if out=$("$program" $args --mode "$mode" --golden "$dir" 2>&1); then
+            echo "$dir: $(echo "$out" | grep '^golden:')"
+        else
+            echo "$dir: FAILED"
+            echo "$out" | grep -E '^(host|golden):'
+            status=1
+        fi
+    fi
+done
+exit $status
@@ -0,0 +1,57 @@
+#pragma once
+
+// Host stand-in for the slice of Adafruit_GFX the firmware uses: pixel, line and rect
+// fills, the classic 6x8 text cursor, and GFXcanvas1 (1bpp, MSB first, byte-padded rows,
+// the same layout TextStrip copies out of it).
+
+#include <Arduino.h>
+#include <vector>
+
+class Adafruit_GFX : public Print
+{
+public:
+    Adafruit_GFX(int16_t w, int16_t h) : _width(w), _height(h) {}
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    virtual void fillScreen(uint16_t color) { fillRect(0, 0, _width, _height, color); }
+
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size);
+    void setCursor(int16_t x, int16_t y) { _cursorX = x; _cursorY = y; }
+    void setTextColor(uint16_t c) { _textColor = _textBg = c; }
+    void setTextColor(uint16_t c, uint16_t bg) { _textColor = c; _textBg = bg; }
+    void setTextWrap(bool wrap) { _wrap = wrap; }
+    void setTextSize(uint8_t size) { _textSize = size > 0 ? size : 1; }
+    size_t write(uint8_t c) override;
+    using Print::write;
+
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+
+protected:
+    int16_t _width;
+    int16_t _height;
+    int16_t _cursorX = 0;
+    int16_t _cursorY = 0;
+    uint16_t _textColor = 0xFFFF;
+    uint16_t _textBg = 0xFFFF;
+    uint8_t _textSize = 1;
+    bool _wrap = true;
+};
+
+class GFXcanvas1 : public Adafruit_GFX
+{
+public:
+    GFXcanvas1(uint16_t w, uint16_t h)
+        : Adafruit_GFX((int16_t)w, (int16_t)h), _buffer((size_t)((w + 7) / 8) * h, 0) {}
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void fillScreen(uint16_t color) override;
+    bool getPixel(int16_t x, int16_t y) const;
+    uint8_t *getBuffer() { return _buffer.empty() ? nullptr : _buffer.data(); }
+
+private:
+    std::vector<uint8_t> _buffer;
+};
@@ -0,0 +1,251 @@
+#pragma once
+
+// Host (Linux) stand-in for the parts of the Arduino core the display code uses.
+// millis() runs on a virtual clock the host runner advances, so marquees and card
+// cycling are reproducible frame for frame; micros() is the real monotonic clock and
+// only feeds timing statistics. Network tests switch millis() to the real clock so
+// socket and task timeouts elapse.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <strings.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <math.h>
+#include <ctype.h>
+#include <time.h>
+#include <string>
+#include <algorithm>
+
+using std::isnan;
+
+#define PROGMEM
+#define IRAM_ATTR
+#define RTC_DATA_ATTR
+#define F(x) (x)
+
+inline uint8_t pgm_read_byte(const void *p) { return *(const uint8_t *)p; }
+inline uint16_t pgm_read_word(const void *p) { uint16_t v; memcpy(&v, p, sizeof(v)); return v; }
+inline uint32_t pgm_read_dword(const void *p) { uint32_t v; memcpy(&v, p, sizeof(v)); return v; }
+inline const void *pgm_read_ptr(const void *p) { const void *v; memcpy(&v, p, sizeof(v)); return v; }
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+inline void yield() {}
+
+// Host runner controls for the virtual millis() clock.
+void hostSetMillis(unsigned long ms);
+void hostAdvanceMillis(unsigned long ms);
+// true: millis() and delay() follow the real monotonic clock; false: the virtual one.
+void hostUseRealMillis(bool real);
+
+// Deterministic sequence (fixed seed) so jittered backoff is reproducible in tests.
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+
+// Local time derived from the virtual clock (fixed epoch), so clock screens are stable.
+bool getLocalTime(struct tm *info, uint32_t ms = 5000);
+
+template <class T>
+T constrain(T x, T lo, T hi) { return x < lo ? lo : (x > hi ? hi : x); }
+
+class String
+{
+public:
+    String() {}
+    String(const char *c) : m_s(c ? c : "") {}
+    String(const std::string &s) : m_s(s) {}
+    explicit String(char c) : m_s(1, c) {}
+    explicit String(int v) : m_s(std::to_string(v)) {}
+    explicit String(unsigned v) : m_s(std::to_string(v)) {}
+    explicit String(long v) : m_s(std::to_string(v)) {}
+    explicit String(unsigned long v) : m_s(std::to_string(v)) {}
+    explicit String(long long v) : m_s(std::to_string(v)) {}
+    explicit String(unsigned long long v) : m_s(std::to_string(v)) {}
+    explicit String(double v, unsigned char decimals = 2)
+    {
+        char buf[48];
+        snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+        m_s = buf;
+    }
+    explicit String(float v, unsigned char decimals = 2) : String((double)v, decimals) {}
+
+    unsigned int length() const { return (unsigned int)m_s.size(); }
+    bool isEmpty() const { return m_s.empty(); }
+    const char *c_str() const { return m_s.c_str(); }
+    const std::string &str() const { return m_s; }
+
+    char operator[](unsigned int i) const { return i < m_s.size() ? m_s[i] : 0; }
+    char &operator[](unsigned int i) { return m_s[i]; }
+    char charAt(unsigned int i) const { return (*this)[i]; }
+
+    String &operator+=(const String &o) { m_s += o.m_s; return *this; }
+    String &operator+=(const char *o) { m_s += o ? o : ""; return *this; }
+    String &operator+=(char c) { m_s += c; return *this; }
+    String &operator+=(int v) { m_s += std::to_string(v); return *this; }
+    String &operator+=(unsigned v) { m_s += std::to_string(v); return *this; }
+    String &operator+=(long v) { m_s += std::to_string(v); return *this; }
+    String &operator+=(unsigned long v) { m_s += std::to_string(v); return *this; }
+    bool concat(const String &o) { m_s += o.m_s; return true; }
+    bool concat(const char *c) { m_s += c ? c : ""; return true; }
+    bool concat(const char *c, unsigned int n) { m_s.append(c, n); return true; }
+    bool concat(char c) { m_s += c; return true; }
+
+    bool operator==(const String &o) const { return m_s == o.m_s; }
+    bool operator!=(const String &o) const { return m_s != o.m_s; }
+    bool operator==(const char *o) const { return m_s == (o ? o : ""); }
+    bool operator!=(const char *o) const { return !(*this == o); }
+    bool operator<(const String &o) const { return m_s < o.m_s; }
+    bool equals(const String &o) const { return m_s == o.m_s; }
+    bool equalsIgnoreCase(const String &o) const { return strcasecmp(m_s.c_str(), o.m_s.c_str()) == 0; }
+
+    int indexOf(char c, unsigned int from = 0) const { return pos(m_s.find(c, from)); }
+    int indexOf(const String &o, unsigned int from = 0) const { return pos(m_s.find(o.m_s, from)); }
+    int lastIndexOf(char c) const { return pos(m_s.rfind(c)); }
+    int lastIndexOf(const String &o) const { return pos(m_s.rfind(o.m_s)); }
+    bool startsWith(const String &o) const { return m_s.compare(0, o.m_s.size(), o.m_s) == 0; }
+    bool endsWith(const String &o) const
+    {
+        return m_s.size() >= o.m_s.size() &&
+               m_s.compare(m_s.size() - o.m_s.size(), o.m_s.size(), o.m_s) == 0;
+    }
+
+    String substring(unsigned int from) const { return from < m_s.size() ? String(m_s.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const
+    {
+        if (from > to)
+            std::swap(from, to);
+        if (from >= m_s.size())
+            return String();
+        return String(m_s.substr(from, to - from));
+    }
+
+    void trim()
+    {
+        size_t b = 0;
+        size_t e = m_s.size();
+        while (b < e && isspace((unsigned char)m_s[b])) ++b;
+        while (e > b && isspace((unsigned char)m_s[e - 1])) --e;
+        m_s = m_s.substr(b, e - b);
+    }
+    void toLowerCase() { for (auto &c : m_s) c = (char)tolower((unsigned char)c); }
+    void toUpperCase() { for (auto &c : m_s) c = (char)toupper((unsigned char)c); }
+    void replace(char from, char to) { std::replace(m_s.begin(), m_s.end(), from, to); }
+    void replace(const String &from, const String &to)
+    {
+        if (from.m_s.empty())
+            return;
+        size_t at = 0;
+        while ((at = m_s.find(from.m_s, at)) != std::string::npos)
+        {
+            m_s.replace(at, from.m_s.size(), to.m_s);
+            at += to.m_s.size();
+        }
+    }
+    void remove(unsigned int index) { if (index < m_s.size()) m_s.erase(index); }
+    void remove(unsigned int index, unsigned int count) { if (index < m_s.size()) m_s.erase(index, count); }
+    bool reserve(unsigned int n) { m_s.reserve(n); return true; }
+
+    long toInt() const { return atol(m_s.c_str()); }
+    float toFloat() const { return (float)atof(m_s.c_str()); }
+    double toDouble() const { return atof(m_s.c_str()); }
+    void toCharArray(char *buf, unsigned int n) const
+    {
+        if (n == 0)
+            return;
+        strncpy(buf, m_s.c_str(), n - 1);
+        buf[n - 1] = 0;
+    }
+
+private:
+    static int pos(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+    std::string m_s;
+};
+
+inline String operator+(const String &a, const String &b) { String r(a); r += b; return r; }
+inline String operator+(const String &a, const char *b) { String r(a); r += b; return r; }
+inline String operator+(const char *a, const String &b) { String r(a); r += b; return r; }
+inline String operator+(const String &a, char b) { String r(a); r += b; return r; }
+
+// The core's concatenation temporary; ArduinoJson names it when adapting String.
+class StringSumHelper : public String
+{
+public:
+    StringSumHelper(const String &s) : String(s) {}
+};
+
+class Print
+{
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buf, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+            write(buf[i]);
+        return n;
+    }
+    size_t write(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+    size_t print(const String &s) { return write((const uint8_t *)s.c_str(), s.length()); }
+    size_t print(const char *s) { return write(s); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int v) { return printf("%d", v); }
+    size_t print(unsigned v) { return printf("%u", v); }
+    size_t print(long v) { return printf("%ld", v); }
+    size_t print(unsigned long v) { return printf("%lu", v); }
+    size_t print(double v, int decimals = 2) { return printf("%.*f", decimals, v); }
+    size_t println() { return write((uint8_t)'\n'); }
+    template <typename T>
+    size_t println(const T &v) { return print(v) + println(); }
+    size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)))
+    {
+        char buf[512];
+        va_list args;
+        va_start(args, fmt);
+        const int n = vsnprintf(buf, sizeof(buf), fmt, args);
+        va_end(args);
+        if (n <= 0)
+            return 0;
+        return write((const uint8_t *)buf, std::min((size_t)n, sizeof(buf) - 1));
+    }
+};
+
+// Byte-stream reads; readBytes() blocks up to the timeout (real clock) like the core's.
+class Stream : public Print
+{
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    virtual void flush() {}
+
+    void setTimeout(unsigned long timeoutMs) { m_timeoutMs = timeoutMs; }
+    unsigned long getTimeout() const { return m_timeoutMs; }
+
+    virtual size_t readBytes(char *buffer, size_t length);
+    size_t readBytes(uint8_t *buffer, size_t length) { return readBytes((char *)buffer, length); }
+
+protected:
+    int timedRead();
+
+    unsigned long m_timeoutMs = 1000;
+};
+
+// Serial output goes to stderr so frame data on stdout stays clean.
+class HardwareSerial : public Print
+{
+public:
+    void begin(unsigned long) {}
+    size_t write(uint8_t c) override { return fputc(c, stderr) == EOF ? 0 : 1; }
+    size_t write(const uint8_t *buf, size_t n) override { return fwrite(buf, 1, n, stderr); }
+    using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+#include <IPAddress.h>
+#include <ESP.h>
@@ -0,0 +1,76 @@
+#pragma once
+
+// Host stand-in for the HUB75 DMA driver: the "DMA buffer" is an RGB565 framebuffer in
+// memory (two with double_buff, flipped by flipDMABuffer). Every pixel written is counted
+// so the host runner can report write cost per frame.
+
+#include <Adafruit_GFX.h>
+#include <vector>
+
+struct HUB75_I2S_CFG
+{
+    enum clk_speed
+    {
+        HZ_8M = 8000000,
+        HZ_10M = 10000000,
+        HZ_15M = 15000000,
+        HZ_20M = 20000000,
+    };
+    struct
+    {
+        int8_t e = -1;
+    } gpio;
+    uint16_t mx_width;
+    uint16_t mx_height;
+    uint16_t chain_length;
+    bool double_buff = false;
+    uint8_t latch_blanking = 1;
+    bool clkphase = true;
+    clk_speed i2sspeed = HZ_8M;
+    uint16_t min_refresh_rate = 60;
+
+    HUB75_I2S_CFG(uint16_t w = 64, uint16_t h = 32, uint16_t chain = 1)
+        : mx_width(w), mx_height(h), chain_length(chain) {}
+};
+
+class MatrixPanel_I2S_DMA : public Adafruit_GFX
+{
+public:
+    explicit MatrixPanel_I2S_DMA(const HUB75_I2S_CFG &cfg);
+    ~MatrixPanel_I2S_DMA();
+
+    bool begin() { return true; }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void fillScreen(uint16_t color) override { fillRect(0, 0, _width, _height, color); }
+    void drawPixelRGB888(int16_t x, int16_t y, uint8_t r, uint8_t g, uint8_t b) { drawPixel(x, y, color565(r, g, b)); }
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint8_t r, uint8_t g, uint8_t b) { drawFastHLine(x, y, w, color565(r, g, b)); }
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t r, uint8_t g, uint8_t b) { fillRect(x, y, w, h, color565(r, g, b)); }
+    void fillScreenRGB888(uint8_t r, uint8_t g, uint8_t b) { fillScreen(color565(r, g, b)); }
+    void clearScreen() { fillScreen(0); }
+
+    void setBrightness8(uint8_t brightness) { _brightness = brightness; }
+    void flipDMABuffer();
+
+    static uint16_t color565(uint8_t r, uint8_t g, uint8_t b)
+    {
+        return (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+    }
+
+    // Host-only inspection API.
+    static MatrixPanel_I2S_DMA *hostInstance();      // most recently constructed panel
+    const uint16_t *hostFrontBuffer() const;         // what the panel currently shows
+    uint8_t hostBrightness() const { return _brightness; }
+    uint32_t hostPixelWrites() const { return _pixelWrites; }
+    uint32_t hostFlips() const { return _flips; }
+
+private:
+    std::vector<uint16_t> _buffers[2];
+    uint8_t _back = 0;  // buffer drawn into
+    bool _doubleBuffered = false;
+    uint8_t _brightness = 128;
+    uint32_t _pixelWrites = 0;
+    uint32_t _flips = 0;
+};
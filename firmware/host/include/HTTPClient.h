@@ -0,0 +1,58 @@
+#pragma once
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+#include <map>
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED (-2)
+#define HTTPC_ERROR_SEND_PAYLOAD_FAILED (-3)
+#define HTTPC_ERROR_NOT_CONNECTED (-4)
+#define HTTPC_ERROR_CONNECTION_LOST (-5)
+#define HTTPC_ERROR_NO_STREAM (-6)
+#define HTTPC_ERROR_NO_HTTP_SERVER (-7)
+#define HTTPC_ERROR_TOO_LESS_RAM (-8)
+#define HTTPC_ERROR_ENCODING (-9)
+#define HTTPC_ERROR_STREAM_WRITE (-10)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+typedef enum
+{
+    HTTPC_DISABLE_FOLLOW_REDIRECTS,
+    HTTPC_STRICT_FOLLOW_REDIRECTS,
+    HTTPC_FORCE_FOLLOW_REDIRECTS
+} followRedirects_t;
+
+// The subset of the core's HTTPClient the fetchers use: one request per begin(), the
+// response head parsed in sendRequest(), and the body left on the client for the caller.
+// Redirects are not followed and chunked bodies are not decoded (requests are HTTP/1.0).
+class HTTPClient
+{
+public:
+    bool begin(WiFiClient &client, const String &url);
+    void end();
+    void useHTTP10(bool) {}
+    void setReuse(bool reuse) { m_reuse = reuse; }
+    void setTimeout(uint16_t timeoutMs) { m_timeoutMs = timeoutMs; }
+    void setFollowRedirects(followRedirects_t) {}
+    void collectHeaders(const char *names[], size_t count);
+    void addHeader(const String &name, const String &value);
+    int sendRequest(const char *method, uint8_t *payload = nullptr, size_t size = 0);
+    String header(const char *name);
+    int getSize() { return m_size; }
+    WiFiClient *getStreamPtr() { return m_client; }
+    WiFiClient &getStream() { return *m_client; }
+
+private:
+    int readLine(String &line);
+
+    WiFiClient *m_client = nullptr;
+    String m_host;
+    uint16_t m_port = 80;
+    String m_path;
+    String m_requestHeaders;
+    std::map<String, String> m_collected;
+    bool m_reuse = true;
+    uint16_t m_timeoutMs = 5000;
+    int m_size = -1;
+};
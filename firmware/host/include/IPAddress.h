@@ -0,0 +1,32 @@
+#pragma once
+
+// Host stand-in for the core's IPv4 address. The uint32_t form keeps the first octet in
+// the low byte, which on the little-endian host is network order, as on the ESP32.
+
+#include <Arduino.h>
+
+class IPAddress
+{
+public:
+    IPAddress() {}
+    IPAddress(uint32_t address) : m_address(address) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+        : m_address((uint32_t)a | ((uint32_t)b << 8) | ((uint32_t)c << 16) | ((uint32_t)d << 24))
+    {
+    }
+
+    operator uint32_t() const { return m_address; }
+    uint8_t operator[](int index) const { return (uint8_t)(m_address >> (8 * index)); }
+    bool operator==(const IPAddress &other) const { return m_address == other.m_address; }
+    bool operator!=(const IPAddress &other) const { return m_address != other.m_address; }
+
+    String toString() const
+    {
+        char text[16];
+        snprintf(text, sizeof(text), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+        return String(text);
+    }
+
+private:
+    uint32_t m_address = 0;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+// Host stand-in for the ESP32 NVS Preferences API: an in-memory store per namespace that
+// lives for the process, so RuntimeSettings starts from its compiled-in defaults.
+
+#include <Arduino.h>
+#include <map>
+
+class Preferences
+{
+public:
+    bool begin(const char *name, bool readOnly = false);
+    void end() { m_ns = nullptr; }
+    bool clear();
+
+    double getDouble(const char *key, double def = 0) { return get(key, def); }
+    size_t putDouble(const char *key, double v) { return put(key, v); }
+    uint32_t getUInt(const char *key, uint32_t def = 0) { return get(key, def); }
+    size_t putUInt(const char *key, uint32_t v) { return put(key, v); }
+    uint8_t getUChar(const char *key, uint8_t def = 0) { return get(key, def); }
+    size_t putUChar(const char *key, uint8_t v) { return put(key, v); }
+    bool getBool(const char *key, bool def = false) { return get(key, def); }
+    size_t putBool(const char *key, bool v) { return put(key, v); }
+    String getString(const char *key, String def = String());
+    size_t putString(const char *key, String v);
+
+    struct Namespace
+    {
+        std::map<std::string, double> numbers;
+        std::map<std::string, std::string> strings;
+    };
+
+private:
+
+    template <typename T>
+    T get(const char *key, T def) const
+    {
+        if (m_ns == nullptr)
+            return def;
+        auto it = m_ns->numbers.find(key);
+        return it == m_ns->numbers.end() ? def : (T)it->second;
+    }
+    template <typename T>
+    size_t put(const char *key, T v)
+    {
+        if (m_ns == nullptr || m_readOnly)
+            return 0;
+        m_ns->numbers[key] = (double)v;
+        return sizeof(T);
+    }
+
+    Namespace *m_ns = nullptr;
+    bool m_readOnly = false;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+
+typedef enum
+{
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+// The host is always "associated"; names resolve through the system resolver.
+class WiFiClass
+{
+public:
+    wl_status_t status() { return WL_CONNECTED; }
+    int hostByName(const char *host, IPAddress &result);
+};
+
+extern WiFiClass WiFi;
+
+// Host test hook: every outbound connection goes to 127.0.0.1:port instead, and every
+// name resolves to 127.0.0.1. Port 0 restores real addresses.
+void hostNetRedirect(uint16_t port);
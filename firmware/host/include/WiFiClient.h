@@ -0,0 +1,35 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Client.h>
+
+// Plain TCP over a POSIX socket. Reads block up to the Stream timeout on the real clock.
+// connected() stays true while unread data remains, as on the ESP32.
+class WiFiClient : public Client
+{
+public:
+    WiFiClient() = default;
+    ~WiFiClient() override;
+    WiFiClient(const WiFiClient &) = delete;
+    WiFiClient &operator=(const WiFiClient &) = delete;
+
+    int connect(IPAddress ip, uint16_t port) override;
+    int connect(const char *host, uint16_t port) override;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    int available() override;
+    int read() override;
+    int read(uint8_t *buffer, size_t size) override;
+    int peek() override;
+    size_t readBytes(char *buffer, size_t length) override;
+    void flush() override {}
+    void stop() override;
+    uint8_t connected() override;
+    operator bool() override { return connected(); }
+    using Print::write;
+
+private:
+    bool waitReadable(unsigned long timeoutMs);
+
+    int m_fd = -1;
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <WiFiClient.h>
+
+// TLS is not emulated: the host test servers speak plain HTTP on localhost, so the
+// certificate setters are recorded nowhere and connect() is a TCP connect.
+class WiFiClientSecure : public WiFiClient
+{
+public:
+    void setInsecure() {}
+    void setCACert(const char *) {}
+    using WiFiClient::connect;
+    int connect(IPAddress ip, uint16_t port, const char *, const char *, const char *, const char *)
+    {
+        return WiFiClient::connect(ip, port);
+    }
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+// Host (Linux) stand-in for the FreeRTOS pieces the network code uses: tasks are POSIX
+// threads, one tick is one millisecond, and task notifications and semaphores are
+// condition variables. Core pinning is recorded so xPortGetCoreID() answers consistently.
+
+#include <stdint.h>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdFAIL 0
+#define pdPASS 1
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFu)
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+#define PRO_CPU_NUM 0
+#define APP_CPU_NUM 1
+
+BaseType_t xPortGetCoreID();
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+struct HostTask;
+typedef HostTask *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t entry, const char *name, uint32_t stackBytes,
+                                   void *arg, UBaseType_t priority, TaskHandle_t *created,
+                                   BaseType_t core);
+// Deleting another task cancels its thread at its next blocking call and joins it.
+void vTaskDelete(TaskHandle_t task);
+// Only self-suspension (nullptr) is supported; the task then sleeps until deleted.
+void vTaskSuspend(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
@@ -0,0 +1,102 @@
+#pragma once
+
+// Host (Linux) stand-in for the ESP32 ROM's miniz inflater (tinfl), backed by the system
+// zlib. Same calls, flags and status codes; the zlib state and window live inside the
+// decompressor, so freeing it frees everything, as with tinfl. zlib never reads past
+// the end of the deflate data, so the bit buffer tinfl can leave trailer bytes in is
+// always empty here. Link with -lz.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <zlib.h>
+
+#define TINFL_LZ_DICT_SIZE 32768
+
+enum
+{
+    TINFL_FLAG_PARSE_ZLIB_HEADER = 1,
+    TINFL_FLAG_HAS_MORE_INPUT = 2,
+    TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF = 4,
+    TINFL_FLAG_COMPUTE_ADLER32 = 8
+};
+
+typedef enum
+{
+    TINFL_STATUS_BAD_PARAM = -3,
+    TINFL_STATUS_ADLER32_MISMATCH = -2,
+    TINFL_STATUS_FAILED = -1,
+    TINFL_STATUS_DONE = 0,
+    TINFL_STATUS_NEEDS_MORE_INPUT = 1,
+    TINFL_STATUS_HAS_MORE_OUTPUT = 2
+} tinfl_status;
+
+typedef uint32_t tinfl_bit_buf_t;
+
+struct tinfl_decompressor_tag
+{
+    uint32_t m_num_bits;
+    tinfl_bit_buf_t m_bit_buf;
+    int m_started;
+    z_stream m_stream;
+    size_t m_arenaUsed;
+    // inflate's state (~7 KB) and its 32 KB window.
+    alignas(16) unsigned char m_arena[48 * 1024];
+};
+typedef struct tinfl_decompressor_tag tinfl_decompressor;
+
+#define tinfl_init(r) \
+    do                \
+    {                 \
+        (r)->m_started = 0; \
+        (r)->m_num_bits = 0; \
+        (r)->m_bit_buf = 0; \
+    } while (0)
+
+inline voidpf tinflHostArenaAlloc(voidpf opaque, uInt items, uInt size)
+{
+    tinfl_decompressor *r = static_cast<tinfl_decompressor *>(opaque);
+    const size_t bytes = ((size_t)items * size + 15) & ~(size_t)15;
+    if (r->m_arenaUsed + bytes > sizeof(r->m_arena))
+        return Z_NULL;
+    voidpf p = r->m_arena + r->m_arenaUsed;
+    r->m_arenaUsed += bytes;
+    return p;
+}
+
+inline void tinflHostArenaFree(voidpf, voidpf) {}
+
+inline tinfl_status tinfl_decompress(tinfl_decompressor *r, const uint8_t *pIn_buf_next, size_t *pIn_buf_size,
+                                     uint8_t *, uint8_t *pOut_buf_next, size_t *pOut_buf_size,
+                                     uint32_t decomp_flags)
+{
+    if (!r->m_started)
+    {
+        memset(&r->m_stream, 0, sizeof(r->m_stream));
+        r->m_arenaUsed = 0;
+        r->m_stream.zalloc = tinflHostArenaAlloc;
+        r->m_stream.zfree = tinflHostArenaFree;
+        r->m_stream.opaque = r;
+        const int windowBits = (decomp_flags & TINFL_FLAG_PARSE_ZLIB_HEADER) ? 15 : -15;
+        if (inflateInit2(&r->m_stream, windowBits) != Z_OK)
+            return TINFL_STATUS_FAILED;
+        r->m_started = 1;
+    }
+
+    z_stream &s = r->m_stream;
+    s.next_in = const_cast<Bytef *>(pIn_buf_next);
+    s.avail_in = (uInt)*pIn_buf_size;
+    s.next_out = pOut_buf_next;
+    s.avail_out = (uInt)*pOut_buf_size;
+    const int ret = inflate(&s, Z_NO_FLUSH);
+    *pIn_buf_size -= s.avail_in;
+    *pOut_buf_size -= s.avail_out;
+
+    if (ret == Z_STREAM_END)
+        return TINFL_STATUS_DONE;
+    if (ret != Z_OK && ret != Z_BUF_ERROR)
+        return ret == Z_DATA_ERROR && (decomp_flags & TINFL_FLAG_PARSE_ZLIB_HEADER) ? TINFL_STATUS_ADLER32_MISMATCH : TINFL_STATUS_FAILED;
+    if (s.avail_out == 0)
+        return TINFL_STATUS_HAS_MORE_OUTPUT;
+    return (decomp_flags & TINFL_FLAG_HAS_MORE_INPUT) ? TINFL_STATUS_NEEDS_MORE_INPUT : TINFL_STATUS_FAILED;
+}
@@ -0,0 +1,335 @@
+/*
+Purpose: Host render runner for the display code.
+Responsibilities:
+- Render a fixed flight scenario through HostFramebufferDisplay on a virtual clock,
+  rendering only when the display says its screen changes (as the firmware loop does).
+- Report pixel writes and render time per frame; optionally dump frames as PPM.
+- Compare frames against a golden set (host/golden, checked by host/check_goldens.sh) so
+  layout or marquee regressions fail the run, reporting how many pixels differ.
+*/
+#include <Arduino.h>
+#include <sys/stat.h>
+#include <string>
+#include <vector>
+#include "host/HostFramebufferDisplay.h"
+#include "config/RuntimeSettings.h"
+#include "utils/ClosestApproach.h"
+#include "utils/Watchlist.h"
+
+namespace
+{
+    struct Options
+    {
+        unsigned long frames = 400;
+        unsigned long stepMs = 25; // one marquee step
+        const char *outDir = nullptr;
+        const char *goldenDir = nullptr;
+        unsigned long every = 1; // dump/compare every Nth frame only
+        bool perFrame = false;
+        int design = -1; // card design index; -1 keeps the configured one
+        int mode = -1;   // display mode; -1 keeps the configured one
+    };
+
+    void usage()
+    {
+        fprintf(stderr,
+                "usage: program [--frames N] [--step-ms MS] [--out DIR] [--golden DIR] [--every N] [--per-frame] [--design N] [--mode N]\n"
+                "  --out DIR     write every frame as DIR/frame_NNNN.ppm (use to create goldens)\n"
+                "  --golden DIR  compare every frame with DIR/frame_NNNN.ppm; exit 1 on mismatch\n"
+                "  --every N     only write/compare frames whose number is a multiple of N\n"
+                "  --per-frame   print frame,ms,pixel_writes,render_us,changed for each frame\n"
+                "  --design N    render with card design N (see tools/card_designs.json)\n"
+                "  --mode N      display mode: 0 cards, 1 radar, 2 nearest aircraft list\n");
+    }
+
+    bool parse(int argc, char **argv, Options &opt)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (arg == "--frames" && hasValue)
+                opt.frames = strtoul(argv[++i], nullptr, 10);
+            else if (arg == "--step-ms" && hasValue)
+                opt.stepMs = strtoul(argv[++i], nullptr, 10);
+            else if (arg == "--out" && hasValue)
+                opt.outDir = argv[++i];
+            else if (arg == "--golden" && hasValue)
+                opt.goldenDir = argv[++i];
+            else if (arg == "--every" && hasValue)
+                opt.every = strtoul(argv[++i], nullptr, 10);
+            else if (arg == "--per-frame")
+                opt.perFrame = true;
+            else if (arg == "--design" && hasValue)
+                opt.design = atoi(argv[++i]);
+            else if (arg == "--mode" && hasValue)
+                opt.mode = atoi(argv[++i]);
+            else
+                return false;
+        }
+        return opt.stepMs > 0 && opt.every > 0;
+    }
+
+    FlightInfo makeFlight(const char *ident, const char *identIcao, const char *operatorIcao, const char *airline, const char *aircraftCode,
+                          const char *aircraft, const char *from, const char *fromName,
+                          const char *to, const char *toName, double altitudeM, double speedMps)
+    {
+        FlightInfo f;
+        f.ident_iata = ident;
+        f.ident_icao = identIcao;
+        f.operator_icao = operatorIcao;
+        f.airline_display_name_full = airline;
+        f.aircraft_code = aircraftCode;
+        f.aircraft_display_name_short = aircraft;
+        f.origin.code_iata = from;
+        f.origin.name = fromName;
+        f.destination.code_iata = to;
+        f.destination.name = toName;
+        f.baro_altitude_m = altitudeM;
+        f.velocity_mps = speedMps;
+        f.version = flightDisplayVersion(f);
+        return f;
+    }
+
+    // Short and long names, so both static lines and every marquee are exercised; the
+    // operators all have tail fin sprites.
+    std::vector<FlightInfo> scenario()
+    {
+        return {
+            makeFlight("LH438", "DLH438", "DLH", "Lufthansa", "A359", "Airbus A350-900",
+                       "MUC", "Munich Airport", "DTW", "Detroit Metropolitan Wayne County Airport",
+                       11582.0, 251.0),
+            makeFlight("UA901", "UAL901", "UAL", "United Airlines", "B789", "Boeing 787-9",
+                       "SFO", "San Francisco International Airport", "FRA", "Frankfurt am Main Airport",
+                       10668.0, 243.0),
+            makeFlight("EW7", "EWG7", "EWG", "Eurowings", "A320", "Airbus A320",
+                       "CGN", "Cologne Bonn Airport", "PMI", "Palma de Mallorca Airport",
+                       3200.0, 160.0),
+        };
+    }
+
+    // State vectors of a fetch at nowMs: the scenario flights plus two aircraft that were
+    // never enriched, each flying a straight track at constant speed and vertical rate, so
+    // positions between fetches can be dead-reckoned. The list re-sorts and rows change.
+    // From 10 s on, UAL901 squawks 7700 and preempts the card cycle.
+    std::vector<StateVector> traffic(unsigned long nowMs)
+    {
+        struct Track
+        {
+            const char *icao24;
+            const char *callsign;
+            double eastKm; // position at time 0, from the center
+            double northKm;
+            double trackDeg;
+            double speedMps;
+            double altitudeM;
+            double climbMps;
+        };
+        static const Track tracks[] = {
+            {"3c6752", "DLH438  ", -13.2, -4.8, 70.0, 251.0, 11582.0, 0.0},
+            {"a8c1f3", "UAL901  ", 19.9, 23.7, 40.0, 243.0, 10668.0, 0.0},
+            {"3c5ee1", "EWG7    ", 7.1, -4.1, 120.0, 160.0, 3200.0, 12.0},
+            {"4b1805", "SWR16K  ", -19.5, 11.3, 120.0, 200.0, 7300.0, -6.0},
+            {"3c4b26", "", 0.9, 5.0, 95.0, 60.0, 450.0, 0.0},
+        };
+        const double seconds = nowMs / 1000.0;
+        const FlightWatchSettings &center = RuntimeSettings::current();
+        std::vector<StateVector> states;
+        for (const Track &t : tracks)
+        {
+            const double track = t.trackDeg * M_PI / 180.0;
+            const double east = t.eastKm + t.speedMps / 1000.0 * sin(track) * seconds;
+            const double north = t.northKm + t.speedMps / 1000.0 * cos(track) * seconds;
+            StateVector s;
+            s.icao24 = t.icao24;
+            s.callsign = t.callsign;
+            s.position_ms = nowMs;
+            s.lat = center.centerLat + north / 111.0;
+            s.lon = center.centerLon + east / (111.0 * cos(center.centerLat * M_PI / 180.0));
+            s.distance_km = sqrt(east * east + north * north);
+            s.bearing_deg = fmod(atan2(east, north) * 180.0 / M_PI + 360.0, 360.0);
+            s.baro_altitude = t.altitudeM + t.climbMps * seconds;
+            s.velocity = t.speedMps;
+            s.heading = t.trackDeg;
+            s.vertical_rate = t.climbMps;
+            if (nowMs >= 10000 && strcmp(t.icao24, "a8c1f3") == 0)
+                s.squawk = "7700";
+            s.watch = Watchlist::active().match(s); // as OpenSkyFetcher does while parsing
+            states.push_back(s);
+        }
+        return states;
+    }
+
+    bool readFile(const std::string &path, std::vector<uint8_t> &out)
+    {
+        FILE *f = fopen(path.c_str(), "rb");
+        if (f == nullptr)
+            return false;
+        out.clear();
+        uint8_t buf[4096];
+        size_t n = 0;
+        while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+            out.insert(out.end(), buf, buf + n);
+        fclose(f);
+        return true;
+    }
+
+    // Pixels that differ between two binary PPMs of the same size; -1 when they cannot be
+    // compared (missing file, other geometry).
+    long pixelDiff(const std::vector<uint8_t> &a, const std::vector<uint8_t> &b)
+    {
+        if (a.size() != b.size())
+            return -1;
+        // Both start with the same "P6\nW H\n255\n" header, so pixels line up from the end.
+        long diff = 0;
+        for (size_t i = a.size() % 3; i < a.size(); i += 3)
+            if (a[i] != b[i] || a[i + 1] != b[i + 1] || a[i + 2] != b[i + 2])
+                diff++;
+        return diff;
+    }
+
+    std::string framePath(const char *dir, unsigned long frame)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "/frame_%04lu.ppm", frame);
+        return std::string(dir) + name;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Options opt;
+    if (!parse(argc, argv, opt))
+    {
+        usage();
+        return 2;
+    }
+
+    RuntimeSettings::load(); // compiled-in defaults; the host NVS starts empty
+    if (opt.design >= 0)
+    {
+        FlightWatchSettings settings = RuntimeSettings::current();
+        settings.cardDesign = (uint8_t)opt.design;
+        RuntimeSettings::save(settings);
+    }
+    if (opt.mode >= 0)
+    {
+        FlightWatchSettings settings = RuntimeSettings::current();
+        settings.displayMode = (uint8_t)opt.mode;
+        RuntimeSettings::save(settings);
+    }
+    HostFramebufferDisplay display;
+    if (!display.initialize())
+    {
+        fprintf(stderr, "host: display init failed\n");
+        return 1;
+    }
+    if (opt.outDir)
+        mkdir(opt.outDir, 0755);
+
+    std::vector<FlightInfo> flights = scenario();
+    const std::string tmpPath = "/tmp/flightwatch_host_frame.ppm";
+
+    unsigned long rendered = 0;
+    unsigned long changed = 0;
+    unsigned long mismatches = 0;
+    unsigned long compared = 0;
+    uint64_t totalWrites = 0;
+    uint64_t totalUs = 0;
+    uint32_t maxWrites = 0;
+    uint32_t maxUs = 0;
+
+    if (opt.perFrame)
+        printf("frame,ms,pixel_writes,render_us,changed\n");
+
+    const unsigned long passMs = 5000; // faster than a real fetch interval, to exercise updates
+    unsigned long pass = 0;
+    for (unsigned long frame = 0; frame < opt.frames; ++frame)
+    {
+        const unsigned long now = millis();
+        bool fetched = false;
+        if (now >= pass * passMs)
+        {
+            // As FlightDataFetcher does, the flights carry their state vector's live metrics.
+            std::vector<StateVector> states = traffic(now);
+            ClosestApproach::predict(states);
+            for (FlightInfo &f : flights)
+            {
+                for (const StateVector &s : states)
+                {
+                    String callsign = s.callsign;
+                    callsign.trim();
+                    if (callsign != f.ident_icao)
+                        continue;
+                    f.icao24 = s.icao24;
+                    f.baro_altitude_m = s.baro_altitude;
+                    f.velocity_mps = s.velocity;
+                    f.track_deg = s.heading;
+                    f.vertical_rate_mps = s.vertical_rate;
+                    f.position_ms = s.position_ms;
+                    f.distance_km = s.distance_km;
+                    f.bearing_deg = s.bearing_deg;
+                    f.cpa_distance_km = s.cpa_distance_km;
+                    f.cpa_time_s = s.cpa_time_s;
+                    f.watch = s.watch;
+                }
+            }
+            display.display().updateTraffic(states, flights);
+            pass++;
+            fetched = true;
+        }
+        if (fetched || display.display().msUntilNextChange(now) == 0)
+        {
+            display.displayFlights(flights);
+            const HostFramebufferDisplay::FrameStats &st = display.lastFrame();
+            rendered++;
+            changed += st.changed ? 1 : 0;
+            totalWrites += st.pixelWrites;
+            totalUs += st.renderUs;
+            if (st.pixelWrites > maxWrites) maxWrites = st.pixelWrites;
+            if (st.renderUs > maxUs) maxUs = st.renderUs;
+            if (opt.perFrame)
+                printf("%lu,%lu,%u,%u,%d\n", frame, now, st.pixelWrites, st.renderUs, st.changed ? 1 : 0);
+        }
+
+        const bool sampled = frame % opt.every == 0;
+        if (opt.outDir && sampled)
+            display.writePpm(framePath(opt.outDir, frame).c_str());
+        if (opt.goldenDir && sampled)
+        {
+            std::vector<uint8_t> expected;
+            std::vector<uint8_t> actual;
+            display.writePpm(tmpPath.c_str());
+            const std::string golden = framePath(opt.goldenDir, frame);
+            compared++;
+            if (!readFile(golden, expected))
+            {
+                fprintf(stderr, "host: frame %lu: missing %s\n", frame, golden.c_str());
+                mismatches++;
+            }
+            else if (readFile(tmpPath, actual) && expected != actual)
+            {
+                const long pixels = pixelDiff(expected, actual);
+                if (pixels < 0)
+                    fprintf(stderr, "host: frame %lu: geometry differs from %s\n", frame, golden.c_str());
+                else
+                    fprintf(stderr, "host: frame %lu: %ld pixels differ from %s\n", frame, pixels, golden.c_str());
+                mismatches++;
+            }
+        }
+        hostAdvanceMillis(opt.stepMs);
+    }
+
+    printf("frames %lu (%lu ms each), rendered %lu, changed %lu\n",
+           opt.frames, opt.stepMs, rendered, changed);
+    printf("pixel writes: total %llu, mean %.1f, max %u per rendered frame\n",
+           (unsigned long long)totalWrites, rendered ? (double)totalWrites / rendered : 0.0, maxWrites);
+    printf("render time: mean %.1f us, max %u us per rendered frame\n",
+           rendered ? (double)totalUs / rendered : 0.0, maxUs);
+    if (opt.goldenDir)
+    {
+        printf("golden: %lu of %lu frames differ\n", mismatches, compared);
+        return mismatches == 0 ? 0 : 1;
+    }
+    return 0;
+}
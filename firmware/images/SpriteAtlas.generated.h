@@ -0,0 +1,127 @@
+// Auto-generated by tools/generate_sprite_atlas.py. Do not edit manually.
+#pragma once
+
+#include <Arduino.h>
+#include "images/SpriteIds.generated.h"
+
+// 16 sprites, 731 bytes of run data.
+
+// Rows of runs: palette index (0 = transparent) << 6 | (run length - 1).
+static const uint8_t kSpriteRuns[] PROGMEM = {
+    // airline_aal (7x8)
+    0x04,0x41,0x03,0x42,0x02,0x43,0x01,0x84,0x00,0xC5,0x46,0x46,0x46,
+    // airline_afr (7x8)
+    0x04,0x41,0x03,0x80,0x41,0x02,0x81,0x41,0x01,0xC1,0x80,0x41,0x00,0xC2,0x80,0x41,
+    0xC3,0x80,0x41,0xC3,0x80,0x41,0xC3,0x80,0x41,
+    // airline_baw (7x8)
+    0x04,0x41,0x03,0x42,0x02,0x43,0x01,0x44,0x00,0x83,0x41,0x84,0x41,0xC6,0x46,
+    // airline_dal (7x8)
+    0x04,0x41,0x03,0x42,0x02,0x80,0x42,0x01,0x81,0x42,0x00,0x82,0x42,0x83,0x42,0x83,
+    0x42,0x83,0x42,
+    // airline_dlh (7x8)
+    0x04,0x41,0x03,0x42,0x02,0x43,0x01,0x40,0x82,0x40,0x00,0x41,0x82,0x40,0x42,0x82,
+    0x40,0x46,0x46,
+    // airline_ewg (7x8)
+    0x04,0x41,0x03,0x42,0x02,0x43,0x01,0x44,0x00,0x45,0x46,0x46,0x46,
+    // airline_ezy (7x8)
+    0x04,0x41,0x03,0x42,0x02,0x43,0x01,0x44,0x00,0x45,0x86,0x46,0x46,
+    // airline_klm (7x8)
+    0x04,0x41,0x03,0x42,0x02,0x43,0x01,0x44,0x00,0x45,0x46,0x46,0x46,
+    // airline_ryr (7x8)
+    0x04,0x41,0x03,0x42,0x02,0x43,0x01,0x44,0x00,0x41,0x82,0x40,0x42,0x82,0x40,0x42,
+    0x82,0x40,0x46,
+    // airline_ual (7x8)
+    0x04,0x41,0x03,0x42,0x02,0x43,0x01,0x44,0x00,0x45,0x46,0x46,0x86,
+    // logo (64x64)
+    0x3F,0x3F,0x3F,0x3F,0x3F,0x3F,0x3F,0x3F,0x3F,0x3F,0x35,0x45,0x03,0x34,0x45,0x04,
+    0x32,0x45,0x00,0x40,0x04,0x26,0x43,0x03,0x41,0x00,0x45,0x07,0x27,0x48,0x00,0x43,
+    0x09,0x29,0x4A,0x0A,0x23,0x41,0x05,0x40,0x00,0x40,0x00,0x42,0x0C,0x23,0x42,0x02,
+    0x41,0x00,0x43,0x01,0x40,0x0B,0x24,0x49,0x01,0x40,0x00,0x41,0x0A,0x25,0x46,0x01,
+    0x44,0x0B,0x21,0x46,0x00,0x40,0x05,0x41,0x0C,0x25,0x40,0x00,0x40,0x07,0x41,0x0C,
+    0x1F,0x40,0x00,0x41,0x04,0x40,0x00,0x40,0x05,0x40,0x0C,0x1E,0x40,0x00,0x40,0x01,
+    0x40,0x02,0x40,0x16,0x1B,0x40,0x00,0x40,0x00,0x40,0x00,0x40,0x1C,0x08,0x40,0x0D,
+    0x40,0x01,0x40,0x00,0x40,0x04,0x40,0x1B,0x07,0x40,0x0B,0x42,0x00,0x43,0x03,0x40,
+    0x1D,0x06,0x41,0x08,0x40,0x00,0x40,0x02,0x41,0x03,0x40,0x00,0x40,0x1E,0x06,0x41,
+    0x05,0x44,0x00,0x44,0x01,0x40,0x22,0x05,0x42,0x01,0x44,0x03,0x41,0x00,0x40,0x02,
+    0x40,0x23,0x03,0x40,0x00,0x46,0x02,0x44,0x00,0x40,0x01,0x40,0x25,0x03,0x40,0x01,
+    0x43,0x02,0x44,0x04,0x40,0x26,0x03,0x41,0x03,0x40,0x00,0x43,0x2F,0x03,0x4A,0x30,
+    0x04,0x46,0x33,0x06,0x41,0x36,0x3F,0x0A,0x40,0x00,0x41,0x00,0x40,0x00,0x41,0x04,
+    0x40,0x00,0x40,0x03,0x41,0x00,0x41,0x01,0x41,0x03,0x41,0x01,0x41,0x00,0x43,0x07,
+    0x09,0x45,0x01,0x41,0x04,0x42,0x01,0x47,0x00,0x41,0x03,0x42,0x00,0x47,0x06,0x08,
+    0x41,0x05,0x42,0x04,0x41,0x00,0x42,0x07,0x41,0x02,0x42,0x04,0x41,0x09,0x08,0x45,
+    0x01,0x41,0x05,0x41,0x00,0x41,0x02,0x43,0x01,0x47,0x03,0x41,0x0A,0x07,0x41,0x01,
+    0x40,0x02,0x42,0x05,0x40,0x01,0x42,0x02,0x42,0x01,0x40,0x01,0x40,0x00,0x41,0x04,
+    0x42,0x09,0x07,0x41,0x05,0x41,0x06,0x40,0x01,0x41,0x03,0x41,0x01,0x41,0x03,0x41,
+    0x04,0x41,0x0A,0x07,0x41,0x05,0x46,0x00,0x41,0x01,0x44,0x00,0x42,0x00,0x40,0x03,
+    0x42,0x03,0x42,0x0A,0x07,0x41,0x05,0x42,0x00,0x41,0x01,0x41,0x02,0x45,0x02,0x41,
+    0x02,0x40,0x00,0x40,0x03,0x42,0x0A,0x3F,0x3F,0x0F,0x41,0x00,0x41,0x00,0x41,0x00,
+    0x42,0x00,0x44,0x00,0x43,0x00,0x41,0x01,0x41,0x11,0x0B,0x40,0x03,0x40,0x00,0x41,
+    0x00,0x41,0x00,0x40,0x00,0x40,0x02,0x40,0x02,0x40,0x03,0x41,0x01,0x41,0x01,0x40,
+    0x00,0x40,0x0C,0x08,0x42,0x00,0x40,0x01,0x44,0x00,0x40,0x02,0x41,0x02,0x40,0x02,
+    0x40,0x03,0x44,0x02,0x40,0x00,0x40,0x00,0x40,0x0A,0x10,0x41,0x00,0x41,0x01,0x41,
+    0x00,0x40,0x01,0x41,0x01,0x42,0x02,0x40,0x02,0x40,0x12,0x10,0x40,0x02,0x40,0x00,
+    0x40,0x02,0x41,0x00,0x40,0x04,0x44,0x01,0x40,0x13,0x0D,0x40,0x30,0x0E,0x41,0x1A,
+    0x42,0x10,0x16,0x50,0x17,0x1C,0x40,0x01,0x40,0x1E,0x3F,0x3F,0x3F,0x3F,0x3F,0x3F,
+    0x3F,0x3F,
+    // weather_cloud (7x8)
+    0x02,0x40,0x02,0x01,0x40,0x00,0x40,0x01,0x00,0x44,0x00,0x46,0x00,0x44,0x00,0x06,
+    0x06,0x06,
+    // weather_rain (7x8)
+    0x02,0x40,0x02,0x01,0x40,0x00,0x40,0x01,0x00,0x44,0x00,0x46,0x00,0x44,0x00,0x06,
+    0x01,0x40,0x00,0x40,0x00,0x40,0x06,
+    // weather_snow (7x8)
+    0x02,0x40,0x02,0x01,0x40,0x00,0x40,0x01,0x00,0x44,0x00,0x46,0x00,0x44,0x00,0x06,
+    0x01,0x40,0x00,0x40,0x01,0x02,0x40,0x02,
+    // weather_sun (7x8)
+    0x06,0x02,0x40,0x02,0x01,0x42,0x01,0x00,0x44,0x00,0x01,0x42,0x01,0x02,0x40,0x02,
+    0x06,0x06,
+    // weather_unknown (7x8)
+    0x06,0x02,0x40,0x02,0x01,0x40,0x00,0x40,0x01,0x02,0x40,0x02,0x06,0x02,0x40,0x02,
+    0x06,0x02,0x40,0x02,
+};
+
+struct SpriteDesc
+{
+    uint8_t width;
+    uint8_t height;
+    uint16_t offset; // first run in kSpriteRuns
+    uint8_t palette[3][3]; // RGB for indices 1..3
+};
+static const SpriteDesc kSprites[] PROGMEM = {
+    {7, 8, 0, {{170, 170, 180}, {210, 25, 45}, {20, 90, 200}}}, // airline_aal
+    {7, 8, 13, {{210, 25, 45}, {230, 230, 230}, {0, 50, 160}}}, // airline_afr
+    {7, 8, 38, {{10, 40, 110}, {210, 25, 45}, {230, 230, 230}}}, // airline_baw
+    {7, 8, 53, {{210, 25, 45}, {0, 40, 110}, {0, 0, 0}}}, // airline_dal
+    {7, 8, 72, {{10, 40, 110}, {250, 190, 0}, {0, 0, 0}}}, // airline_dlh
+    {7, 8, 91, {{170, 0, 90}, {0, 0, 0}, {0, 0, 0}}}, // airline_ewg
+    {7, 8, 104, {{255, 100, 0}, {230, 230, 230}, {0, 0, 0}}}, // airline_ezy
+    {7, 8, 117, {{0, 160, 225}, {0, 0, 0}, {0, 0, 0}}}, // airline_klm
+    {7, 8, 130, {{10, 40, 110}, {250, 190, 0}, {0, 0, 0}}}, // airline_ryr
+    {7, 8, 149, {{20, 90, 200}, {200, 150, 60}, {0, 0, 0}}}, // airline_ual
+    {64, 64, 162, {{255, 255, 255}, {0, 0, 0}, {0, 0, 0}}}, // logo
+    {7, 8, 628, {{255, 255, 255}, {0, 0, 0}, {0, 0, 0}}}, // weather_cloud
+    {7, 8, 646, {{255, 255, 255}, {0, 0, 0}, {0, 0, 0}}}, // weather_rain
+    {7, 8, 669, {{255, 255, 255}, {0, 0, 0}, {0, 0, 0}}}, // weather_snow
+    {7, 8, 693, {{255, 255, 255}, {0, 0, 0}, {0, 0, 0}}}, // weather_sun
+    {7, 8, 711, {{255, 255, 255}, {0, 0, 0}, {0, 0, 0}}}, // weather_unknown
+};
+
+// Operator ICAO code -> tail fin sprite, sorted by code.
+struct AirlineSpriteEntry
+{
+    char icao[4];
+    uint8_t sprite;
+};
+static const AirlineSpriteEntry kAirlineSprites[] PROGMEM = {
+    {"AAL", Sprite::AirlineAal},
+    {"AFR", Sprite::AirlineAfr},
+    {"BAW", Sprite::AirlineBaw},
+    {"DAL", Sprite::AirlineDal},
+    {"DLH", Sprite::AirlineDlh},
+    {"EWG", Sprite::AirlineEwg},
+    {"EZY", Sprite::AirlineEzy},
+    {"KLM", Sprite::AirlineKlm},
+    {"RYR", Sprite::AirlineRyr},
+    {"UAL", Sprite::AirlineUal},
+};
+static constexpr size_t kAirlineSprites_COUNT = sizeof(kAirlineSprites) / sizeof(kAirlineSprites[0]);
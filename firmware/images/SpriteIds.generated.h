@@ -0,0 +1,28 @@
+// Auto-generated by tools/generate_sprite_atlas.py. Do not edit manually.
+#pragma once
+
+#include <stdint.h>
+
+namespace Sprite
+{
+    enum : uint8_t
+    {
+        AirlineAal,
+        AirlineAfr,
+        AirlineBaw,
+        AirlineDal,
+        AirlineDlh,
+        AirlineEwg,
+        AirlineEzy,
+        AirlineKlm,
+        AirlineRyr,
+        AirlineUal,
+        Logo,
+        WeatherCloud,
+        WeatherRain,
+        WeatherSnow,
+        WeatherSun,
+        WeatherUnknown,
+        Count,
+    };
+}
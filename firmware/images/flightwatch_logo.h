@@ -1,49 +0,0 @@
-#pragma once
-#include <stdint.h>
-// 64x64 monochrome logo (0=ink,1=transparent)
-static const uint8_t FLIGHTWATCH_LOGO_64x64[] PROGMEM = {
-
-    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
-    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
-    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
-    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
-    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
-    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
-    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
-    0xFF,0xFF,0xFC,0x0F,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xF8,0x1F,
-    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xE0,0x5F,0xFF,0xFF,0xFF,0xFF,
-    0xFE,0x1E,0x40,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0x00,0x43,0xFF,
-    0xFF,0xFF,0xFF,0xFF,0xFF,0xC0,0x07,0xFF,0xFF,0xFF,0xFF,0xFF,
-    0xF3,0xF5,0x1F,0xFF,0xFF,0xFF,0xFF,0xFF,0xF1,0xC8,0x6F,0xFF,
-    0xFF,0xFF,0xFF,0xFF,0xF8,0x01,0xA7,0xFF,0xFF,0xFF,0xFF,0xFF,
-    0xFC,0x06,0x0F,0xFF,0xFF,0xFF,0xFF,0xFF,0xC0,0x5F,0x9F,0xFF,
-    0xFF,0xFF,0xFF,0xFF,0xFD,0x7F,0x9F,0xFF,0xFF,0xFF,0xFF,0xFF,
-    0x4F,0xAF,0xDF,0xFF,0xFF,0xFF,0xFF,0xFE,0xB7,0x7F,0xFF,0xFF,
-    0xFF,0xFF,0xFF,0xF5,0x5F,0xFF,0xFF,0xFF,0xFF,0xBF,0xFF,0x6B,
-    0xEF,0xFF,0xFF,0xFF,0xFF,0x7F,0xF8,0x87,0xBF,0xFF,0xFF,0xFF,
-    0xFE,0x7F,0xD7,0x3D,0x7F,0xFF,0xFF,0xFF,0xFE,0x7E,0x08,0x37,
-    0xFF,0xFF,0xFF,0xFF,0xFC,0x60,0xF2,0xEF,0xFF,0xFF,0xFF,0xFF,
-    0xF4,0x07,0x05,0xBF,0xFF,0xFF,0xFF,0xFF,0xF6,0x1C,0x1F,0x7F,
-    0xFF,0xFF,0xFF,0xFF,0xF3,0xD0,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
-    0xF0,0x01,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xF8,0x0F,0xFF,0xFF,
-    0xFF,0xFF,0xFF,0xFF,0xFE,0x7F,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
-    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xE9,0x4F,0xAF,
-    0x26,0x79,0x90,0xFF,0xFF,0xC0,0xCF,0x8C,0x02,0x78,0x80,0x7F,
-    0xFF,0x9F,0x8F,0x91,0xFE,0x71,0xF3,0xFF,0xFF,0x81,0x9F,0x93,
-    0x86,0x01,0xE7,0xFF,0xFF,0x37,0x1F,0xB1,0xC6,0xD3,0xE3,0xFF,
-    0xFF,0x3F,0x3F,0xB3,0xCC,0xF3,0xE7,0xFF,0xFF,0x3F,0x01,0x30,
-    0x45,0xE3,0xC7,0xFF,0xFF,0x3F,0x13,0x38,0x1C,0xEB,0xC7,0xFF,
-    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
-    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0x24,0x88,0x21,0x33,0xFF,0xFF,
-    0xFF,0xF7,0xA4,0xAE,0xEF,0x33,0x5F,0xFF,0xFF,0x8B,0x05,0xCE,
-    0xEF,0x07,0x57,0xFF,0xFF,0xFF,0x93,0x2C,0xC7,0x77,0xFF,0xFF,
-    0xFF,0xFF,0xBA,0xE5,0xF0,0x6F,0xFF,0xFF,0xFF,0xFD,0xFF,0xFF,
-    0xFF,0xFF,0xFF,0xFF,0xFF,0xFE,0x7F,0xFF,0xFF,0xF1,0xFF,0xFF,
-    0xFF,0xFF,0xFE,0x00,0x00,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFB,
-    0x7F,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
-    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
-    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
-    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
-    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
-    0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
-};
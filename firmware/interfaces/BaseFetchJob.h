@@ -0,0 +1,22 @@
+#pragma once
+
+#include <Arduino.h>
+
+// One resumable unit of network work driven by FetchScheduler. A pass starts when due()
+// returns true and then advances one bounded step() per scheduler turn, so other jobs
+// get to run between an OpenSky fetch and each AeroAPI call.
+class BaseFetchJob
+{
+public:
+    virtual ~BaseFetchJob() = default;
+
+    virtual const char *name() const = 0;
+    // Jobs that need the network are not started, and are cancelled, while WiFi is down.
+    virtual bool needsNetwork() const { return true; }
+    virtual bool due(unsigned long nowMs) = 0;
+    virtual void start(unsigned long nowMs) = 0;
+    // Runs one step of the current pass; returns false when the pass is finished.
+    virtual bool step(unsigned long nowMs) = 0;
+    // The pass ran past its deadline or lost WiFi; drop or publish partial state.
+    virtual void cancel() {}
+};
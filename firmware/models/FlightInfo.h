@@ -10,6 +10,7 @@ struct FlightInfo
     String ident;
     String ident_icao;
     String ident_iata;
+    String icao24; // transponder address (hex) of the state vector the flight came from
 
     // Operator
     String operator_code;
@@ -30,4 +31,71 @@ struct FlightInfo
     // Live metrics from state vector
     double baro_altitude_m = NAN; // meters
     double velocity_mps = NAN;    // meters/second (ground speed)
+    double track_deg = NAN;       // true track, degrees clockwise from north
+    double vertical_rate_mps = NAN; // meters/second, positive climbing
+    unsigned long position_ms = 0;  // millis() of the position fix; 0 if unknown
+    double distance_km = NAN;     // from the configured center
+    double bearing_deg = NAN;     // from the configured center to the aircraft
+    double cpa_distance_km = NAN; // predicted closest pass to the center
+    double cpa_time_s = NAN;      // seconds until the closest pass; 0 if receding
+    uint8_t watch = 0;            // Watchlist::Match bits (callsign, type, address, squawk)
+
+    // Content stamp of the identity/name/route fields above (see flightDisplayVersion),
+    // set by FlightDataFetcher. 0 means not stamped.
+    uint32_t version = 0;
 };
+
+// FNV-1a over the fields that shape the flight card layout. Live metrics are left out so
+// a new altitude or speed does not restart the card's marquees. Never returns 0.
+inline uint32_t flightDisplayVersion(const FlightInfo &f)
+{
+    uint32_t h = 2166136261u;
+    auto mix = [&h](const String &field) {
+        const char *p = field.c_str();
+        for (unsigned int i = 0; i < field.length(); ++i)
+        {
+            h = (h ^ (uint8_t)p[i]) * 16777619u;
+        }
+        h = (h ^ 0x1Fu) * 16777619u; // field separator
+    };
+    mix(f.ident);
+    mix(f.ident_icao);
+    mix(f.ident_iata);
+    mix(f.operator_code);
+    mix(f.operator_icao);
+    mix(f.operator_iata);
+    mix(f.origin.code_icao);
+    mix(f.origin.code_iata);
+    mix(f.origin.name);
+    mix(f.destination.code_icao);
+    mix(f.destination.code_iata);
+    mix(f.destination.name);
+    mix(f.aircraft_code);
+    mix(f.airline_display_name_full);
+    mix(f.aircraft_display_name_short);
+    return h == 0 ? 1 : h;
+}
+
+// FNV-1a over the live metrics copied from the state vector, so a changed altitude or
+// position can be told apart from a changed card. Watchlist matches count as metrics
+// (a squawk can change in flight). The fix time is left out: a new fix that reports the
+// same values is not a change. Never returns 0.
+inline uint32_t flightMetricsVersion(const FlightInfo &f)
+{
+    uint32_t h = 2166136261u;
+    auto mix = [&h](double value) {
+        const uint8_t *p = (const uint8_t *)&value;
+        for (size_t i = 0; i < sizeof(value); ++i)
+        {
+            h = (h ^ p[i]) * 16777619u;
+        }
+    };
+    mix(f.baro_altitude_m);
+    mix(f.velocity_mps);
+    mix(f.track_deg);
+    mix(f.vertical_rate_mps);
+    mix(f.distance_km);
+    mix(f.bearing_deg);
+    mix((double)f.watch);
+    return h == 0 ? 1 : h;
+}
@@ -8,6 +8,7 @@ struct StateVector
     String callsign;
     String origin_country;
     long time_position = 0;
+    unsigned long position_ms = 0; // time_position on the local millis() clock; 0 if unknown
     long last_contact = 0;
     double lon = NAN;
     double lat = NAN;
@@ -23,4 +24,7 @@ struct StateVector
     int position_source = 0;
     double distance_km = NAN;
     double bearing_deg = NAN;
+    double cpa_distance_km = NAN; // predicted closest pass to the center (ClosestApproach)
+    double cpa_time_s = NAN;      // seconds until then; 0 if receding
+    uint8_t watch = 0;            // Watchlist::Match bits, set while parsing
 };
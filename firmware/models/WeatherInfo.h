@@ -0,0 +1,12 @@
+#pragma once
+
+#include <Arduino.h>
+
+struct WeatherInfo
+{
+    float temperatureC = NAN;
+    int weatherCode = -1; // WMO code from Open-Meteo; -1 when unknown
+    unsigned long fetchedMs = 0;
+
+    bool valid() const { return !isnan(temperatureC) || weatherCode >= 0; }
+};
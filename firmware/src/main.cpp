@@ -2,7 +2,8 @@
 Purpose: Firmware entry point for ESP32.
 Responsibilities:
 - Initialize serial, connect to Wi‑Fi, and construct fetchers and display.
-- Periodically fetch state vectors (OpenSky), enrich flights (AeroAPI), and render.
+- Run the network jobs (flights, token refresh, weather, WiFi watchdog) from one cooperative
+  scheduler on the fetch task, and render the latest published results.
 Configuration: UserConfiguration (location/filters/colors), TimingConfiguration (intervals),
                WiFiConfiguration (SSID/password), HardwareConfiguration (display specs).
 */
@@ -28,8 +29,14 @@ Configuration: UserConfiguration (location/filters/colors), TimingConfiguration
 #include "config/TimingConfiguration.h"
 #include "adapters/OpenSkyFetcher.h"
 #include "adapters/AeroAPIFetcher.h"
+#include "adapters/OpenMeteoFetcher.h"
 #include "core/FlightDataFetcher.h"
+#include "core/FetchScheduler.h"
+#include "core/FetchJobs.h"
 #include "adapters/NeoMatrixDisplay.h"
+#include "utils/CardLayout.h"
+#include "utils/Watchlist.h"
+#include "utils/DnsCache.h"
 #include "utils/NetLock.h"
 
 RTC_DATA_ATTR static uint32_t g_resetCounter = 0;
@@ -45,14 +52,23 @@ static unsigned long g_serverStartMs = 0;
 
 static OpenSkyFetcher g_openSky;
 static AeroAPIFetcher g_aeroApi;
+static OpenMeteoFetcher g_openMeteo;
 static FlightDataFetcher *g_fetcher = nullptr;
+static FetchScheduler g_scheduler;
 static NeoMatrixDisplay g_display;
 static std::vector<FlightInfo> g_lastFlights;
+static std::vector<StateVector> g_lastStates; // raw states of the last pass, for the radar
+static WeatherInfo g_lastWeather;
+static uint32_t g_dataGeneration = 0;   // bumped under g_flightsMutex on every publish
+static uint32_t g_statesGeneration = 0; // bumped with each new g_lastStates
 static SemaphoreHandle_t g_flightsMutex = nullptr;
 static TaskHandle_t g_fetchTaskHandle = nullptr;
+static TaskHandle_t g_loopTaskHandle = nullptr;
+static SemaphoreHandle_t g_displayMutex = nullptr; // only contended during setup()
+static TaskHandle_t g_bootAnimTaskHandle = nullptr;
+static SemaphoreHandle_t g_bootAnimDone = nullptr; // given by the task once it stops drawing
+static volatile bool g_setupDone = false;
 
-static unsigned long g_lastFetchMs = 0;
-static unsigned long g_lastWifiCheckMs = 0;
 static bool g_doubleResetWindowArmed = false;
 static unsigned long g_doubleResetWindowStartMs = 0;
 
@@ -80,6 +96,7 @@ static void netDiag()
     {
         client.stop();
     }
+    DnsCache::logStats();
     Serial.println("--- end net diag ---");
 }
 
@@ -112,55 +129,78 @@ static void maybeLogNetDiag(size_t stateCount, size_t flightCount)
     }
 }
 
-static void ensureWifiConnected()
+static void publishFlights(const std::vector<StateVector> &states,
+                           const std::vector<FlightInfo> &flights,
+                           size_t enriched)
 {
-    const unsigned long now = millis();
-    const unsigned long CHECK_EVERY_MS = 10000;
-    if (now - g_lastWifiCheckMs < CHECK_EVERY_MS)
-        return;
-    g_lastWifiCheckMs = now;
+    Serial.print("OpenSky state vectors: ");
+    Serial.println((int)states.size());
+    Serial.print("AeroAPI enriched flights: ");
+    Serial.println((int)enriched);
+    maybeLogNetDiag(states.size(), flights.size());
+
+    if (g_flightsMutex && xSemaphoreTake(g_flightsMutex, pdMS_TO_TICKS(200)))
+    {
+        g_lastFlights = flights;
+        g_lastStates = states;
+        g_statesGeneration++;
+        g_dataGeneration++;
+        xSemaphoreGive(g_flightsMutex);
+    }
+    if (g_loopTaskHandle)
+    {
+        xTaskNotifyGive(g_loopTaskHandle); // wake the render loop for the new snapshot
+    }
 
-    bool badStatus = (WiFi.status() != WL_CONNECTED);
-    bool missingIp = (WiFi.localIP().toString() == "0.0.0.0");
-    if (badStatus || missingIp)
+    // Re-resolve hosts that were served from stale DNS entries, off the request path.
+    NetLock::Guard guard(500);
+    if (guard.locked())
+    {
+        DnsCache::refreshStale();
+    }
+}
+
+static void publishWeather(const WeatherInfo &weather)
+{
+    if (g_flightsMutex && xSemaphoreTake(g_flightsMutex, pdMS_TO_TICKS(200)))
+    {
+        g_lastWeather = weather;
+        g_dataGeneration++;
+        xSemaphoreGive(g_flightsMutex);
+    }
+    if (g_loopTaskHandle)
     {
-        Serial.println("WiFi watchdog: connection lost; attempting reconnect");
-        Serial.printf("Current status=%d, ip=%s\n", (int)WiFi.status(), WiFi.localIP().toString().c_str());
-        WiFi.disconnect(true);
-        delay(200);
-        WiFi.begin(); // reconnect using stored credentials
+        xTaskNotifyGive(g_loopTaskHandle);
     }
 }
 
 static void fetchTask(void *param)
 {
-    const TickType_t loopDelay = pdMS_TO_TICKS(50); // keep responsive while waiting for interval
+    const unsigned long intervalMs = TimingConfiguration::FETCH_INTERVAL_SECONDS * 1000UL;
+    static WifiWatchdogJob wifiJob;
+    static TokenRefreshJob tokenJob(g_openSky);
+    static FlightFetchJob flightJob(*g_fetcher, intervalMs, publishFlights);
+    static WeatherJob weatherJob(g_openMeteo, publishWeather);
+
+    // Pass budgets: a flight pass must end well inside the fetch interval. Short intervals
+    // get half of it rather than wrapping the unsigned subtraction.
+    const unsigned long flightBudgetMs = intervalMs > 10000UL ? intervalMs - 5000UL : intervalMs / 2;
+    g_scheduler.addJob(&wifiJob, 1000UL);
+    g_scheduler.addJob(&tokenJob, 15000UL);
+    g_scheduler.addJob(&flightJob, flightBudgetMs);
+    g_scheduler.addJob(&weatherJob, 10000UL);
+
+    const TickType_t idleDelay = pdMS_TO_TICKS(50); // keep responsive while no job is running
     while (true)
     {
-        const unsigned long intervalMs = TimingConfiguration::FETCH_INTERVAL_SECONDS * 1000UL;
-        const unsigned long now = millis();
-        ensureWifiConnected();
-        if (g_fetcher != nullptr && now - g_lastFetchMs >= intervalMs)
+        if (!g_scheduler.tick())
         {
-            g_lastFetchMs = now;
-
-            std::vector<StateVector> states;
-            std::vector<FlightInfo> flights;
-            size_t enriched = g_fetcher->fetchFlights(states, flights);
-
-            Serial.print("OpenSky state vectors: ");
-            Serial.println((int)states.size());
-            Serial.print("AeroAPI enriched flights: ");
-            Serial.println((int)enriched);
-            maybeLogNetDiag(states.size(), flights.size());
-
-            if (g_flightsMutex && xSemaphoreTake(g_flightsMutex, pdMS_TO_TICKS(200)))
-            {
-                g_lastFlights = flights;
-                xSemaphoreGive(g_flightsMutex);
-            }
+            vTaskDelay(idleDelay);
+        }
+        else
+        {
+            vTaskDelay(1); // let the watchdog and lower-priority tasks run between steps
         }
-        vTaskDelay(loopDelay);
     }
 }
 
@@ -209,6 +249,8 @@ static String settingsPageHtml()
     addField("aeroKey", "AeroAPI Key", cfg.aeroApiKey, "");
     addField("osId", "OpenSky Client ID", cfg.openSkyClientId, "");
     addField("osSecret", "OpenSky Client Secret", cfg.openSkyClientSecret, "");
+    addField("watchlist", "Watchlist", cfg.watchlist,
+             "Callsigns (DLH438, RCH*), operators (BAW), type:A388, hex:3c6752, sq:7000. Emergency squawks are always shown first.");
 
     html += "<label for='altUnits'>Altitude Units</label>";
     html += "<select id='altUnits' name='altUnits'>";
@@ -222,6 +264,23 @@ static String settingsPageHtml()
     html += String("<option value='kts'") + (cfg.speedKts ? " selected" : "") + ">Knots</option>";
     html += "</select>";
 
+    html += "<label for='displayMode'>Display Mode</label>";
+    html += "<select id='displayMode' name='displayMode'>";
+    html += String("<option value='0'") + (cfg.displayMode == 0 ? " selected" : "") + ">Flight cards</option>";
+    html += String("<option value='1'") + (cfg.displayMode == 1 ? " selected" : "") + ">Radar</option>";
+    html += String("<option value='2'") + (cfg.displayMode == 2 ? " selected" : "") + ">Nearest aircraft list</option>";
+    html += "</select>";
+
+    html += "<label for='cardDesign'>Card Design</label>";
+    html += "<select id='cardDesign' name='cardDesign'>";
+    for (uint8_t i = 0; i < CardLayout::designCount(); ++i)
+    {
+        html += String("<option value='") + String((unsigned)i) + "'" + (cfg.cardDesign == i ? " selected" : "") + ">";
+        html += CardLayout::design(i).label;
+        html += "</option>";
+    }
+    html += "</select>";
+
     html += "<button type='submit'>Save</button></form>";
     html += "<form method='POST' action='/reset' onsubmit='return confirm(\"Reset to defaults?\");'><button type='submit'>Reset to defaults</button></form>";
     html += "</body></html>";
@@ -249,6 +308,11 @@ static void handleSettingsSave()
     updated.weatherLon = parseDouble(g_server.arg("weatherLon"), updated.centerLon);
     updated.altitudeFeet = g_server.arg("altUnits") == "ft";
     updated.speedKts = g_server.arg("speedUnits") == "kts";
+    const String displayMode = g_server.arg("displayMode");
+    updated.displayMode = displayMode == "2" ? 2 : (displayMode == "1" ? 1 : 0);
+    long design = g_server.arg("cardDesign").toInt();
+    if (design >= 0 && design < CardLayout::designCount())
+        updated.cardDesign = (uint8_t)design;
 
     long b = g_server.arg("brightness").toInt();
     if (b < 0) b = 0;
@@ -259,6 +323,7 @@ static void handleSettingsSave()
     updated.aeroApiKey = g_server.arg("aeroKey");
     updated.openSkyClientId = g_server.arg("osId");
     updated.openSkyClientSecret = g_server.arg("osSecret");
+    updated.watchlist = g_server.arg("watchlist");
 
     if (!RuntimeSettings::save(updated))
     {
@@ -307,6 +372,44 @@ static void startSettingsServer()
     g_serverVisited = false;
     g_serverStartMs = millis();
 }
+// Plays the boot animation while setup() blocks in WiFi connect/portal; loop() drives
+// the display once setup returns.
+static void bootAnimationTask(void *param)
+{
+    while (!g_setupDone)
+    {
+        TickType_t waitTicks = portMAX_DELAY; // animation over: idle until setup finishes
+        if (xSemaphoreTake(g_displayMutex, portMAX_DELAY) == pdTRUE)
+        {
+            if (g_display.tickAnimation())
+            {
+                const unsigned long waitMs = g_display.msUntilNextChange(millis());
+                waitTicks = pdMS_TO_TICKS(waitMs ? waitMs : 1);
+            }
+            xSemaphoreGive(g_displayMutex);
+        }
+        ulTaskNotifyTake(pdTRUE, waitTicks);
+    }
+    // setup() deletes the task; exiting here could race its notify on our handle.
+    xSemaphoreGive(g_bootAnimDone);
+    vTaskSuspend(nullptr);
+}
+
+// Status line during setup; skipped on the panel while the boot animation runs unless
+// the message must be seen (WiFi portal), in which case the animation is cut short.
+static void showSetupStatus(const String &message, bool interruptAnimation = false)
+{
+    if (xSemaphoreTake(g_displayMutex, portMAX_DELAY) == pdTRUE)
+    {
+        if (interruptAnimation)
+        {
+            g_display.cancelAnimation();
+        }
+        g_display.displayMessage(message);
+        xSemaphoreGive(g_displayMutex);
+    }
+}
+
 static bool doubleResetDetected()
 {
     g_resetCounter++;
@@ -336,12 +439,24 @@ void setup()
     delay(200);
 
     RuntimeSettings::load();
+    Watchlist::load(RuntimeSettings::current().watchlist);
     g_flightsMutex = xSemaphoreCreateMutex();
+    g_loopTaskHandle = xTaskGetCurrentTaskHandle();
+    g_displayMutex = xSemaphoreCreateMutex();
+    g_bootAnimDone = xSemaphoreCreateBinary();
     NetLock::init();
 
+    // Boot test and logo play on their own task while WiFi connects below.
     g_display.initialize();
-    g_display.displayStartup();
-    delay(5000); // hold startup logo/text before entering WiFi setup
+    g_display.startBootSequence();
+    xTaskCreatePinnedToCore(
+        bootAnimationTask,
+        "bootAnim",
+        4096,
+        nullptr,
+        1,
+        &g_bootAnimTaskHandle,
+        APP_CPU_NUM);
 
     // Ensure clean STA mode before WiFiManager (mirrors Clockwise setup)
     WiFi.mode(WIFI_STA);
@@ -359,7 +474,7 @@ void setup()
     wifiManager.setTimeout(WiFiConfiguration::PORTAL_TIMEOUT_SECONDS);
     wifiManager.setAPCallback([](WiFiManager *)
     {
-        g_display.displayMessage(String("Setup: ") + WiFiConfiguration::PORTAL_SSID);
+        showSetupStatus(String("Setup: ") + WiFiConfiguration::PORTAL_SSID, true);
     });
     wifiManager.setSaveConfigCallback([]()
     {
@@ -380,13 +495,13 @@ void setup()
     if (doubleReset)
     {
         Serial.println("Double reset detected; clearing WiFi credentials");
-        g_display.displayMessage("WiFi reset...");
+        showSetupStatus("WiFi reset...", true);
         wifiManager.resetSettings();
         wifiConnected = wifiManager.startConfigPortal(WiFiConfiguration::PORTAL_SSID, WiFiConfiguration::PORTAL_PASSWORD);
     }
     else
     {
-        g_display.displayMessage("WiFi connect");
+        showSetupStatus("WiFi connect");
         wifiConnected = wifiManager.autoConnect(WiFiConfiguration::PORTAL_SSID, WiFiConfiguration::PORTAL_PASSWORD);
 
         if (!wifiConnected)
@@ -394,7 +509,7 @@ void setup()
             Serial.print("Stored WiFi failed; status=");
             Serial.println((int)WiFi.status());
             Serial.println("Opening portal...");
-            g_display.displayMessage("Portal ready");
+            showSetupStatus("Portal ready", true);
             wifiConnected = wifiManager.startConfigPortal(WiFiConfiguration::PORTAL_SSID, WiFiConfiguration::PORTAL_PASSWORD);
         }
     }
@@ -409,17 +524,13 @@ void setup()
     {
         Serial.print("WiFi connected: ");
         Serial.println(WiFi.localIP());
-        g_display.displayMessage(String("WiFi OK ") + WiFi.localIP().toString());
+        showSetupStatus(String("WiFi OK ") + WiFi.localIP().toString());
 
         // Set timezone from runtime settings (POSIX string) and start NTP sync
         configTzTime(RuntimeSettings::current().timezonePosix.c_str(), "pool.ntp.org", "time.nist.gov");
 
-        // Show logo/text once WiFi is up
-        g_display.displayStartup();
-        delay(5000);
-
-        delay(1000);
-        g_display.showLoading();
+        // Resolve API hosts now so the first fetches connect from cache
+        DnsCache::prewarm();
 
         // Start settings portal (MDNS + HTTP)
         startSettingsServer();
@@ -429,7 +540,7 @@ void setup()
         Serial.print("WiFi not connected; status=");
         Serial.println((int)WiFi.status());
         Serial.println("Proceeding without network");
-        g_display.displayMessage(String("WiFi FAIL"));
+        showSetupStatus(String("WiFi FAIL"));
     }
 
     g_fetcher = new FlightDataFetcher(&g_openSky, &g_aeroApi);
@@ -444,32 +555,52 @@ void setup()
             &g_fetchTaskHandle,
             APP_CPU_NUM);
     }
+
+    // Hand the display to loop(); a still-running boot animation continues from there
+    // while the first fetch is already in flight.
+    TaskHandle_t bootAnim = g_bootAnimTaskHandle;
+    g_setupDone = true;
+    if (bootAnim)
+    {
+        // The task never deletes itself, so the handle stays valid until we do.
+        xTaskNotifyGive(bootAnim);
+        xSemaphoreTake(g_bootAnimDone, portMAX_DELAY);
+        g_bootAnimTaskHandle = nullptr;
+        vTaskDelete(bootAnim);
+    }
 }
 
 void loop()
 {
     serviceDoubleResetWindow();
 
-    const unsigned long now = millis();
-
-    // Copy latest flights under mutex to avoid blocking display during fetch
-    std::vector<FlightInfo> flightsCopy;
+    // Copy flights and weather under the mutex only when the fetch task published something new
+    static std::vector<FlightInfo> flightsCopy;
+    static uint32_t seenGeneration = 0;
+    static uint32_t seenStatesGeneration = 0;
+    bool dataChanged = false;
     if (g_flightsMutex && xSemaphoreTake(g_flightsMutex, pdMS_TO_TICKS(5)))
     {
-        flightsCopy = g_lastFlights;
+        if (g_dataGeneration != seenGeneration)
+        {
+            seenGeneration = g_dataGeneration;
+            flightsCopy = g_lastFlights;
+            if (g_statesGeneration != seenStatesGeneration)
+            {
+                seenStatesGeneration = g_statesGeneration;
+                g_display.updateTraffic(g_lastStates, g_lastFlights);
+            }
+            g_display.updateWeather(g_lastWeather);
+            dataChanged = true;
+        }
         xSemaphoreGive(g_flightsMutex);
     }
-    else
-    {
-        flightsCopy = g_lastFlights; // fallback if mutex unavailable
-    }
 
-    // Refresh display frequently so scrolling/cycling can progress independently of fetch cadence
-    static unsigned long lastDisplayTickMs = 0;
-    const unsigned long DISPLAY_TICK_MS = 25; // ~40 FPS
-    if (now - lastDisplayTickMs >= DISPLAY_TICK_MS)
+    // Render only when the data changed or the current screen has a step due (marquee,
+    // cycle, clock colon); otherwise the panel keeps showing the last frame.
+    const unsigned long now = millis();
+    if (dataChanged || g_display.msUntilNextChange(now) == 0)
     {
-        lastDisplayTickMs = now;
         g_display.displayFlights(flightsCopy);
     }
     if (g_serverActive)
@@ -483,5 +614,17 @@ void loop()
             g_serverActive = false;
         }
     }
-    delay(10);
+
+    // Sleep until the next scheduled change; a publish from the fetch task wakes us early.
+    // The settings server is polled, so keep the wait short while it is up.
+    unsigned long waitMs = g_display.msUntilNextChange(millis());
+    if (g_serverActive && waitMs > 10)
+    {
+        waitMs = 10;
+    }
+    if (waitMs == 0)
+    {
+        waitMs = 1; // always yield at least one tick
+    }
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(waitMs));
 }
@@ -0,0 +1,363 @@
+/*
+Purpose: Host tests for utils/ApiHttpClient against a local fault-injecting server
+(pio test -e host_test).
+Responsibilities:
+- Circuit breaker: opens on 5xx, 429 and dropped connections, rejects while open, lets
+  exactly one half-open probe through, and closes on the probe's success.
+- Backoff: doubling from the host's base delay with equal jitter, capped at its maximum.
+- Retry-After and X-Rate-Limit-Retry-After-Seconds override the backoff.
+- Scheduler deadline: skipped without touching the breaker, and clamps the timeout.
+- OpenSkyFetcher refreshes its token once on a 401 and retries with the new bearer.
+- readBody() reads a gzip body in full, not just its compressed Content-Length.
+- A state body whose gzip trailer fails after the JSON has parsed is discarded.
+*/
+#include <Arduino.h>
+#include <unity.h>
+#include <WiFi.h>
+#include <zlib.h>
+#include "host/HostHttpServer.h"
+#include "adapters/OpenSkyFetcher.h"
+#include "config/RuntimeSettings.h"
+#include "utils/ApiHttpClient.h"
+
+namespace
+{
+    using ApiHttp::BreakerState;
+    using ApiHttp::Host;
+    using Reply = HostHttpServer::Reply;
+
+    HostHttpServer server;
+
+    Reply reply(int status, const char *headers = "", const char *body = "")
+    {
+        Reply r;
+        r.status = status;
+        r.headers = headers;
+        r.body = body;
+        return r;
+    }
+
+    int send(Host host)
+    {
+        WiFiClient client;
+        ApiHttp::Request request(host, client);
+        request.setUrl("http://%s/probe", ApiHttp::hostName(host));
+        request.setTimeout(2000);
+        return request.get();
+    }
+
+    // Lets the backoff run out and closes the breaker with a successful probe.
+    void recover(Host host)
+    {
+        const ApiHttp::HostHealth &h = ApiHttp::health(host);
+        if (h.state == BreakerState::Closed)
+            return;
+        hostAdvanceMillis(h.openForMs);
+        server.push(reply(200));
+        TEST_ASSERT_EQUAL(200, send(host));
+        TEST_ASSERT_EQUAL(BreakerState::Closed, h.state);
+    }
+
+    std::string gzip(const std::string &plain)
+    {
+        z_stream z = {};
+        TEST_ASSERT_EQUAL(Z_OK, deflateInit2(&z, 6, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY));
+        std::string out(deflateBound(&z, plain.size()), '\0');
+        z.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(plain.data()));
+        z.avail_in = (uInt)plain.size();
+        z.next_out = reinterpret_cast<Bytef *>(&out[0]);
+        z.avail_out = (uInt)out.size();
+        TEST_ASSERT_EQUAL(Z_STREAM_END, deflate(&z, Z_FINISH));
+        out.resize(z.total_out);
+        deflateEnd(&z);
+        return out;
+    }
+
+    void assertOpenFor(Host host, unsigned long minMs, unsigned long maxMs)
+    {
+        const ApiHttp::HostHealth &h = ApiHttp::health(host);
+        TEST_ASSERT_EQUAL(BreakerState::Open, h.state);
+        TEST_ASSERT_TRUE(h.openForMs >= minMs);
+        TEST_ASSERT_TRUE(h.openForMs <= maxMs);
+    }
+}
+
+void setUp()
+{
+    ApiHttp::setDeadline(0);
+}
+
+void tearDown()
+{
+    for (size_t i = 0; i < (size_t)Host::Count; ++i)
+        recover((Host)i);
+}
+
+void test_server_error_opens_the_breaker()
+{
+    server.push(reply(503));
+    TEST_ASSERT_EQUAL(503, send(Host::AeroApi));
+    const ApiHttp::HostHealth &h = ApiHttp::health(Host::AeroApi);
+    TEST_ASSERT_EQUAL(1, h.consecutiveFailures);
+    assertOpenFor(Host::AeroApi, 2500, 5000); // base 5 s, equal jitter
+    TEST_ASSERT_FALSE(ApiHttp::available(Host::AeroApi));
+
+    const size_t before = server.requestCount();
+    TEST_ASSERT_EQUAL(ApiHttp::Request::kRejected, send(Host::AeroApi));
+    TEST_ASSERT_EQUAL(before, server.requestCount());
+
+    // Other hosts keep their own breakers.
+    TEST_ASSERT_TRUE(ApiHttp::available(Host::OpenMeteo));
+}
+
+void test_half_open_admits_one_probe()
+{
+    server.push(reply(503));
+    TEST_ASSERT_EQUAL(503, send(Host::OpenMeteo));
+    hostAdvanceMillis(ApiHttp::health(Host::OpenMeteo).openForMs - 1);
+    TEST_ASSERT_FALSE(ApiHttp::available(Host::OpenMeteo));
+    hostAdvanceMillis(1);
+    TEST_ASSERT_TRUE(ApiHttp::available(Host::OpenMeteo));
+
+    // While the probe is on the wire the host reads half-open and a second request is
+    // turned away without reaching the server.
+    BreakerState duringProbe = BreakerState::Closed;
+    bool availableDuringProbe = true;
+    int secondRequest = 0;
+    Reply probe = reply(200);
+    probe.onRequest = [&]
+    {
+        duringProbe = ApiHttp::health(Host::OpenMeteo).state;
+        availableDuringProbe = ApiHttp::available(Host::OpenMeteo);
+        secondRequest = send(Host::OpenMeteo);
+    };
+    server.push(probe);
+    const size_t before = server.requestCount();
+    TEST_ASSERT_EQUAL(200, send(Host::OpenMeteo));
+    TEST_ASSERT_EQUAL(BreakerState::HalfOpen, duringProbe);
+    TEST_ASSERT_FALSE(availableDuringProbe);
+    TEST_ASSERT_EQUAL(ApiHttp::Request::kRejected, secondRequest);
+    TEST_ASSERT_EQUAL(before + 1, server.requestCount());
+
+    const ApiHttp::HostHealth &h = ApiHttp::health(Host::OpenMeteo);
+    TEST_ASSERT_EQUAL(BreakerState::Closed, h.state);
+    TEST_ASSERT_EQUAL(0, h.consecutiveFailures);
+    TEST_ASSERT_EQUAL(0, h.openForMs);
+}
+
+void test_failed_probe_reopens_with_a_longer_backoff()
+{
+    server.push(reply(500));
+    TEST_ASSERT_EQUAL(500, send(Host::OpenMeteo));
+    hostAdvanceMillis(ApiHttp::health(Host::OpenMeteo).openForMs);
+    server.push(reply(502));
+    TEST_ASSERT_EQUAL(502, send(Host::OpenMeteo));
+    TEST_ASSERT_EQUAL(2, ApiHttp::health(Host::OpenMeteo).consecutiveFailures);
+    assertOpenFor(Host::OpenMeteo, 15000, 30000);
+}
+
+void test_backoff_doubles_with_equal_jitter_up_to_the_cap()
+{
+    // AeroAPI: 5 s base, 120 s cap.
+    // Equal jitter: every delay lies in [full / 2, full], and they do not all sit on an edge.
+    bool aboveHalf = false;
+    bool belowFull = false;
+    for (unsigned failures = 1; failures <= 8; ++failures)
+    {
+        if (failures > 1)
+            hostAdvanceMillis(ApiHttp::health(Host::AeroApi).openForMs);
+        server.push(reply(500));
+        TEST_ASSERT_EQUAL(500, send(Host::AeroApi));
+
+        const unsigned long full = std::min(5000UL << (failures - 1), 120000UL);
+        TEST_ASSERT_EQUAL(failures, ApiHttp::health(Host::AeroApi).consecutiveFailures);
+        assertOpenFor(Host::AeroApi, full / 2, full);
+        aboveHalf |= ApiHttp::health(Host::AeroApi).openForMs > full / 2;
+        belowFull |= ApiHttp::health(Host::AeroApi).openForMs < full;
+    }
+    TEST_ASSERT_TRUE(aboveHalf);
+    TEST_ASSERT_TRUE(belowFull);
+}
+
+void test_retry_after_overrides_the_backoff()
+{
+    server.push(reply(429, "Retry-After: 42\r\n"));
+    TEST_ASSERT_EQUAL(429, send(Host::OpenMeteo));
+    assertOpenFor(Host::OpenMeteo, 42000, 42000);
+    recover(Host::OpenMeteo);
+
+    // OpenSky's own header wins over the standard one.
+    server.push(reply(503, "X-Rate-Limit-Retry-After-Seconds: 7\r\nRetry-After: 42\r\n"));
+    TEST_ASSERT_EQUAL(503, send(Host::OpenSky));
+    assertOpenFor(Host::OpenSky, 7000, 7000);
+    recover(Host::OpenSky);
+
+    // HTTP-date values are not parsed; the jittered backoff applies.
+    server.push(reply(429, "Retry-After: Wed, 21 Oct 2015 07:28:00 GMT\r\n"));
+    TEST_ASSERT_EQUAL(429, send(Host::OpenMeteo));
+    assertOpenFor(Host::OpenMeteo, 7500, 15000);
+}
+
+void test_rate_limit_remaining_is_recorded()
+{
+    server.push(reply(200, "X-Rate-Limit-Remaining: 399\r\n"));
+    TEST_ASSERT_EQUAL(200, send(Host::OpenSky));
+    TEST_ASSERT_EQUAL(399, ApiHttp::health(Host::OpenSky).rateLimitRemaining);
+}
+
+void test_client_errors_leave_the_breaker_closed()
+{
+    server.push(reply(404));
+    TEST_ASSERT_EQUAL(404, send(Host::AeroApi));
+    server.push(reply(401));
+    TEST_ASSERT_EQUAL(401, send(Host::AeroApi));
+    TEST_ASSERT_EQUAL(BreakerState::Closed, ApiHttp::health(Host::AeroApi).state);
+    TEST_ASSERT_EQUAL(0, ApiHttp::health(Host::AeroApi).consecutiveFailures);
+}
+
+void test_dropped_connection_counts_as_a_failure()
+{
+    Reply dropped;
+    dropped.mode = Reply::Mode::Close;
+    server.push(dropped);
+    TEST_ASSERT_EQUAL(HTTPC_ERROR_CONNECTION_LOST, send(Host::AeroApi));
+    TEST_ASSERT_EQUAL(1, ApiHttp::health(Host::AeroApi).consecutiveFailures);
+    assertOpenFor(Host::AeroApi, 2500, 5000);
+}
+
+void test_passed_deadline_skips_without_touching_the_breaker()
+{
+    const size_t before = server.requestCount();
+    ApiHttp::setDeadline(millis());
+    TEST_ASSERT_EQUAL(ApiHttp::Request::kDeadlineExceeded, send(Host::AeroApi));
+    TEST_ASSERT_EQUAL(before, server.requestCount());
+    TEST_ASSERT_EQUAL(BreakerState::Closed, ApiHttp::health(Host::AeroApi).state);
+
+    ApiHttp::setDeadline(millis() + 1500);
+    server.push(reply(200));
+    WiFiClient client;
+    ApiHttp::Request request(Host::AeroApi, client);
+    request.setUrl("http://%s/probe", ApiHttp::hostName(Host::AeroApi));
+    request.setTimeout(15000);
+    TEST_ASSERT_EQUAL(200, request.get());
+    TEST_ASSERT_EQUAL(1500, request.timeoutMs());
+}
+
+// An OpenSky states/all body with one aircraft at the query center.
+const char *kStatesBody =
+    "{\"time\":1717243200,\"states\":[[\"3c6444\",\"DLH438  \",\"Germany\",1717243195,"
+    "1717243199,8.5622,50.0379,3048.0,false,180.5,270.0,-5.2,null,3100.0,\"1000\",false,0]]}";
+
+void test_unauthorized_state_fetch_refreshes_the_token_once()
+{
+    server.push(reply(200, "", "{\"access_token\":\"first\",\"expires_in\":1800}"));
+    server.push(reply(401));
+    server.push(reply(200, "", "{\"access_token\":\"second\",\"expires_in\":1800}"));
+    server.push(reply(200, "", kStatesBody));
+    const size_t before = server.requestCount();
+
+    OpenSkyFetcher fetcher;
+    std::vector<StateVector> states;
+    TEST_ASSERT_TRUE(fetcher.fetchStateVectors(50.0379, 8.5622, 20.0, states));
+    TEST_ASSERT_EQUAL(1, states.size());
+    TEST_ASSERT_EQUAL_STRING("DLH438", states[0].callsign.c_str());
+
+    const std::vector<HostHttpServer::Received> seen = server.received();
+    TEST_ASSERT_EQUAL(before + 4, seen.size());
+    TEST_ASSERT_EQUAL_STRING("POST", seen[before].method.c_str());
+    TEST_ASSERT_TRUE(seen[before].body.find("grant_type=client_credentials") == 0);
+    TEST_ASSERT_EQUAL_STRING("Bearer first", seen[before + 1].headers.at("authorization").c_str());
+    TEST_ASSERT_EQUAL_STRING("POST", seen[before + 2].method.c_str());
+    TEST_ASSERT_EQUAL_STRING("Bearer second", seen[before + 3].headers.at("authorization").c_str());
+    TEST_ASSERT_TRUE(seen[before + 3].path.find("/api/states/all?lamin=") == 0);
+
+    // A 401 proves the host is up; it never counts against the breaker.
+    TEST_ASSERT_EQUAL(BreakerState::Closed, ApiHttp::health(Host::OpenSky).state);
+}
+
+void test_second_unauthorized_gives_up()
+{
+    server.push(reply(200, "", "{\"access_token\":\"stale\",\"expires_in\":1800}"));
+    server.push(reply(401));
+    server.push(reply(200, "", "{\"access_token\":\"rejected\",\"expires_in\":1800}"));
+    server.push(reply(401));
+    const size_t before = server.requestCount();
+
+    OpenSkyFetcher fetcher;
+    std::vector<StateVector> states;
+    TEST_ASSERT_FALSE(fetcher.fetchStateVectors(50.0379, 8.5622, 20.0, states));
+    TEST_ASSERT_EQUAL(0, states.size());
+    TEST_ASSERT_EQUAL(before + 4, server.requestCount());
+}
+
+void test_read_body_reads_an_inflated_body_past_its_content_length()
+{
+    const std::string plain(600, 'x');
+    Reply compressed = reply(200, "Content-Encoding: gzip\r\n");
+    compressed.body = gzip(plain);
+    TEST_ASSERT_TRUE(compressed.body.size() < 100);
+    server.push(compressed);
+    server.push(reply(200, "", plain.c_str()));
+
+    char buffer[1024];
+    for (int i = 0; i < 2; ++i)
+    {
+        WiFiClient client;
+        ApiHttp::Request request(Host::OpenMeteo, client);
+        request.setUrl("http://%s/forecast", ApiHttp::hostName(Host::OpenMeteo));
+        request.setTimeout(2000);
+        TEST_ASSERT_EQUAL(200, request.get());
+        TEST_ASSERT_EQUAL(plain.size(), request.readBody(buffer, sizeof(buffer)));
+        TEST_ASSERT_TRUE(plain == buffer);
+        request.end();
+    }
+}
+
+void test_corrupt_gzip_state_body_is_discarded()
+{
+    // Trailing whitespace puts the trailer well past the end of the JSON the parser reads.
+    const std::string compressed = gzip(std::string(kStatesBody) + std::string(40000, ' '));
+    for (int corrupt = 0; corrupt < 2; ++corrupt)
+    {
+        Reply states = reply(200, "Content-Encoding: gzip\r\n");
+        states.body = compressed;
+        if (corrupt)
+            states.body[states.body.size() - 8] ^= 0x01;
+        server.push(reply(200, "", "{\"access_token\":\"token\",\"expires_in\":1800}"));
+        server.push(states);
+
+        OpenSkyFetcher fetcher;
+        std::vector<StateVector> parsed;
+        TEST_ASSERT_EQUAL(!corrupt, fetcher.fetchStateVectors(50.0379, 8.5622, 20.0, parsed));
+        TEST_ASSERT_EQUAL(corrupt ? 0 : 1, parsed.size());
+    }
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    if (!server.start())
+        return 1;
+    hostNetRedirect(server.port());
+    hostSetMillis(1000000);
+    RuntimeSettings::load();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_server_error_opens_the_breaker);
+    RUN_TEST(test_half_open_admits_one_probe);
+    RUN_TEST(test_failed_probe_reopens_with_a_longer_backoff);
+    RUN_TEST(test_backoff_doubles_with_equal_jitter_up_to_the_cap);
+    RUN_TEST(test_retry_after_overrides_the_backoff);
+    RUN_TEST(test_rate_limit_remaining_is_recorded);
+    RUN_TEST(test_client_errors_leave_the_breaker_closed);
+    RUN_TEST(test_dropped_connection_counts_as_a_failure);
+    RUN_TEST(test_passed_deadline_skips_without_touching_the_breaker);
+    RUN_TEST(test_unauthorized_state_fetch_refreshes_the_token_once);
+    RUN_TEST(test_second_unauthorized_gives_up);
+    RUN_TEST(test_read_body_reads_an_inflated_body_past_its_content_length);
+    RUN_TEST(test_corrupt_gzip_state_body_is_discarded);
+    const int failures = UNITY_END();
+    server.stop();
+    return failures;
+}
@@ -0,0 +1,156 @@
+/*
+Purpose: Host tests for utils/ClosestApproach and the shared projection in utils/GeoUtils
+(pio test -e host_test).
+Responsibilities:
+- Approaching geometries: head-on, crossing ahead, passing abeam.
+- Aircraft moving away, passes beyond the horizon, aircraft on the ground or without
+  a position or velocity.
+- Ranking by predicted pass.
+*/
+#include <Arduino.h>
+#include <unity.h>
+#include <vector>
+#include "utils/ClosestApproach.h"
+#include "utils/GeoUtils.h"
+
+namespace
+{
+    // An aircraft distanceKm from the center in the direction bearingDeg, flying trackDeg
+    // at speedMps.
+    StateVector aircraft(double distanceKm, double bearingDeg, double trackDeg, double speedMps)
+    {
+        StateVector s;
+        s.icao24 = "abc123";
+        s.distance_km = distanceKm;
+        s.bearing_deg = bearingDeg;
+        s.heading = trackDeg;
+        s.velocity = speedMps;
+        return s;
+    }
+
+    StateVector predicted(StateVector s)
+    {
+        std::vector<StateVector> states = {s};
+        ClosestApproach::predict(states);
+        return states[0];
+    }
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_projection_axes()
+{
+    float e = 0, n = 0;
+    polarToEastNorth(10.0f, 0.0f, e, n);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 0.0, e);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 10.0, n);
+    polarToEastNorth(10.0f, 90.0f, e, n);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 10.0, e);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 0.0, n);
+    polarToEastNorth(2.0f, 225.0f, e, n);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, -sqrt(2.0), e);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, -sqrt(2.0), n);
+}
+
+void test_head_on_passes_overhead()
+{
+    // 10 km north, flying south at 200 m/s: overhead in 50 s.
+    const StateVector s = predicted(aircraft(10.0, 0.0, 180.0, 200.0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 0.0, s.cpa_distance_km);
+    TEST_ASSERT_FLOAT_WITHIN(1e-2, 50.0, s.cpa_time_s);
+}
+
+void test_crossing_ahead()
+{
+    // 10 km north flying south-east: the pass is 10 km * sin(45) away, 70.7 s from now.
+    const StateVector s = predicted(aircraft(10.0, 0.0, 135.0, 100.0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 7.0711, s.cpa_distance_km);
+    TEST_ASSERT_FLOAT_WITHIN(1e-2, 70.711, s.cpa_time_s);
+}
+
+void test_abeam_is_closest_now()
+{
+    // 10 km west flying north: the aircraft is abeam, so the pass is now.
+    const StateVector s = predicted(aircraft(10.0, 270.0, 0.0, 150.0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 10.0, s.cpa_distance_km);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 0.0, s.cpa_time_s);
+}
+
+void test_moving_away_keeps_current_distance()
+{
+    // 8 km east flying east, and 5 km south flying south-west: both only get farther.
+    const StateVector east = predicted(aircraft(8.0, 90.0, 90.0, 230.0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 8.0, east.cpa_distance_km);
+    TEST_ASSERT_EQUAL(0, east.cpa_time_s);
+    const StateVector south = predicted(aircraft(5.0, 180.0, 225.0, 120.0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 5.0, south.cpa_distance_km);
+    TEST_ASSERT_EQUAL(0, south.cpa_time_s);
+}
+
+void test_pass_beyond_horizon_is_clamped()
+{
+    // 100 km north flying south at 50 m/s would pass overhead in 2000 s; the prediction
+    // stops at the horizon, where it is still 100 - 0.05 * 600 = 70 km out.
+    const StateVector s = predicted(aircraft(100.0, 0.0, 180.0, 50.0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, ClosestApproach::kHorizonS, s.cpa_time_s);
+    TEST_ASSERT_FLOAT_WITHIN(1e-2, 100.0 - 0.05 * ClosestApproach::kHorizonS, s.cpa_distance_km);
+}
+
+void test_on_ground_and_unknown_velocity_stay_put()
+{
+    StateVector taxiing = aircraft(3.0, 45.0, 225.0, 15.0);
+    taxiing.on_ground = true;
+    StateVector noTrack = aircraft(6.0, 45.0, NAN, 200.0);
+    StateVector noSpeed = aircraft(7.0, 45.0, 225.0, NAN);
+    StateVector stopped = aircraft(9.0, 45.0, 225.0, 0.0);
+    std::vector<StateVector> states = {taxiing, noTrack, noSpeed, stopped};
+    ClosestApproach::predict(states);
+    const double expected[] = {3.0, 6.0, 7.0, 9.0};
+    for (size_t i = 0; i < states.size(); ++i)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(1e-6, expected[i], states[i].cpa_distance_km);
+        TEST_ASSERT_EQUAL(0, states[i].cpa_time_s);
+    }
+}
+
+void test_no_position_has_no_prediction()
+{
+    const StateVector s = predicted(aircraft(NAN, NAN, 180.0, 200.0));
+    TEST_ASSERT_FLOAT_IS_NAN(s.cpa_distance_km);
+    TEST_ASSERT_FLOAT_IS_NAN(s.cpa_time_s);
+}
+
+void test_ranking_by_pass_then_time()
+{
+    std::vector<StateVector> states = {
+        aircraft(NAN, NAN, 0.0, 100.0),    // unknown: last
+        aircraft(8.0, 90.0, 90.0, 230.0),  // receding at 8 km
+        aircraft(20.0, 0.0, 180.0, 200.0), // overhead in 100 s
+        aircraft(10.0, 0.0, 180.0, 200.0), // overhead in 50 s
+    };
+    ClosestApproach::predict(states);
+    TEST_ASSERT_TRUE(ClosestApproach::before(states[3], states[2]));
+    TEST_ASSERT_FALSE(ClosestApproach::before(states[2], states[3]));
+    TEST_ASSERT_TRUE(ClosestApproach::before(states[2], states[1]));
+    TEST_ASSERT_TRUE(ClosestApproach::before(states[1], states[0]));
+    TEST_ASSERT_FALSE(ClosestApproach::before(states[0], states[1]));
+    TEST_ASSERT_FALSE(ClosestApproach::before(states[0], states[0]));
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_projection_axes);
+    RUN_TEST(test_head_on_passes_overhead);
+    RUN_TEST(test_crossing_ahead);
+    RUN_TEST(test_abeam_is_closest_now);
+    RUN_TEST(test_moving_away_keeps_current_distance);
+    RUN_TEST(test_pass_beyond_horizon_is_clamped);
+    RUN_TEST(test_on_ground_and_unknown_velocity_stay_put);
+    RUN_TEST(test_no_position_has_no_prediction);
+    RUN_TEST(test_ranking_by_pass_then_time);
+    return UNITY_END();
+}
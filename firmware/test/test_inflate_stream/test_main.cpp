@@ -0,0 +1,512 @@
+/*
+Purpose: Host harness for utils/InflateStream (pio test -e host_test).
+Responsibilities:
+- Round-trip OpenSky- and AeroAPI-shaped bodies through gzip and zlib and back.
+- A corrupt or missing gzip trailer and a truncated body fail instead of passing as data,
+  including a trailer that arrives after every byte of output has been handed out.
+- Report wall time and peak heap for reading each body inflated vs. plain, the cost
+  FW_HTTP_GZIP=1 trades for the bytes it saves on the link.
+Notes: Payloads follow the documented response shapes with seeded values, not captures.
+The host inflater is zlib behind the ROM's tinfl calls, so times and the decompressor's
+size are host figures; the 32 KB window is the same on the device.
+*/
+#include <Arduino.h>
+#include <unity.h>
+#include <malloc.h>
+#include <zlib.h>
+#include <string>
+#include "utils/InflateStream.h"
+
+#if defined(__GLIBC__)
+extern "C"
+{
+    void *__libc_malloc(size_t size);
+    void *__libc_calloc(size_t count, size_t size);
+    void *__libc_realloc(void *ptr, size_t size);
+    void __libc_free(void *ptr);
+}
+#endif
+
+namespace
+{
+    // Heap accounting for the window between heapTrackBegin() and heapTrackEnd(); single-threaded.
+    bool g_heapTracking = false;
+    long g_heapLive = 0;
+    long g_heapPeak = 0;
+
+    void heapTrackBegin()
+    {
+        g_heapLive = g_heapPeak = 0;
+        g_heapTracking = true;
+    }
+
+    long heapTrackEnd()
+    {
+        g_heapTracking = false;
+        return g_heapPeak;
+    }
+
+    void heapAdd(void *ptr)
+    {
+        if (!g_heapTracking || ptr == nullptr)
+            return;
+        g_heapLive += (long)malloc_usable_size(ptr);
+        if (g_heapLive > g_heapPeak)
+            g_heapPeak = g_heapLive;
+    }
+
+    void heapRemove(void *ptr)
+    {
+        if (g_heapTracking && ptr != nullptr)
+            g_heapLive -= (long)malloc_usable_size(ptr);
+    }
+
+    uint32_t g_seed = 0x2545f491u;
+
+    uint32_t nextRandom()
+    {
+        g_seed ^= g_seed << 13;
+        g_seed ^= g_seed >> 17;
+        g_seed ^= g_seed << 5;
+        return g_seed;
+    }
+
+    // /api/states/all for a bounding box: 17-field state vectors.
+    std::string openSkyBody(int states)
+    {
+        static const char *const kCountries[] = {"Germany", "United Kingdom", "France", "Netherlands", "Ireland", "Switzerland"};
+        static const char *const kPrefixes[] = {"DLH", "BAW", "AFR", "KLM", "RYR", "SWR", "EZY", "UAE"};
+        std::string body = "{\"time\":1717243200,\"states\":[";
+        char row[256];
+        for (int i = 0; i < states; ++i)
+        {
+            const uint32_t r = nextRandom();
+            const bool onGround = (r & 31) == 0;
+            snprintf(row, sizeof(row),
+                     "%s[\"%06x\",\"%s%-4u \",\"%s\",%u,%u,%.4f,%.4f,%s,%s,%.2f,%.1f,%s,null,%s,\"%04o\",false,0]",
+                     i ? "," : "",
+                     (unsigned)(0x300000 + (r & 0xfffff)),
+                     kPrefixes[r % 8],
+                     (unsigned)(nextRandom() % 9000 + 100),
+                     kCountries[(r >> 8) % 6],
+                     1717243190u + (unsigned)(r % 10),
+                     1717243195u + (unsigned)(r % 5),
+                     8.0 + (nextRandom() % 20000) / 10000.0,
+                     50.0 + (nextRandom() % 15000) / 10000.0,
+                     onGround ? "null" : std::to_string(300 + nextRandom() % 11000).append(".84").c_str(),
+                     onGround ? "true" : "false",
+                     onGround ? 4.12 : 120.0 + (nextRandom() % 13000) / 100.0,
+                     (nextRandom() % 3600) / 10.0,
+                     onGround ? "null" : (nextRandom() & 1 ? "0" : "-6.18"),
+                     onGround ? "null" : std::to_string(330 + nextRandom() % 11200).append(".6").c_str(),
+                     (unsigned)(nextRandom() & 07777));
+            body += row;
+        }
+        body += "]}";
+        return body;
+    }
+
+    // /aeroapi/flights/{ident}: the recent and scheduled legs of one flight number.
+    std::string aeroApiBody(int flights)
+    {
+        std::string body = "{\"links\":null,\"num_pages\":1,\"flights\":[";
+        char leg[2048];
+        for (int i = 0; i < flights; ++i)
+        {
+            const unsigned day = 10 + (unsigned)i;
+            const unsigned minute = nextRandom() % 60;
+            snprintf(leg, sizeof(leg),
+                     "%s{\"ident\":\"BAW286\",\"ident_icao\":\"BAW286\",\"ident_iata\":\"BA286\","
+                     "\"actual_runway_off\":\"2024-06-%02uT20:%02u:00Z\",\"actual_runway_on\":null,"
+                     "\"fa_flight_id\":\"BAW286-17172%05u-schedule-0%03u\",\"operator\":\"BAW\","
+                     "\"operator_icao\":\"BAW\",\"operator_iata\":\"BA\",\"flight_number\":\"286\","
+                     "\"registration\":\"G-XWB%c\",\"atc_ident\":null,\"inbound_fa_flight_id\":\"BAW285-17171%05u-schedule-0%03u\","
+                     "\"codeshares\":[\"AAL7112\",\"IBE7395\"],\"codeshares_iata\":[\"AA7112\",\"IB7395\"],"
+                     "\"blocked\":false,\"diverted\":false,\"cancelled\":false,\"position_only\":false,"
+                     "\"origin\":{\"code\":\"KSFO\",\"code_icao\":\"KSFO\",\"code_iata\":\"SFO\",\"code_lid\":\"SFO\","
+                     "\"timezone\":\"America/Los_Angeles\",\"name\":\"San Francisco Int'l\",\"city\":\"San Francisco\","
+                     "\"airport_info_url\":\"/airports/KSFO\"},"
+                     "\"destination\":{\"code\":\"EGLL\",\"code_icao\":\"EGLL\",\"code_iata\":\"LHR\",\"code_lid\":null,"
+                     "\"timezone\":\"Europe/London\",\"name\":\"London Heathrow\",\"city\":\"London\","
+                     "\"airport_info_url\":\"/airports/EGLL\"},"
+                     "\"departure_delay\":%u,\"arrival_delay\":%d,\"filed_ete\":37800,\"progress_percent\":%u,"
+                     "\"status\":\"%s\",\"aircraft_type\":\"A35K\",\"route_distance\":5369,"
+                     "\"filed_airspeed\":486,\"filed_altitude\":null,\"route\":null,\"baggage_claim\":null,"
+                     "\"seats_cabin_business\":56,\"seats_cabin_coach\":235,\"seats_cabin_first\":null,"
+                     "\"gate_origin\":\"A%u\",\"gate_destination\":null,\"terminal_origin\":\"I\",\"terminal_destination\":\"5\","
+                     "\"type\":\"Airline\",\"scheduled_out\":\"2024-06-%02uT20:00:00Z\",\"estimated_out\":\"2024-06-%02uT20:%02u:00Z\","
+                     "\"actual_out\":\"2024-06-%02uT20:%02u:00Z\",\"scheduled_off\":\"2024-06-%02uT20:10:00Z\","
+                     "\"estimated_off\":\"2024-06-%02uT20:%02u:00Z\",\"actual_off\":null,"
+                     "\"scheduled_on\":\"2024-06-%02uT06:40:00Z\",\"estimated_on\":\"2024-06-%02uT06:%02u:00Z\",\"actual_on\":null,"
+                     "\"scheduled_in\":\"2024-06-%02uT06:55:00Z\",\"estimated_in\":\"2024-06-%02uT07:%02u:00Z\",\"actual_in\":null,"
+                     "\"foresight_predictions_available\":true}",
+                     i ? "," : "",
+                     day, minute,
+                     (unsigned)(nextRandom() % 100000), (unsigned)(nextRandom() % 1000),
+                     (char)('A' + nextRandom() % 26),
+                     (unsigned)(nextRandom() % 100000), (unsigned)(nextRandom() % 1000),
+                     minute * 60, (int)(nextRandom() % 1800) - 900, i ? 100u : (unsigned)(nextRandom() % 100),
+                     i ? "Arrived / Gate Arrival" : "En Route / On Time",
+                     (unsigned)(nextRandom() % 12 + 1),
+                     day, day, minute, day, minute, day, day, minute,
+                     day + 1, day + 1, minute, day + 1, day + 1, minute);
+            body += leg;
+        }
+        body += "]}";
+        return body;
+    }
+
+    // windowBits 15 + 16 writes a gzip member, 15 a zlib stream; level 6 is the servers' usual.
+    std::string compress(const std::string &plain, int windowBits, gz_header *header = nullptr)
+    {
+        z_stream z = {};
+        TEST_ASSERT_EQUAL(Z_OK, deflateInit2(&z, 6, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY));
+        if (header != nullptr)
+            TEST_ASSERT_EQUAL(Z_OK, deflateSetHeader(&z, header));
+        std::string out(deflateBound(&z, plain.size()) + 64, '\0');
+        z.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(plain.data()));
+        z.avail_in = (uInt)plain.size();
+        z.next_out = reinterpret_cast<Bytef *>(&out[0]);
+        z.avail_out = (uInt)out.size();
+        TEST_ASSERT_EQUAL(Z_STREAM_END, deflate(&z, Z_FINISH));
+        out.resize(z.total_out);
+        deflateEnd(&z);
+        return out;
+    }
+
+    std::string gzip(const std::string &plain) { return compress(plain, 15 + 16); }
+
+    // All output is flushed before the (empty) final block, so the call that reaches the
+    // trailer produces nothing.
+    std::string gzipFlushedBeforeTrailer(const std::string &plain)
+    {
+        z_stream z = {};
+        TEST_ASSERT_EQUAL(Z_OK, deflateInit2(&z, 6, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY));
+        std::string out(deflateBound(&z, plain.size()) + 64, '\0');
+        z.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(plain.data()));
+        z.avail_in = (uInt)plain.size();
+        z.next_out = reinterpret_cast<Bytef *>(&out[0]);
+        z.avail_out = (uInt)out.size();
+        TEST_ASSERT_EQUAL(Z_OK, deflate(&z, Z_SYNC_FLUSH));
+        TEST_ASSERT_EQUAL(Z_STREAM_END, deflate(&z, Z_FINISH));
+        out.resize(z.total_out);
+        deflateEnd(&z);
+        return out;
+    }
+
+    // Hands out a body in socket-sized reads.
+    class MemoryStream : public Stream
+    {
+    public:
+        explicit MemoryStream(const std::string &data, size_t readBytesMax = 1460)
+            : m_data(data), m_readBytesMax(readBytesMax)
+        {
+        }
+
+        int available() override { return (int)(m_data.size() - m_pos); }
+        int read() override { return m_pos < m_data.size() ? (uint8_t)m_data[m_pos++] : -1; }
+        int peek() override { return m_pos < m_data.size() ? (uint8_t)m_data[m_pos] : -1; }
+        size_t readBytes(char *buffer, size_t length) override
+        {
+            size_t n = m_data.size() - m_pos;
+            if (n > length)
+                n = length;
+            if (n > m_readBytesMax)
+                n = m_readBytesMax;
+            memcpy(buffer, m_data.data() + m_pos, n);
+            m_pos += n;
+            return n;
+        }
+        size_t write(uint8_t) override { return 0; }
+
+    private:
+        const std::string &m_data;
+        size_t m_readBytesMax;
+        size_t m_pos = 0;
+    };
+
+    // Reads the way the JSON parsers do, in small pieces.
+    std::string drain(Stream &stream)
+    {
+        std::string out;
+        char buffer[64];
+        size_t got;
+        while ((got = stream.readBytes(buffer, sizeof(buffer))) > 0)
+            out.append(buffer, got);
+        return out;
+    }
+
+    std::string inflate(const std::string &compressed, InflateStream::Format format, bool &failed, size_t readBytesMax = 1460)
+    {
+        MemoryStream source(compressed, readBytesMax);
+        InflateStream stream;
+        if (!stream.begin(source, format))
+        {
+            failed = true;
+            return std::string();
+        }
+        std::string out = drain(stream);
+        failed = stream.failed();
+        TEST_ASSERT_EQUAL(compressed.size(), stream.compressedBytes());
+        return out;
+    }
+
+    void checkRoundTrip(const std::string &plain, InflateStream::Format format, const std::string &compressed)
+    {
+        bool failed = true;
+        const std::string out = inflate(compressed, format, failed);
+        TEST_ASSERT_FALSE(failed);
+        TEST_ASSERT_EQUAL(plain.size(), out.size());
+        TEST_ASSERT_TRUE(out == plain);
+    }
+
+    // Trailer bytes are the last eight of a gzip member: CRC32 then ISIZE.
+    void checkCorruptTrailerFails(size_t offsetFromEnd)
+    {
+        const std::string plain = openSkyBody(120);
+        std::string compressed = gzip(plain);
+        compressed[compressed.size() - offsetFromEnd] ^= 0x01;
+        bool failed = false;
+        const std::string out = inflate(compressed, InflateStream::Format::Gzip, failed);
+        TEST_ASSERT_TRUE(failed);
+        TEST_ASSERT_TRUE(out.size() < plain.size());
+    }
+
+    struct Measurement
+    {
+        double usPerBody = 0;
+        long peakHeapBytes = 0;
+    };
+
+    Measurement measure(const std::string &body, bool compressed, int runs)
+    {
+        Measurement m;
+        const unsigned long startUs = micros();
+        for (int run = 0; run < runs; ++run)
+        {
+            MemoryStream source(body);
+            char buffer[64];
+            size_t total = 0;
+            size_t got;
+            heapTrackBegin();
+            if (compressed)
+            {
+                InflateStream stream;
+                TEST_ASSERT_TRUE(stream.begin(source, InflateStream::Format::Gzip));
+                while ((got = stream.readBytes(buffer, sizeof(buffer))) > 0)
+                    total += got;
+                TEST_ASSERT_FALSE(stream.failed());
+            }
+            else
+            {
+                while ((got = source.readBytes(buffer, sizeof(buffer))) > 0)
+                    total += got;
+            }
+            const long peak = heapTrackEnd();
+            if (peak > m.peakHeapBytes)
+                m.peakHeapBytes = peak;
+            TEST_ASSERT_TRUE(total > 0);
+        }
+        m.usPerBody = (double)(micros() - startUs) / runs;
+        return m;
+    }
+
+    void benchmark(const char *name, const std::string &plain)
+    {
+        const std::string compressed = gzip(plain);
+        const int runs = 40;
+        const Measurement plainRun = measure(plain, false, runs);
+        const Measurement inflateRun = measure(compressed, true, runs);
+
+        printf("%-8s %6u B plain, %5u B gzip (%4.1f%%): plain %7.1f us, %6ld B heap; inflate %7.1f us, %6ld B heap\n",
+               name,
+               (unsigned)plain.size(),
+               (unsigned)compressed.size(),
+               100.0 * compressed.size() / plain.size(),
+               plainRun.usPerBody,
+               plainRun.peakHeapBytes,
+               inflateRun.usPerBody,
+               inflateRun.peakHeapBytes);
+
+        TEST_ASSERT_TRUE(compressed.size() < plain.size() / 2);
+#if defined(__GLIBC__)
+        TEST_ASSERT_EQUAL(0, plainRun.peakHeapBytes);
+        // The window and the decompressor are the whole cost; nothing grows with the body.
+        TEST_ASSERT_TRUE(inflateRun.peakHeapBytes >= (long)InflateStream::workingSetBytes());
+        TEST_ASSERT_TRUE(inflateRun.peakHeapBytes < (long)InflateStream::workingSetBytes() + 256);
+#endif
+    }
+}
+
+#if defined(__GLIBC__)
+extern "C"
+{
+    void *malloc(size_t size)
+    {
+        void *ptr = __libc_malloc(size);
+        heapAdd(ptr);
+        return ptr;
+    }
+
+    void *calloc(size_t count, size_t size)
+    {
+        void *ptr = __libc_calloc(count, size);
+        heapAdd(ptr);
+        return ptr;
+    }
+
+    void *realloc(void *ptr, size_t size)
+    {
+        heapRemove(ptr);
+        void *moved = __libc_realloc(ptr, size);
+        heapAdd(moved ? moved : ptr);
+        return moved;
+    }
+
+    void free(void *ptr)
+    {
+        heapRemove(ptr);
+        __libc_free(ptr);
+    }
+}
+#endif
+
+void setUp() {}
+void tearDown() {}
+
+void test_crc32_matches_zlib()
+{
+    // zlib wrote the trailer, so the stream only accepts the body if its CRC agrees.
+    const std::string plain = aeroApiBody(3);
+    std::string compressed = gzip(plain);
+    const uint32_t expected = crc32(0, reinterpret_cast<const Bytef *>(plain.data()), (uInt)plain.size());
+    const size_t at = compressed.size() - 8;
+    const uint32_t stored = (uint8_t)compressed[at] | ((uint8_t)compressed[at + 1] << 8) |
+                            ((uint8_t)compressed[at + 2] << 16) | ((uint32_t)(uint8_t)compressed[at + 3] << 24);
+    TEST_ASSERT_EQUAL_UINT32(expected, stored);
+    checkRoundTrip(plain, InflateStream::Format::Gzip, compressed);
+}
+
+void test_gzip_round_trips_opensky_and_aeroapi_bodies()
+{
+    const std::string states = openSkyBody(250);
+    checkRoundTrip(states, InflateStream::Format::Gzip, gzip(states));
+    const std::string flights = aeroApiBody(15);
+    checkRoundTrip(flights, InflateStream::Format::Gzip, gzip(flights));
+}
+
+void test_zlib_round_trips()
+{
+    const std::string states = openSkyBody(250);
+    checkRoundTrip(states, InflateStream::Format::Zlib, compress(states, 15));
+}
+
+void test_output_past_the_window_round_trips()
+{
+    // Several times the 32 KB window, so the output wraps and back-references cross the seam.
+    const std::string states = openSkyBody(1200);
+    TEST_ASSERT_TRUE(states.size() > 4 * InflateStream::kWindowBytes);
+    checkRoundTrip(states, InflateStream::Format::Gzip, gzip(states));
+}
+
+void test_trailer_split_across_reads_round_trips()
+{
+    // One-byte reads put the trailer outside whatever input the last inflate call saw.
+    const std::string plain = aeroApiBody(2);
+    bool failed = true;
+    const std::string out = inflate(gzip(plain), InflateStream::Format::Gzip, failed, 1);
+    TEST_ASSERT_FALSE(failed);
+    TEST_ASSERT_TRUE(out == plain);
+}
+
+void test_gzip_header_fields_are_skipped()
+{
+    const std::string plain = openSkyBody(40);
+    gz_header header = {};
+    unsigned char extra[] = {'F', 'W', 2, 0, 1, 2};
+    char name[] = "states.json";
+    char comment[] = "bbox 50,8,51.5,10";
+    header.extra = extra;
+    header.extra_len = sizeof(extra);
+    header.name = reinterpret_cast<Bytef *>(name);
+    header.comment = reinterpret_cast<Bytef *>(comment);
+    header.hcrc = 1;
+    checkRoundTrip(plain, InflateStream::Format::Gzip, compress(plain, 15 + 16, &header));
+}
+
+void test_corrupt_crc_fails()
+{
+    checkCorruptTrailerFails(8);
+}
+
+void test_wrong_length_fails()
+{
+    checkCorruptTrailerFails(4);
+}
+
+void test_corrupt_crc_after_all_output_fails()
+{
+    const std::string plain = aeroApiBody(2);
+    std::string compressed = gzipFlushedBeforeTrailer(plain);
+    compressed[compressed.size() - 8] ^= 0x01;
+    bool failed = false;
+    const std::string out = inflate(compressed, InflateStream::Format::Gzip, failed, 1);
+    // Every byte was already delivered; only failed() tells the caller to discard it.
+    TEST_ASSERT_TRUE(out == plain);
+    TEST_ASSERT_TRUE(failed);
+}
+
+void test_missing_trailer_fails()
+{
+    const std::string plain = openSkyBody(120);
+    std::string compressed = gzip(plain);
+    compressed.resize(compressed.size() - 3);
+    bool failed = false;
+    const std::string out = inflate(compressed, InflateStream::Format::Gzip, failed);
+    TEST_ASSERT_TRUE(failed);
+    TEST_ASSERT_TRUE(out.size() < plain.size());
+}
+
+void test_truncated_body_fails()
+{
+    const std::string plain = openSkyBody(120);
+    std::string compressed = gzip(plain);
+    compressed.resize(compressed.size() / 2);
+    bool failed = false;
+    const std::string out = inflate(compressed, InflateStream::Format::Gzip, failed);
+    TEST_ASSERT_TRUE(failed);
+    TEST_ASSERT_TRUE(out.size() < plain.size());
+    TEST_ASSERT_TRUE(plain.compare(0, out.size(), out) == 0);
+}
+
+void test_reports_time_and_peak_heap()
+{
+    printf("InflateStream working set: %u B (window %u + decompressor %u)\n",
+           (unsigned)InflateStream::workingSetBytes(),
+           (unsigned)InflateStream::kWindowBytes,
+           (unsigned)(InflateStream::workingSetBytes() - InflateStream::kWindowBytes));
+    // A busy bounding box, a quiet one, and one flight number's legs.
+    benchmark("opensky", openSkyBody(300));
+    benchmark("opensky", openSkyBody(40));
+    benchmark("aeroapi", aeroApiBody(15));
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_crc32_matches_zlib);
+    RUN_TEST(test_gzip_round_trips_opensky_and_aeroapi_bodies);
+    RUN_TEST(test_zlib_round_trips);
+    RUN_TEST(test_output_past_the_window_round_trips);
+    RUN_TEST(test_trailer_split_across_reads_round_trips);
+    RUN_TEST(test_gzip_header_fields_are_skipped);
+    RUN_TEST(test_corrupt_crc_fails);
+    RUN_TEST(test_wrong_length_fails);
+    RUN_TEST(test_corrupt_crc_after_all_output_fails);
+    RUN_TEST(test_missing_trailer_fails);
+    RUN_TEST(test_truncated_body_fails);
+    RUN_TEST(test_reports_time_and_peak_heap);
+    return UNITY_END();
+}
@@ -0,0 +1,288 @@
+/*
+Purpose: Host harness for utils/PipelinedStream over a local socket (pio test -e host_test).
+Responsibilities:
+- Serve bodies through HostHttpServer at a set chunk size and pace, read them with a
+  per-byte "decrypt" cost on the reader side and a per-byte "parse" cost on the parser
+  side, and report latency inline vs. pipelined with the ring's peak fill and stalls.
+- Bodies arrive intact; the ring never holds more than kRingBytes.
+- A closed connection ends the body at once instead of after the read timeout.
+- end() deletes a reader stuck in a read before it frees the ring.
+*/
+#include <Arduino.h>
+#include <unity.h>
+#include <WiFi.h>
+#include <atomic>
+#include <thread>
+#include "host/HostHttpServer.h"
+#include "utils/ApiHttpClient.h"
+#include "utils/PipelinedStream.h"
+
+namespace
+{
+    using Reply = HostHttpServer::Reply;
+
+    HostHttpServer server;
+
+    void spinUs(uint32_t us)
+    {
+        const unsigned long start = micros();
+        while (micros() - start < us)
+        {
+        }
+    }
+
+    uint32_t fnv1a(uint32_t hash, const char *data, size_t length)
+    {
+        for (size_t i = 0; i < length; ++i)
+            hash = (hash ^ (uint8_t)data[i]) * 16777619u;
+        return hash;
+    }
+
+    // OpenSky-shaped rows, numbered so a dropped or repeated chunk changes the checksum.
+    std::string statesBody(size_t bytes)
+    {
+        std::string body = "{\"time\":1717243200,\"states\":[";
+        char row[160];
+        for (int i = 0; body.size() < bytes; ++i)
+        {
+            snprintf(row, sizeof(row),
+                     "%s[\"%06x\",\"DLH%-5d\",\"Germany\",1717243195,1717243199,8.%04d,50.%04d,"
+                     "3048.0,false,180.5,270.0,-5.2,null,3100.0,\"1000\",false,0]",
+                     i ? "," : "", 0x3c0000 + i, i, i % 10000, (i * 7) % 10000);
+            body += row;
+        }
+        body += "]}";
+        return body;
+    }
+
+    // Stands in for TLS record decryption: costs CPU per byte on whichever task reads.
+    class CostlyStream : public Stream
+    {
+    public:
+        CostlyStream(Stream &inner, uint32_t usPerByte) : m_inner(inner), m_usPerByte(usPerByte) {}
+        int available() override { return m_inner.available(); }
+        int read() override { return m_inner.read(); }
+        int peek() override { return m_inner.peek(); }
+        size_t readBytes(char *buffer, size_t length) override
+        {
+            const size_t got = m_inner.readBytes(buffer, length);
+            spinUs((uint32_t)got * m_usPerByte);
+            return got;
+        }
+        size_t write(uint8_t) override { return 0; }
+
+    private:
+        Stream &m_inner;
+        uint32_t m_usPerByte;
+    };
+
+    struct Scenario
+    {
+        const char *name;
+        size_t bodyBytes;
+        size_t chunkBytes;
+        unsigned chunkDelayMs;
+        uint32_t readUsPerByte;
+        uint32_t parseUsPerByte;
+    };
+
+    struct Result
+    {
+        uint32_t totalMs = 0;
+        size_t bytes = 0;
+        uint32_t checksum = 2166136261u;
+        PipelinedStream::Stats stats;
+    };
+
+    Result fetch(const Scenario &scenario, const std::string &body, bool pipelined)
+    {
+        Reply reply;
+        reply.body = body;
+        reply.chunkBytes = scenario.chunkBytes;
+        reply.chunkDelayMs = scenario.chunkDelayMs;
+        server.push(reply);
+
+        WiFiClient client;
+        ApiHttp::Request request(ApiHttp::Host::OpenMeteo, client);
+        request.setUrl("http://%s/states", ApiHttp::hostName(ApiHttp::Host::OpenMeteo));
+        request.setTimeout(5000);
+        TEST_ASSERT_EQUAL(200, request.get());
+        Stream *stream = request.body();
+        TEST_ASSERT_NOT_NULL(stream);
+
+        Result result;
+        const unsigned long startUs = micros();
+        CostlyStream source(*stream, scenario.readUsPerByte);
+        PipelinedStream pipeline;
+        Stream *input = &source;
+        if (pipelined)
+        {
+            TEST_ASSERT_TRUE(pipeline.begin(source, request.timeoutMs(), &request.connection()));
+            input = &pipeline;
+        }
+
+        char buffer[64];
+        size_t got;
+        while ((got = input->readBytes(buffer, sizeof(buffer))) > 0)
+        {
+            result.checksum = fnv1a(result.checksum, buffer, got);
+            result.bytes += got;
+            spinUs((uint32_t)got * scenario.parseUsPerByte);
+        }
+        pipeline.end();
+        result.totalMs = (micros() - startUs) / 1000;
+        result.stats = pipeline.stats();
+        request.end();
+        return result;
+    }
+
+    // Runs the scenario both ways and checks both copies of the body arrived intact.
+    void compare(const Scenario &scenario, Result &inlineRun, Result &pipelinedRun)
+    {
+        const std::string body = statesBody(scenario.bodyBytes);
+        const uint32_t expected = fnv1a(2166136261u, body.data(), body.size());
+        inlineRun = fetch(scenario, body, false);
+        pipelinedRun = fetch(scenario, body, true);
+
+        printf("%-12s %6u B: inline %4u ms, pipelined %4u ms; peak fill %4u/%u, parser waited %4u ms, reader stalled %4u ms\n",
+               scenario.name,
+               (unsigned)body.size(),
+               inlineRun.totalMs,
+               pipelinedRun.totalMs,
+               (unsigned)pipelinedRun.stats.peakFill,
+               (unsigned)PipelinedStream::kRingBytes,
+               pipelinedRun.stats.consumerWaitMs,
+               pipelinedRun.stats.readerStallMs);
+
+        TEST_ASSERT_EQUAL(body.size(), inlineRun.bytes);
+        TEST_ASSERT_EQUAL(expected, inlineRun.checksum);
+        TEST_ASSERT_EQUAL(body.size(), pipelinedRun.bytes);
+        TEST_ASSERT_EQUAL(expected, pipelinedRun.checksum);
+        TEST_ASSERT_EQUAL(body.size(), pipelinedRun.stats.bytes);
+        TEST_ASSERT_TRUE(pipelinedRun.stats.peakFill <= PipelinedStream::kRingBytes);
+    }
+
+    // Never returns data; counts the reads still executing so the test can see the task die.
+    class StuckStream : public Stream
+    {
+    public:
+        std::atomic<int> active{0};
+
+        int available() override { return 1; }
+        int read() override { return -1; }
+        int peek() override { return -1; }
+        size_t readBytes(char *, size_t) override
+        {
+            struct Active
+            {
+                std::atomic<int> &count;
+                explicit Active(std::atomic<int> &c) : count(c) { count++; }
+                ~Active() { count--; }
+            } guard(active);
+            for (;;)
+            {
+                vTaskDelay(5);
+            }
+        }
+        size_t write(uint8_t) override { return 0; }
+    };
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_reading_and_parsing_overlap()
+{
+    // Decrypting and parsing cost about the same; the link is fast.
+    const Scenario scenario = {"cpu-bound", 24 * 1024, 1460, 1, 4, 4};
+    Result inlineRun, pipelinedRun;
+    compare(scenario, inlineRun, pipelinedRun);
+    if (std::thread::hardware_concurrency() >= 2)
+    {
+        TEST_ASSERT_TRUE(pipelinedRun.totalMs < inlineRun.totalMs);
+    }
+}
+
+void test_slow_link_starves_the_parser()
+{
+    const Scenario scenario = {"slow link", 8 * 1024, 256, 10, 1, 1};
+    Result inlineRun, pipelinedRun;
+    compare(scenario, inlineRun, pipelinedRun);
+    TEST_ASSERT_TRUE(pipelinedRun.stats.consumerWaitMs > 0);
+    TEST_ASSERT_TRUE(pipelinedRun.stats.peakFill < PipelinedStream::kRingBytes);
+}
+
+void test_slow_parser_fills_the_ring_and_stalls_the_reader()
+{
+    const Scenario scenario = {"slow parser", 16 * 1024, 1460, 0, 0, 20};
+    Result inlineRun, pipelinedRun;
+    compare(scenario, inlineRun, pipelinedRun);
+    TEST_ASSERT_TRUE(pipelinedRun.stats.peakFill > PipelinedStream::kRingBytes - 2 * PipelinedStream::kReaderChunkBytes);
+    TEST_ASSERT_TRUE(pipelinedRun.stats.readerStallMs > 0);
+}
+
+void test_closed_connection_ends_the_body_before_the_timeout()
+{
+    const std::string body = statesBody(1000);
+    Reply truncated;
+    truncated.body = body;
+    truncated.mode = Reply::Mode::Truncate;
+    server.push(truncated);
+
+    WiFiClient client;
+    ApiHttp::Request request(ApiHttp::Host::OpenMeteo, client);
+    request.setUrl("http://%s/states", ApiHttp::hostName(ApiHttp::Host::OpenMeteo));
+    request.setTimeout(3000);
+    TEST_ASSERT_EQUAL(200, request.get());
+
+    PipelinedStream pipeline;
+    const unsigned long startMs = millis();
+    TEST_ASSERT_TRUE(pipeline.begin(*request.body(), request.timeoutMs(), &request.connection()));
+    char buffer[2048];
+    const size_t got = pipeline.readBytes(buffer, sizeof(buffer));
+    const unsigned long elapsedMs = millis() - startMs;
+    pipeline.end();
+
+    TEST_ASSERT_EQUAL(body.size() / 2, got);
+    TEST_ASSERT_TRUE(memcmp(buffer, body.data(), got) == 0);
+    TEST_ASSERT_TRUE(elapsedMs < 1000);
+}
+
+void test_end_deletes_a_stuck_reader()
+{
+    StuckStream stuck;
+    PipelinedStream pipeline;
+    TEST_ASSERT_TRUE(pipeline.begin(stuck, 200));
+    while (stuck.active.load() == 0)
+        vTaskDelay(1);
+
+    const unsigned long startMs = millis();
+    pipeline.end();
+    const unsigned long elapsedMs = millis() - startMs;
+
+    // end() waits the timeout plus its grace second, then the reader is gone, not left
+    // running against the freed ring.
+    TEST_ASSERT_EQUAL(0, stuck.active.load());
+    TEST_ASSERT_TRUE(elapsedMs >= 1200);
+    TEST_ASSERT_TRUE(elapsedMs < 2000);
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    if (!server.start())
+        return 1;
+    hostNetRedirect(server.port());
+    hostUseRealMillis(true);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_reading_and_parsing_overlap);
+    RUN_TEST(test_slow_link_starves_the_parser);
+    RUN_TEST(test_slow_parser_fills_the_ring_and_stalls_the_reader);
+    RUN_TEST(test_closed_connection_ends_the_body_before_the_timeout);
+    RUN_TEST(test_end_deletes_a_stuck_reader);
+    const int failures = UNITY_END();
+    server.stop();
+    return failures;
+}
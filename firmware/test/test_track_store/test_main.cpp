@@ -0,0 +1,202 @@
+/*
+Purpose: Host tests for utils/TrackStore (pio test -e host_test).
+Responsibilities:
+- Filing fixes: ring of kSamples, repeated fixes, invalid vectors.
+- Index: collisions that wrap around the end of the table, and the backward-shift
+  delete that keeps every later entry of a probe run reachable.
+- Eviction of the least recently seen track when full, and expiry after kRetainMs.
+*/
+#include <Arduino.h>
+#include <unity.h>
+#include <vector>
+#include "utils/TrackStore.h"
+
+namespace
+{
+    // Mirrors TrackStore::home (Fibonacci hashing into 128 buckets) so tests can pick
+    // addresses that collide.
+    uint8_t bucketOf(uint32_t key) { return (uint8_t)((key * 2654435761u) >> (32 - 7)); }
+
+    String hex(uint32_t key)
+    {
+        char buf[8];
+        snprintf(buf, sizeof(buf), "%06x", (unsigned)key);
+        return String(buf);
+    }
+
+    // The first count addresses from start on whose home bucket is bucket.
+    std::vector<String> keysInBucket(uint8_t bucket, size_t count, uint32_t start = 0x400000)
+    {
+        std::vector<String> keys;
+        for (uint32_t key = start; keys.size() < count; ++key)
+            if (bucketOf(key) == bucket)
+                keys.push_back(hex(key));
+        return keys;
+    }
+
+    StateVector fix(const String &icao24, unsigned long positionMs, double altitudeM = 1000.0)
+    {
+        StateVector s;
+        s.icao24 = icao24;
+        s.lat = 48.0 + positionMs * 1e-7;
+        s.lon = 11.0;
+        s.baro_altitude = altitudeM;
+        s.velocity = 200.0;
+        s.position_ms = positionMs;
+        return s;
+    }
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_ring_keeps_latest_samples_oldest_first()
+{
+    TrackStore store;
+    for (unsigned long i = 1; i <= TrackStore::kSamples + 3; ++i)
+        store.update(fix("abc123", i * 1000, i * 100.0), i * 1000);
+    const TrackStore::Track *t = store.find("ABC123");
+    TEST_ASSERT_NOT_NULL(t);
+    TEST_ASSERT_EQUAL(TrackStore::kSamples, t->size());
+    TEST_ASSERT_EQUAL(4000, t->at(0).ms);
+    TEST_ASSERT_EQUAL((TrackStore::kSamples + 3) * 1000, t->latest().ms);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 1100.0, t->latest().altitudeM);
+    TEST_ASSERT_EQUAL(1000, t->firstSeenMs());
+}
+
+void test_repeated_fix_only_refreshes_last_seen()
+{
+    TrackStore store;
+    store.update(fix("abc123", 5000), 6000);
+    store.update(fix("abc123", 5000), 11000);
+    const TrackStore::Track *t = store.find("abc123");
+    TEST_ASSERT_NOT_NULL(t);
+    TEST_ASSERT_EQUAL(1, t->size());
+    TEST_ASSERT_EQUAL(11000, t->lastSeenMs());
+}
+
+void test_invalid_vectors_are_ignored()
+{
+    TrackStore store;
+    store.update(fix("", 1000), 1000);
+    store.update(fix("xyz123", 1000), 1000);
+    store.update(fix("1234567", 1000), 1000);
+    StateVector noPosition = fix("abc123", 1000);
+    noPosition.lat = NAN;
+    store.update(noPosition, 1000);
+    TEST_ASSERT_EQUAL(0, store.size());
+    TEST_ASSERT_NULL(store.find("abc123"));
+}
+
+void test_collisions_wrap_around_the_index()
+{
+    // Three addresses homed in the last bucket occupy it and the first two.
+    TrackStore store;
+    const std::vector<String> keys = keysInBucket(127, 3);
+    for (size_t i = 0; i < keys.size(); ++i)
+        store.update(fix(keys[i], 1000 + i), 1000);
+    TEST_ASSERT_EQUAL(3, store.size());
+    for (const String &key : keys)
+    {
+        TEST_ASSERT_NOT_NULL(store.find(key));
+        TEST_ASSERT_EQUAL(1000, store.find(key)->firstSeenMs());
+    }
+    TEST_ASSERT_NULL(store.find(keysInBucket(127, 1, 0x500000)[0]));
+}
+
+void test_delete_shifts_later_entries_of_the_run_back()
+{
+    // Run over buckets 126, 127, 0, 1, 2, 3: a, b (home 126), c (home 127), d (home 0),
+    // e (home 126 again) and g (home 3, in its own bucket). Expiring a must move b, c, d
+    // and e back so each is still found from its home, and must leave g where it is.
+    TrackStore store;
+    const std::vector<String> run126 = keysInBucket(126, 3);
+    const String a = run126[0];
+    const String b = run126[1];
+    const String c = keysInBucket(127, 1)[0];
+    const String d = keysInBucket(0, 1)[0];
+    const String e = run126[2];
+    const String g = keysInBucket(3, 1)[0];
+    store.update(fix(a, 1), 0);
+    const unsigned long later = 50000;
+    store.update(fix(b, later), later);
+    store.update(fix(c, later), later);
+    store.update(fix(d, later), later);
+    store.update(fix(e, later), later);
+    store.update(fix(g, later), later);
+    TEST_ASSERT_EQUAL(6, store.size());
+
+    // a was last seen at 0; the others are well inside kRetainMs.
+    store.update(std::vector<StateVector>(), TrackStore::kRetainMs + 1);
+    TEST_ASSERT_EQUAL(5, store.size());
+    TEST_ASSERT_NULL(store.find(a));
+    for (const String &key : {b, c, d, e, g})
+        TEST_ASSERT_NOT_NULL(store.find(key));
+
+    // The freed slot is reused and the index still holds every key exactly once.
+    store.update(fix(a, later + 1), later + 1);
+    TEST_ASSERT_EQUAL(6, store.size());
+    for (const String &key : {a, b, c, d, e, g})
+        TEST_ASSERT_NOT_NULL(store.find(key));
+}
+
+void test_full_store_evicts_least_recently_seen()
+{
+    TrackStore store;
+    for (uint32_t i = 0; i < TrackStore::kMaxTracks; ++i)
+        store.update(fix(hex(0x100000 + i), 1000 + i), 1000 + i);
+    TEST_ASSERT_EQUAL(TrackStore::kMaxTracks, store.size());
+
+    // Seeing the oldest again makes the second one the eviction candidate.
+    store.update(fix(hex(0x100000), 5000), 5000);
+    store.update(fix(hex(0x200000), 6000), 6000);
+    TEST_ASSERT_EQUAL(TrackStore::kMaxTracks, store.size());
+    TEST_ASSERT_NOT_NULL(store.find(hex(0x100000)));
+    TEST_ASSERT_NULL(store.find(hex(0x100001)));
+    TEST_ASSERT_NOT_NULL(store.find(hex(0x100002)));
+    TEST_ASSERT_NOT_NULL(store.find(hex(0x200000)));
+
+    // Keep evicting: every track filed is found, and the store never grows.
+    for (uint32_t i = 0; i < 3 * TrackStore::kMaxTracks; ++i)
+    {
+        store.update(fix(hex(0x300000 + i), 7000 + i), 7000 + i);
+        TEST_ASSERT_NOT_NULL(store.find(hex(0x300000 + i)));
+    }
+    TEST_ASSERT_EQUAL(TrackStore::kMaxTracks, store.size());
+    TEST_ASSERT_NULL(store.find(hex(0x100000)));
+}
+
+void test_tracks_expire_after_retain_time()
+{
+    TrackStore store;
+    std::vector<StateVector> fetch = {fix("aaaaaa", 1000), fix("bbbbbb", 1000)};
+    store.update(fetch, 1000);
+    fetch = {fix("bbbbbb", 20000)};
+    store.update(fetch, 20000);
+
+    // aaaaaa is kept for exactly kRetainMs after it was last seen, then dropped.
+    store.update(std::vector<StateVector>(), 1000 + TrackStore::kRetainMs);
+    TEST_ASSERT_NOT_NULL(store.find("aaaaaa"));
+    store.update(std::vector<StateVector>(), 1000 + TrackStore::kRetainMs + 1);
+    TEST_ASSERT_NULL(store.find("aaaaaa"));
+    TEST_ASSERT_NOT_NULL(store.find("bbbbbb"));
+    TEST_ASSERT_EQUAL(1, store.size());
+
+    store.update(std::vector<StateVector>(), 20000 + TrackStore::kRetainMs + 1);
+    TEST_ASSERT_EQUAL(0, store.size());
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_ring_keeps_latest_samples_oldest_first);
+    RUN_TEST(test_repeated_fix_only_refreshes_last_seen);
+    RUN_TEST(test_invalid_vectors_are_ignored);
+    RUN_TEST(test_collisions_wrap_around_the_index);
+    RUN_TEST(test_delete_shifts_later_entries_of_the_run_back);
+    RUN_TEST(test_full_store_evicts_least_recently_seen);
+    RUN_TEST(test_tracks_expire_after_retain_time);
+    return UNITY_END();
+}
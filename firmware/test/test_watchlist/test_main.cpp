@@ -0,0 +1,197 @@
+/*
+Purpose: Host tests for utils/Watchlist (pio test -e host_test).
+Responsibilities:
+- Callsign keys: exact entries, '*' prefixes and bare three-letter operators.
+- The type:, hex: and sq: tags, separators, case and malformed entries.
+- Emergency squawks, which match with an empty list.
+*/
+#include <Arduino.h>
+#include <unity.h>
+#include "utils/Watchlist.h"
+
+namespace
+{
+    StateVector vector(const char *callsign, const char *icao24 = "", const char *squawk = "")
+    {
+        StateVector s;
+        s.callsign = callsign;
+        s.icao24 = icao24;
+        s.squawk = squawk;
+        return s;
+    }
+
+    uint8_t matchCallsign(const Watchlist &w, const char *callsign)
+    {
+        return w.match(vector(callsign));
+    }
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_empty_list_matches_nothing()
+{
+    Watchlist uncompiled;
+    TEST_ASSERT_EQUAL(Watchlist::None, matchCallsign(uncompiled, "DLH438"));
+    TEST_ASSERT_EQUAL(Watchlist::None, uncompiled.matchType("A388"));
+    Watchlist empty;
+    empty.compile("");
+    TEST_ASSERT_EQUAL(Watchlist::None, matchCallsign(empty, "DLH438"));
+    TEST_ASSERT_EQUAL(Watchlist::None, matchCallsign(empty, ""));
+}
+
+void test_exact_callsign_is_not_a_prefix()
+{
+    Watchlist w;
+    w.compile("DLH438");
+    TEST_ASSERT_EQUAL(Watchlist::Callsign, matchCallsign(w, "DLH438"));
+    TEST_ASSERT_EQUAL(Watchlist::Callsign, matchCallsign(w, "dlh438"));
+    TEST_ASSERT_EQUAL(Watchlist::None, matchCallsign(w, "DLH4381"));
+    TEST_ASSERT_EQUAL(Watchlist::None, matchCallsign(w, "DLH43"));
+    TEST_ASSERT_EQUAL(Watchlist::None, matchCallsign(w, "DLH439"));
+}
+
+void test_star_matches_a_prefix()
+{
+    Watchlist w;
+    w.compile("RCH*, BAW12*");
+    TEST_ASSERT_EQUAL(Watchlist::Callsign, matchCallsign(w, "RCH"));
+    TEST_ASSERT_EQUAL(Watchlist::Callsign, matchCallsign(w, "RCH871"));
+    TEST_ASSERT_EQUAL(Watchlist::Callsign, matchCallsign(w, "BAW12"));
+    TEST_ASSERT_EQUAL(Watchlist::Callsign, matchCallsign(w, "BAW123A"));
+    TEST_ASSERT_EQUAL(Watchlist::None, matchCallsign(w, "RC"));
+    TEST_ASSERT_EQUAL(Watchlist::None, matchCallsign(w, "BAW13"));
+}
+
+void test_bare_operator_covers_its_callsigns()
+{
+    // Three letters are an airline designator; other lengths and digits stay exact.
+    Watchlist w;
+    w.compile("dlh N12 AB1");
+    TEST_ASSERT_EQUAL(Watchlist::Callsign, matchCallsign(w, "DLH"));
+    TEST_ASSERT_EQUAL(Watchlist::Callsign, matchCallsign(w, "DLH2LA"));
+    TEST_ASSERT_EQUAL(Watchlist::Callsign, matchCallsign(w, "N12"));
+    TEST_ASSERT_EQUAL(Watchlist::None, matchCallsign(w, "N123"));
+    TEST_ASSERT_EQUAL(Watchlist::None, matchCallsign(w, "AB12"));
+    TEST_ASSERT_EQUAL(Watchlist::None, matchCallsign(w, "DL"));
+}
+
+void test_shared_prefixes_keep_their_own_flags()
+{
+    // Keys that branch off each other in the trie.
+    Watchlist w;
+    w.compile("UAL9, UAL901, UAL90*");
+    TEST_ASSERT_EQUAL(Watchlist::Callsign, matchCallsign(w, "UAL9"));
+    TEST_ASSERT_EQUAL(Watchlist::Callsign, matchCallsign(w, "UAL901"));
+    TEST_ASSERT_EQUAL(Watchlist::Callsign, matchCallsign(w, "UAL905"));
+    TEST_ASSERT_EQUAL(Watchlist::None, matchCallsign(w, "UAL91"));
+    TEST_ASSERT_EQUAL(Watchlist::None, matchCallsign(w, "UAL"));
+}
+
+void test_type_tag()
+{
+    Watchlist w;
+    w.compile("type:A388 TYPE:b74*");
+    TEST_ASSERT_EQUAL(Watchlist::Type, w.matchType("A388"));
+    TEST_ASSERT_EQUAL(Watchlist::Type, w.matchType("a388"));
+    TEST_ASSERT_EQUAL(Watchlist::Type, w.matchType("B748"));
+    TEST_ASSERT_EQUAL(Watchlist::None, w.matchType("A380"));
+    TEST_ASSERT_EQUAL(Watchlist::None, w.matchType(""));
+    // Types and callsigns are separate namespaces.
+    TEST_ASSERT_EQUAL(Watchlist::None, matchCallsign(w, "A388"));
+}
+
+void test_hex_tag()
+{
+    Watchlist w;
+    w.compile("hex:3C6752;hex:ae*");
+    TEST_ASSERT_EQUAL(Watchlist::Address, w.match(vector("", "3c6752")));
+    TEST_ASSERT_EQUAL(Watchlist::Address, w.match(vector("", "AE01C5")));
+    TEST_ASSERT_EQUAL(Watchlist::None, w.match(vector("", "3c6753")));
+    TEST_ASSERT_EQUAL(Watchlist::None, w.match(vector("", "af01c5")));
+    TEST_ASSERT_EQUAL(Watchlist::None, matchCallsign(w, "3C6752"));
+}
+
+void test_squawk_tag()
+{
+    Watchlist w;
+    w.compile("sq:7000,sq:0021");
+    TEST_ASSERT_EQUAL(Watchlist::Squawk, w.match(vector("", "", "7000")));
+    TEST_ASSERT_EQUAL(Watchlist::Squawk, w.match(vector("", "", "0021")));
+    TEST_ASSERT_EQUAL(Watchlist::None, w.match(vector("", "", "7001")));
+    TEST_ASSERT_EQUAL(Watchlist::None, w.match(vector("", "", "700")));
+    TEST_ASSERT_EQUAL(Watchlist::None, w.match(vector("", "", "")));
+}
+
+void test_malformed_entries_are_skipped()
+{
+    // Not octal, wrong length, empty keys and punctuation; the valid entries still load.
+    Watchlist w;
+    w.compile("sq:7008 sq:123 sq:12345 sq: hex: type:* * DL-H ,, KLM1");
+    TEST_ASSERT_EQUAL(Watchlist::None, w.match(vector("", "", "7008")));
+    TEST_ASSERT_EQUAL(Watchlist::None, w.match(vector("", "", "0123")));
+    TEST_ASSERT_EQUAL(Watchlist::None, w.match(vector("", "", "1234")));
+    TEST_ASSERT_EQUAL(Watchlist::None, matchCallsign(w, "DL-H"));
+    TEST_ASSERT_EQUAL(Watchlist::None, matchCallsign(w, "ANY"));
+    TEST_ASSERT_EQUAL(Watchlist::None, w.matchType("A320"));
+    TEST_ASSERT_EQUAL(Watchlist::Callsign, matchCallsign(w, "KLM1"));
+}
+
+void test_emergency_squawks_always_match()
+{
+    Watchlist w;
+    w.compile("");
+    TEST_ASSERT_EQUAL(Watchlist::Squawk, w.match(vector("", "", "7500")));
+    TEST_ASSERT_EQUAL(Watchlist::Squawk, w.match(vector("", "", "7600")));
+    TEST_ASSERT_EQUAL(Watchlist::Squawk, w.match(vector("", "", "7700")));
+    TEST_ASSERT_EQUAL(Watchlist::None, w.match(vector("", "", "7400")));
+    TEST_ASSERT_TRUE(Watchlist::isEmergency("7700"));
+    TEST_ASSERT_FALSE(Watchlist::isEmergency("770"));
+}
+
+void test_bits_combine()
+{
+    Watchlist w;
+    w.compile("UAL901 hex:a8c1f3");
+    TEST_ASSERT_EQUAL(Watchlist::Callsign | Watchlist::Address | Watchlist::Squawk,
+                      w.match(vector("UAL901", "a8c1f3", "7700")));
+}
+
+void test_recompile_replaces_the_list()
+{
+    Watchlist w;
+    w.compile("DLH sq:7000");
+    w.compile("KLM");
+    TEST_ASSERT_EQUAL(Watchlist::None, matchCallsign(w, "DLH438"));
+    TEST_ASSERT_EQUAL(Watchlist::None, w.match(vector("", "", "7000")));
+    TEST_ASSERT_EQUAL(Watchlist::Callsign, matchCallsign(w, "KLM1234"));
+}
+
+void test_load_sets_active()
+{
+    Watchlist::load("EZY*");
+    TEST_ASSERT_EQUAL(Watchlist::Callsign, matchCallsign(Watchlist::active(), "EZY12AB"));
+    Watchlist::load("");
+    TEST_ASSERT_EQUAL(Watchlist::None, matchCallsign(Watchlist::active(), "EZY12AB"));
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_list_matches_nothing);
+    RUN_TEST(test_exact_callsign_is_not_a_prefix);
+    RUN_TEST(test_star_matches_a_prefix);
+    RUN_TEST(test_bare_operator_covers_its_callsigns);
+    RUN_TEST(test_shared_prefixes_keep_their_own_flags);
+    RUN_TEST(test_type_tag);
+    RUN_TEST(test_hex_tag);
+    RUN_TEST(test_squawk_tag);
+    RUN_TEST(test_malformed_entries_are_skipped);
+    RUN_TEST(test_emergency_squawks_always_match);
+    RUN_TEST(test_bits_combine);
+    RUN_TEST(test_recompile_replaces_the_list);
+    RUN_TEST(test_load_sets_active);
+    return UNITY_END();
+}
@@ -0,0 +1,198 @@
+"""
+Compile the flight card designs into constexpr tables for the display.
+
+Usage:
+  python tools/generate_card_designs.py --designs tools/card_designs.json --out utils/CardDesigns.generated.h
+
+The input lists designs, each a list of rows from the top of the card:
+  { "kind": "progress", "height": 2 }
+  { "anchor": "top"|"bottom", "gap": 1, "font": "glcd"|"compact",
+    "align": "left"|"center"|"right", "overflow": "clip"|"truncate"|"marquee"|"wrap",
+    "line_gap": 1, "segments": [ { "field": "airline", "color": "text", "gap": 0 }, ... ] }
+
+Segment fields are the CardLayout::Field names in snake_case; { "text": "..." } is a
+literal. Colors are text, dim, origin, destination or white. Top rows stack down from
+the pane top, bottom rows stack up from the pane bottom (the last row lowest), each
+"gap" pixels from its neighbour. Designs are checked against the renderer's per-card
+capacity (CardLayout::kMaxLines/kMaxPieces/kMaxStrips) so a bad design fails here, not
+on the panel.
+"""
+import argparse
+import json
+from pathlib import Path
+
+# Keep in sync with utils/CardLayout.h.
+MAX_LINES = 8
+MAX_PIECES = 16
+MAX_STRIPS = 10
+
+FIELDS = {
+    "airline": "Airline",
+    "airline_fin": "AirlineFin",
+    "origin_code": "OriginCode",
+    "dest_code": "DestCode",
+    "origin_city": "OriginCity",
+    "dest_city": "DestCity",
+    "aircraft": "Aircraft",
+    "aircraft_code": "AircraftCode",
+    "callsign": "Callsign",
+    "altitude": "Altitude",
+    "speed": "Speed",
+    "literal": "Literal",
+    "arrow": "Arrow",
+}
+NON_TEXT = {"airline_fin", "arrow"}
+COLORS = {"text": "Text", "dim": "Dim", "origin": "Origin", "destination": "Destination", "white": "White"}
+ALIGNS = {"left": "Left", "center": "Center", "right": "Right"}
+OVERFLOWS = {"clip": "Clip", "truncate": "Truncate", "marquee": "Marquee", "wrap": "Wrap"}
+ANCHORS = {"top": "Top", "bottom": "Bottom"}
+FONTS = {"glcd": "Glcd", "compact": "Compact"}
+
+
+def pick(where: str, table: dict, value: str) -> str:
+    if value not in table:
+        raise SystemExit(f"{where}: unknown value {value!r} (expected one of {', '.join(table)})")
+    return table[value]
+
+
+def c_string(text: str) -> str:
+    return '"' + text.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+def compile_row(where: str, row: dict, segments_out: list) -> tuple[str, int, int, int]:
+    """Returns the Row initializer and the row's worst-case lines, pieces and strips."""
+    kind = row.get("kind", "line")
+    anchor = pick(where, ANCHORS, row.get("anchor", "top"))
+    gap = int(row.get("gap", 0))
+    if kind == "progress":
+        height = int(row.get("height", 2))
+        if not 1 <= height <= 8:
+            raise SystemExit(f"{where}: progress height must be 1..8")
+        init = (f"{{RowKind::Progress, Anchor::{anchor}, {gap}, {height}, TextStrip::Font::Glcd, "
+                f"Align::Left, Overflow::Clip, 0, {len(segments_out)}, 0}}")
+        return init, 0, 0, 0
+    if kind != "line":
+        raise SystemExit(f"{where}: kind must be 'line' or 'progress'")
+
+    font = pick(where, FONTS, row.get("font", "glcd"))
+    align = pick(where, ALIGNS, row.get("align", "left"))
+    overflow = pick(where, OVERFLOWS, row.get("overflow", "clip"))
+    line_gap = int(row.get("line_gap", 1))
+    segments = row.get("segments", [])
+    if not segments:
+        raise SystemExit(f"{where}: a line needs at least one segment")
+
+    first = len(segments_out)
+    fields = []
+    colors = set()
+    strips = 0
+    previous_text_color = None
+    for j, seg in enumerate(segments):
+        swhere = f"{where} segment {j}"
+        field = "literal" if "text" in seg else seg.get("field", "")
+        pick(swhere, FIELDS, field)
+        color = pick(swhere, COLORS, seg.get("color", "text"))
+        seg_gap = int(seg.get("gap", 0))
+        if not 0 <= seg_gap <= 255:
+            raise SystemExit(f"{swhere}: gap must be 0..255")
+        text = seg.get("text", "")
+        if field == "literal" and not text:
+            raise SystemExit(f"{swhere}: literal text is empty")
+        if field == "airline_fin" and j != 0:
+            raise SystemExit(f"{swhere}: airline_fin must lead the line")
+        fields.append(field)
+        colors.add(color)
+        if field in NON_TEXT:
+            previous_text_color = None
+        else:
+            # Adjacent text segments with one color and no gap share a strip.
+            if previous_text_color != color or seg_gap:
+                strips += 1
+            previous_text_color = color
+        text_init = c_string(text) if field == "literal" else "nullptr"
+        segments_out.append(f"{{Field::{FIELDS[field]}, ColorRole::{color}, {seg_gap}, {text_init}}}")
+
+    lines = 1
+    pieces = len(segments)
+    if overflow == "Wrap":
+        if anchor != "Top":
+            raise SystemExit(f"{where}: only top rows can wrap")
+        if any(f in NON_TEXT for f in fields) or len(colors) != 1:
+            raise SystemExit(f"{where}: a wrapped line must be text of one color")
+        lines, pieces, strips = 2, 2, 2
+    if overflow == "Truncate" and all(f in NON_TEXT for f in fields):
+        raise SystemExit(f"{where}: nothing to truncate")
+
+    init = (f"{{RowKind::Line, Anchor::{anchor}, {gap}, 0, TextStrip::Font::{font}, "
+            f"Align::{align}, Overflow::{overflow}, {line_gap}, {first}, {len(segments)}}}")
+    return init, lines, pieces, strips
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compile card designs into constexpr tables.")
+    parser.add_argument("--designs", default=Path("tools/card_designs.json"), type=Path, help="Design JSON")
+    parser.add_argument("--out", default=Path("utils/CardDesigns.generated.h"), type=Path, help="Output header path")
+    args = parser.parse_args()
+
+    with args.designs.open("r", encoding="utf-8") as f:
+        designs = json.load(f)["designs"]
+    if not designs:
+        raise SystemExit("no designs")
+
+    segments_out: list[str] = []
+    rows_out: list[str] = []
+    designs_out: list[str] = []
+    max_lines = max_pieces = max_strips = 0
+    names = set()
+    for d in designs:
+        name = d["name"]
+        if name in names:
+            raise SystemExit(f"duplicate design {name!r}")
+        names.add(name)
+        first_row = len(rows_out)
+        lines = pieces = strips = 0
+        for i, row in enumerate(d["rows"]):
+            init, l, p, s = compile_row(f"{name} row {i}", row, segments_out)
+            rows_out.append(f"{init}, // {name} row {i}")
+            lines, pieces, strips = lines + l, pieces + p, strips + s
+        if lines > MAX_LINES or pieces > MAX_PIECES or strips > MAX_STRIPS:
+            raise SystemExit(f"{name}: needs {lines} lines, {pieces} pieces, {strips} strips; "
+                             f"the renderer has {MAX_LINES}/{MAX_PIECES}/{MAX_STRIPS}")
+        max_lines, max_pieces, max_strips = max(max_lines, lines), max(max_pieces, pieces), max(max_strips, strips)
+        designs_out.append(f"{{{c_string(name)}, {c_string(d.get('label', name))}, {first_row}, {len(d['rows'])}}},")
+
+    lines = [
+        "// Auto-generated by tools/generate_card_designs.py. Do not edit manually.",
+        "#pragma once",
+        "",
+        '#include "utils/CardLayout.h"',
+        "",
+        f"// {len(designs)} designs, {len(rows_out)} rows, {len(segments_out)} segments.",
+        f"static constexpr uint8_t kCardDesignMaxLines = {max_lines};",
+        f"static constexpr uint8_t kCardDesignMaxPieces = {max_pieces};",
+        f"static constexpr uint8_t kCardDesignMaxStrips = {max_strips};",
+        "",
+        "namespace CardLayout",
+        "{",
+        "    static constexpr Segment kSegments[] = {",
+        *[f"        {s}," for s in segments_out],
+        "    };",
+        "",
+        "    static constexpr Row kRows[] = {",
+        *[f"        {r}" for r in rows_out],
+        "    };",
+        "",
+        "    static constexpr Design kDesigns[] = {",
+        *[f"        {d}" for d in designs_out],
+        "    };",
+        "    static constexpr size_t kDesigns_COUNT = sizeof(kDesigns) / sizeof(kDesigns[0]);",
+        "}",
+        "",
+    ]
+    args.out.parent.mkdir(parents=True, exist_ok=True)
+    args.out.write_text("\n".join(lines), encoding="utf-8")
+    print(f"Wrote {args.out} (designs={len(designs)}, rows={len(rows_out)}, segments={len(segments_out)})")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,246 @@
+"""
+Generate the compact proportional font atlas used for the flight card's marquee lines.
+
+Usage:
+  python tools/generate_compact_font.py --out utils/CompactFont.generated.h
+
+Glyphs are drawn below as ASCII art ('#' = lit), 5 rows for capitals and digits plus
+one descender row. Each glyph is packed column by column, one byte per column (bit 0 =
+top row), into a single PROGMEM atlas; a per-glyph offset table gives both position and
+width. Kerning pairs are derived from the glyph shapes: a pair tightens by one column
+when its facing edges stay at least one blank column apart in every row (and the rows
+next to it), so kerned glyphs never touch.
+"""
+import argparse
+from pathlib import Path
+
+HEIGHT = 6
+FIRST = 32
+LAST = 126
+
+GLYPHS = {
+    " ": ["..", "..", "..", "..", ".."],
+    "!": ["#", "#", "#", ".", "#"],
+    '"': ["#.#", "#.#", "...", "...", "..."],
+    "#": [".#.#.", "#####", ".#.#.", "#####", ".#.#."],
+    "$": [".##", "##.", "###", ".##", "##."],
+    "%": ["#.#", "..#", ".#.", "#..", "#.#"],
+    "&": [".#.", "#.#", ".#.", "#.#", ".##"],
+    "'": ["#", "#", ".", ".", "."],
+    "(": [".#", "#.", "#.", "#.", ".#"],
+    ")": ["#.", ".#", ".#", ".#", "#."],
+    "*": ["...", "#.#", ".#.", "#.#", "..."],
+    "+": ["...", ".#.", "###", ".#.", "..."],
+    ",": [".", ".", ".", ".", "#", "#"],
+    "-": ["...", "...", "###", "...", "..."],
+    ".": [".", ".", ".", ".", "#"],
+    "/": ["..#", "..#", ".#.", "#..", "#.."],
+    "0": ["###", "#.#", "#.#", "#.#", "###"],
+    "1": [".#.", "##.", ".#.", ".#.", "###"],
+    "2": ["##.", "..#", ".#.", "#..", "###"],
+    "3": ["##.", "..#", ".#.", "..#", "##."],
+    "4": ["#.#", "#.#", "###", "..#", "..#"],
+    "5": ["###", "#..", "##.", "..#", "##."],
+    "6": [".##", "#..", "###", "#.#", "###"],
+    "7": ["###", "..#", ".#.", ".#.", ".#."],
+    "8": ["###", "#.#", "###", "#.#", "###"],
+    "9": ["###", "#.#", "###", "..#", "##."],
+    ":": [".", "#", ".", "#", "."],
+    ";": [".", "#", ".", "#", "#"],
+    "<": ["..#", ".#.", "#..", ".#.", "..#"],
+    "=": ["...", "###", "...", "###", "..."],
+    ">": ["#..", ".#.", "..#", ".#.", "#.."],
+    "?": ["##.", "..#", ".#.", "...", ".#."],
+    "@": [".##.", "#.##", "#.##", "#...", ".##."],
+    "A": [".#.", "#.#", "###", "#.#", "#.#"],
+    "B": ["##.", "#.#", "##.", "#.#", "##."],
+    "C": [".##", "#..", "#..", "#..", ".##"],
+    "D": ["##.", "#.#", "#.#", "#.#", "##."],
+    "E": ["###", "#..", "##.", "#..", "###"],
+    "F": ["###", "#..", "##.", "#..", "#.."],
+    "G": [".##", "#..", "#.#", "#.#", ".##"],
+    "H": ["#.#", "#.#", "###", "#.#", "#.#"],
+    "I": ["###", ".#.", ".#.", ".#.", "###"],
+    "J": ["..#", "..#", "..#", "#.#", ".#."],
+    "K": ["#.#", "#.#", "##.", "#.#", "#.#"],
+    "L": ["#..", "#..", "#..", "#..", "###"],
+    "M": ["#...#", "##.##", "#.#.#", "#...#", "#...#"],
+    "N": ["#..#", "##.#", "#.##", "#..#", "#..#"],
+    "O": [".##.", "#..#", "#..#", "#..#", ".##."],
+    "P": ["##.", "#.#", "##.", "#..", "#.."],
+    "Q": [".##.", "#..#", "#..#", "#.#.", ".#.#"],
+    "R": ["##.", "#.#", "##.", "#.#", "#.#"],
+    "S": [".##", "#..", ".#.", "..#", "##."],
+    "T": ["###", ".#.", ".#.", ".#.", ".#."],
+    "U": ["#.#", "#.#", "#.#", "#.#", "###"],
+    "V": ["#.#", "#.#", "#.#", "#.#", ".#."],
+    "W": ["#...#", "#...#", "#.#.#", "##.##", "#...#"],
+    "X": ["#.#", "#.#", ".#.", "#.#", "#.#"],
+    "Y": ["#.#", "#.#", ".#.", ".#.", ".#."],
+    "Z": ["###", "..#", ".#.", "#..", "###"],
+    "[": ["##", "#.", "#.", "#.", "##"],
+    "\\": ["#..", "#..", ".#.", "..#", "..#"],
+    "]": ["##", ".#", ".#", ".#", "##"],
+    "^": [".#.", "#.#", "...", "...", "..."],
+    "_": ["...", "...", "...", "...", "###"],
+    "`": ["#.", ".#", "..", "..", ".."],
+    "a": ["...", ".##", "#.#", "#.#", ".##"],
+    "b": ["#..", "##.", "#.#", "#.#", "##."],
+    "c": ["...", ".##", "#..", "#..", ".##"],
+    "d": ["..#", ".##", "#.#", "#.#", ".##"],
+    "e": ["...", ".#.", "###", "#..", ".##"],
+    "f": [".##", "#..", "##.", "#..", "#.."],
+    "g": ["...", ".##", "#.#", ".##", "..#", "##."],
+    "h": ["#..", "#..", "##.", "#.#", "#.#"],
+    "i": ["#", ".", "#", "#", "#"],
+    "j": [".#", "..", ".#", ".#", ".#", "#."],
+    "k": ["#..", "#..", "#.#", "##.", "#.#"],
+    "l": ["#", "#", "#", "#", "#"],
+    "m": [".....", "##.#.", "#.#.#", "#.#.#", "#.#.#"],
+    "n": ["...", "##.", "#.#", "#.#", "#.#"],
+    "o": ["...", ".#.", "#.#", "#.#", ".#."],
+    "p": ["...", "##.", "#.#", "##.", "#..", "#.."],
+    "q": ["...", ".##", "#.#", ".##", "..#", "..#"],
+    "r": ["...", "#.#", "##.", "#..", "#.."],
+    "s": ["...", ".##", "#..", "..#", "##."],
+    "t": [".#.", "###", ".#.", ".#.", "..#"],
+    "u": ["...", "#.#", "#.#", "#.#", ".##"],
+    "v": ["...", "#.#", "#.#", "#.#", ".#."],
+    "w": [".....", "#...#", "#...#", "#.#.#", ".#.#."],
+    "x": ["...", "#.#", ".#.", ".#.", "#.#"],
+    "y": ["...", "#.#", "#.#", ".##", "..#", "##."],
+    "z": ["...", "###", "..#", "#..", "###"],
+    "{": [".##", ".#.", "##.", ".#.", ".##"],
+    "|": ["#", "#", "#", "#", "#"],
+    "}": ["##.", ".#.", ".##", ".#.", "##."],
+    "~": ["....", ".#.#", "#.#.", "....", "...."],
+}
+
+# Only pairs that occur in airline, city and metrics text are worth a table entry.
+KERN_CHARS = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz.,-"
+
+
+def normalize(ch: str, rows: list[str]) -> list[str]:
+    if len(rows) == HEIGHT - 1:
+        rows = rows + ["." * len(rows[0])]
+    if len(rows) != HEIGHT or any(len(r) != len(rows[0]) for r in rows):
+        raise SystemExit(f"glyph {ch!r}: expected {HEIGHT} rows of equal width")
+    if len(rows[0]) > 8:
+        raise SystemExit(f"glyph {ch!r}: wider than 8 columns")
+    return rows
+
+
+def pack_columns(rows: list[str]) -> list[int]:
+    cols = []
+    for x in range(len(rows[0])):
+        bits = 0
+        for y in range(HEIGHT):
+            if rows[y][x] == "#":
+                bits |= 1 << y
+        cols.append(bits)
+    return cols
+
+
+def edge_profile(rows: list[str], from_right: bool) -> list[int | None]:
+    """Blank columns between the glyph edge and its first lit pixel, per row."""
+    width = len(rows[0])
+    out = []
+    for row in rows:
+        lit = [x for x in range(width) if row[x] == "#"]
+        if not lit:
+            out.append(None)
+        else:
+            out.append(width - 1 - max(lit) if from_right else min(lit))
+    return out
+
+
+def kern_pair(left: list[str], right: list[str]) -> int:
+    """-1 if the pair can lose its tracking column without any pixels touching."""
+    lp = edge_profile(left, from_right=True)
+    rp = edge_profile(right, from_right=False)
+    if all(v is None for v in lp) or all(v is None for v in rp):
+        return 0
+    for y in range(HEIGHT):
+        if rp[y] is None:
+            continue
+        for ny in (y - 1, y, y + 1):
+            if 0 <= ny < HEIGHT and lp[ny] is not None:
+                # Tracking is one column; kerned, the gap is just the glyphs' own blanks.
+                if lp[ny] + rp[y] < 1:
+                    return 0
+    return -1
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate the compact font atlas header.")
+    parser.add_argument("--out", default=Path("utils/CompactFont.generated.h"), type=Path, help="Output header path")
+    args = parser.parse_args()
+
+    glyphs = {}
+    for code in range(FIRST, LAST + 1):
+        ch = chr(code)
+        if ch not in GLYPHS:
+            raise SystemExit(f"missing glyph {ch!r}")
+        glyphs[ch] = normalize(ch, GLYPHS[ch])
+
+    atlas = []
+    offsets = []
+    for code in range(FIRST, LAST + 1):
+        offsets.append(len(atlas))
+        atlas.extend(pack_columns(glyphs[chr(code)]))
+    offsets.append(len(atlas))
+
+    kerns = []
+    for a in KERN_CHARS:
+        for b in KERN_CHARS:
+            adj = kern_pair(glyphs[a], glyphs[b])
+            if adj:
+                kerns.append(((ord(a) << 8) | ord(b), adj))
+    kerns.sort()
+
+    def rows_of(values, fmt, per_line):
+        out = []
+        for i in range(0, len(values), per_line):
+            out.append("    " + ",".join(fmt(v) for v in values[i:i + per_line]) + ",")
+        return out
+
+    lines = [
+        "// Auto-generated by tools/generate_compact_font.py. Do not edit manually.",
+        "#pragma once",
+        "",
+        "#include <Arduino.h>",
+        "",
+        f"// {LAST - FIRST + 1} glyphs ('{chr(FIRST)}'..'{chr(LAST)}'), {len(atlas)} columns, {len(kerns)} kerning pairs.",
+        f"static const uint8_t kCompactFontFirst = {FIRST};",
+        f"static const uint8_t kCompactFontLast = {LAST};",
+        f"static const int16_t kCompactFontHeight = {HEIGHT};",
+        "",
+        "// One byte per glyph column, bit 0 = top row.",
+        "static const uint8_t kCompactFontAtlas[] PROGMEM = {",
+        *rows_of(atlas, lambda v: f"0x{v:02X}", 16),
+        "};",
+        "",
+        "// Glyph i spans columns [offset[i], offset[i + 1]) of the atlas.",
+        "static const uint16_t kCompactFontOffsets[] PROGMEM = {",
+        *rows_of(offsets, str, 16),
+        "};",
+        "",
+        "// (left << 8 | right) sorted ascending, with the column adjustment for that pair.",
+        "struct CompactFontKern",
+        "{",
+        "    uint16_t pair;",
+        "    int8_t adjust;",
+        "};",
+        "static const CompactFontKern kCompactFontKerning[] PROGMEM = {",
+        *rows_of(kerns, lambda k: f"{{0x{k[0]:04X},{k[1]}}}", 8),
+        "};",
+        "static constexpr size_t kCompactFontKerning_COUNT = sizeof(kCompactFontKerning) / sizeof(kCompactFontKerning[0]);",
+        "",
+    ]
+    args.out.parent.mkdir(parents=True, exist_ok=True)
+    args.out.write_text("\n".join(lines), encoding="utf-8")
+    print(f"Wrote {args.out} (glyphs={len(offsets) - 1}, columns={len(atlas)}, kerning pairs={len(kerns)})")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,277 @@
+"""
+Generate the sprite atlas header (weather icons, boot logo, airline tail fins) from images.
+
+Usage:
+  python tools/generate_sprite_atlas.py --out images/SpriteAtlas.generated.h tools/sprites/*.png
+
+Writes the run data to --out and the sprite ids next to it (SpriteIds.generated.h), so
+code that only names sprites does not pull in the data tables.
+
+Inputs are PNG (8-bit gray/RGB/RGBA or palette, non-interlaced) or uncompressed 24/32-bit
+BMP files. Transparent pixels are those with alpha < 128 or pure black (an unlit LED).
+Each sprite may use up to 3 opaque colors, which become its palette; index 0 is
+transparent. Rows are stored as runs, one byte each: palette index in the top 2 bits and
+run length - 1 in the low 6 bits. The runtime walks the runs and writes each opaque one as
+a single horizontal span, so decoding never touches individual pixels.
+
+The sprite name is the file name without extension, converted to CamelCase for the id
+(weather_sun.png -> Sprite::WeatherSun). Files named airline_<ICAO>.png also get an entry
+in a sorted operator-code table for card branding.
+"""
+import argparse
+import re
+import struct
+import zlib
+from pathlib import Path
+
+MAX_RUN = 64
+MAX_COLORS = 3
+
+
+def paeth(a: int, b: int, c: int) -> int:
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def read_png(data: bytes) -> tuple[int, int, list[tuple[int, int, int, int]]]:
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("not a PNG")
+    pos = 8
+    idat = b""
+    palette = []
+    trns = b""
+    width = height = depth = color_type = interlace = 0
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, color_type, _, _, interlace = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b"tRNS":
+            trns = body
+        elif kind == b"IDAT":
+            idat += body
+        elif kind == b"IEND":
+            break
+    if interlace:
+        raise ValueError("interlaced PNG not supported")
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color_type]
+    if depth != 8 and not (color_type == 3 and depth in (1, 2, 4)):
+        raise ValueError(f"unsupported PNG bit depth {depth}")
+
+    bits_per_px = channels * depth
+    stride = (width * bits_per_px + 7) // 8
+    bpp = max(1, bits_per_px // 8)
+    raw = zlib.decompress(idat)
+    rows = []
+    prev = bytearray(stride)
+    for y in range(height):
+        ftype = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if ftype == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif ftype == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif ftype == 3:
+                line[i] = (line[i] + ((a + b) >> 1)) & 0xFF
+            elif ftype == 4:
+                line[i] = (line[i] + paeth(a, b, c)) & 0xFF
+        rows.append(line)
+        prev = line
+
+    pixels = []
+    for line in rows:
+        for x in range(width):
+            if color_type == 3:
+                per_byte = 8 // depth
+                byte = line[x // per_byte]
+                shift = 8 - depth * (x % per_byte + 1)
+                index = (byte >> shift) & ((1 << depth) - 1)
+                r, g, b = palette[index]
+                alpha = trns[index] if index < len(trns) else 255
+                pixels.append((r, g, b, alpha))
+            else:
+                px = line[x * channels:(x + 1) * channels]
+                if color_type == 0:
+                    pixels.append((px[0], px[0], px[0], 255))
+                elif color_type == 4:
+                    pixels.append((px[0], px[0], px[0], px[1]))
+                elif color_type == 2:
+                    pixels.append((px[0], px[1], px[2], 255))
+                else:
+                    pixels.append((px[0], px[1], px[2], px[3]))
+    return width, height, pixels
+
+
+def read_bmp(data: bytes) -> tuple[int, int, list[tuple[int, int, int, int]]]:
+    if data[:2] != b"BM":
+        raise ValueError("not a BMP")
+    offset = struct.unpack_from("<I", data, 10)[0]
+    width, height = struct.unpack_from("<ii", data, 18)
+    bpp, compression = struct.unpack_from("<HI", data, 28)
+    if bpp not in (24, 32) or compression not in (0, 3):
+        raise ValueError("only uncompressed 24/32-bit BMP supported")
+    bottom_up = height > 0
+    height = abs(height)
+    stride = (width * bpp // 8 + 3) & ~3
+    pixels = []
+    for y in range(height):
+        row = (height - 1 - y) if bottom_up else y
+        base = offset + row * stride
+        for x in range(width):
+            b, g, r = data[base + x * bpp // 8:base + x * bpp // 8 + 3]
+            a = data[base + x * 4 + 3] if bpp == 32 else 255
+            pixels.append((r, g, b, a))
+    return width, height, pixels
+
+
+def load_image(path: Path):
+    data = path.read_bytes()
+    if data[:2] == b"BM":
+        return read_bmp(data)
+    return read_png(data)
+
+
+def encode(name: str, width: int, height: int, pixels) -> tuple[list[tuple[int, int, int]], list[int]]:
+    if width > 255 or height > 255:
+        raise SystemExit(f"{name}: sprites are limited to 255x255")
+    palette: list[tuple[int, int, int]] = []
+    indices = []
+    for r, g, b, a in pixels:
+        if a < 128 or (r, g, b) == (0, 0, 0):
+            indices.append(0)
+            continue
+        if (r, g, b) not in palette:
+            palette.append((r, g, b))
+            if len(palette) > MAX_COLORS:
+                raise SystemExit(f"{name}: more than {MAX_COLORS} opaque colors; reduce the palette")
+        indices.append(palette.index((r, g, b)) + 1)
+
+    runs = []
+    for y in range(height):
+        row = indices[y * width:(y + 1) * width]
+        x = 0
+        while x < width:
+            value = row[x]
+            length = 1
+            while x + length < width and row[x + length] == value and length < MAX_RUN:
+                length += 1
+            runs.append((value << 6) | (length - 1))
+            x += length
+    while len(palette) < MAX_COLORS:
+        palette.append((0, 0, 0))
+    return palette, runs
+
+
+def camel(name: str) -> str:
+    return "".join(part[:1].upper() + part[1:] for part in re.split(r"[_\-\s]+", name) if part)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate the sprite atlas header from PNG/BMP images.")
+    parser.add_argument("images", nargs="+", type=Path, help="PNG or BMP files")
+    parser.add_argument("--out", default=Path("images/SpriteAtlas.generated.h"), type=Path, help="Output header path")
+    args = parser.parse_args()
+
+    sprites = []
+    for path in sorted(args.images, key=lambda p: p.stem):
+        width, height, pixels = load_image(path)
+        palette, runs = encode(path.stem, width, height, pixels)
+        sprites.append((path.stem, width, height, palette, runs))
+
+    data = []
+    descs = []
+    for name, width, height, palette, runs in sprites:
+        descs.append((name, width, height, len(data), palette))
+        data.extend(runs)
+    if len(data) > 0xFFFF:
+        raise SystemExit("atlas exceeds 64 KB of run data")
+
+    airlines = sorted(
+        (name[len("airline_"):].upper(), camel(name))
+        for name, *_ in sprites
+        if name.startswith("airline_")
+    )
+
+    ids_path = args.out.with_name("SpriteIds.generated.h")
+    ids = [
+        "// Auto-generated by tools/generate_sprite_atlas.py. Do not edit manually.",
+        "#pragma once",
+        "",
+        "#include <stdint.h>",
+        "",
+        "namespace Sprite",
+        "{",
+        "    enum : uint8_t",
+        "    {",
+        *[f"        {camel(name)}," for name, *_ in sprites],
+        "        Count,",
+        "    };",
+        "}",
+        "",
+    ]
+
+    lines = [
+        "// Auto-generated by tools/generate_sprite_atlas.py. Do not edit manually.",
+        "#pragma once",
+        "",
+        "#include <Arduino.h>",
+        f'#include "images/{ids_path.name}"',
+        "",
+        f"// {len(sprites)} sprites, {len(data)} bytes of run data.",
+        "",
+        "// Rows of runs: palette index (0 = transparent) << 6 | (run length - 1).",
+        "static const uint8_t kSpriteRuns[] PROGMEM = {",
+    ]
+    for (name, width, height, offset, _), sprite in zip(descs, sprites):
+        chunk = data[offset:offset + len(sprite[4])]
+        lines.append(f"    // {name} ({width}x{height})")
+        for i in range(0, len(chunk), 16):
+            lines.append("    " + ",".join(f"0x{v:02X}" for v in chunk[i:i + 16]) + ",")
+    lines += [
+        "};",
+        "",
+        "struct SpriteDesc",
+        "{",
+        "    uint8_t width;",
+        "    uint8_t height;",
+        "    uint16_t offset; // first run in kSpriteRuns",
+        "    uint8_t palette[3][3]; // RGB for indices 1..3",
+        "};",
+        "static const SpriteDesc kSprites[] PROGMEM = {",
+    ]
+    for name, width, height, offset, palette in descs:
+        pal = ", ".join("{%d, %d, %d}" % c for c in palette)
+        lines.append(f"    {{{width}, {height}, {offset}, {{{pal}}}}}, // {name}")
+    lines += [
+        "};",
+        "",
+        "// Operator ICAO code -> tail fin sprite, sorted by code.",
+        "struct AirlineSpriteEntry",
+        "{",
+        "    char icao[4];",
+        "    uint8_t sprite;",
+        "};",
+        "static const AirlineSpriteEntry kAirlineSprites[] PROGMEM = {",
+        *[f'    {{"{code}", Sprite::{ident}}},' for code, ident in airlines],
+        "};",
+        "static constexpr size_t kAirlineSprites_COUNT = sizeof(kAirlineSprites) / sizeof(kAirlineSprites[0]);",
+        "",
+    ]
+    args.out.parent.mkdir(parents=True, exist_ok=True)
+    ids_path.write_text("\n".join(ids), encoding="utf-8")
+    args.out.write_text("\n".join(lines), encoding="utf-8")
+    print(f"Wrote {args.out} (sprites={len(sprites)}, run bytes={len(data)}, airlines={len(airlines)})")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stdint.h>
+
+// Time-based step sequencer for display animations. An animation is a fixed number of
+// equal-length steps measured from its start time; the renderer asks which step is due
+// and draws it once. Late ticks skip straight to the current step instead of replaying
+// missed ones, so an animation always takes its nominal time regardless of frame rate.
+class Animation
+{
+public:
+    void start(uint16_t steps, unsigned long stepMs, unsigned long now)
+    {
+        m_steps = steps;
+        m_stepMs = stepMs == 0 ? 1 : stepMs;
+        m_startMs = now;
+        m_drawnStep = -1;
+        m_active = steps > 0;
+    }
+
+    void stop() { m_active = false; }
+    bool active() const { return m_active; }
+    uint16_t steps() const { return m_steps; }
+
+    // True once all steps have had their full duration.
+    bool finished(unsigned long now) const
+    {
+        return !m_active || now - m_startMs >= (unsigned long)m_steps * m_stepMs;
+    }
+
+    // Returns true with the due step when it has not been drawn yet.
+    bool advance(unsigned long now, uint16_t &step)
+    {
+        if (finished(now))
+            return false;
+        const unsigned long due = (now - m_startMs) / m_stepMs;
+        if ((long)due == m_drawnStep)
+            return false;
+        m_drawnStep = (long)due;
+        step = (uint16_t)due;
+        return true;
+    }
+
+    // When the next step (or the end of the last one) is due.
+    unsigned long nextStepMs() const
+    {
+        return m_startMs + (unsigned long)(m_drawnStep + 1) * m_stepMs;
+    }
+
+private:
+    unsigned long m_startMs = 0;
+    unsigned long m_stepMs = 1;
+    uint16_t m_steps = 0;
+    long m_drawnStep = -1;
+    bool m_active = false;
+};
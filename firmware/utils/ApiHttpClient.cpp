@@ -0,0 +1,405 @@
+/*
+Purpose: Shared HTTP layer for every outbound API call (OpenSky, AeroAPI, Open-Meteo).
+Responsibilities:
+- Build request URLs into fixed buffers and apply common HTTP/1.0, no-reuse settings.
+- Connect by the DnsCache address so requests skip a fresh lwIP lookup.
+- Track per-host circuit-breaker state with exponential, jittered backoff.
+- Honor Retry-After and OpenSky's X-Rate-Limit-* headers.
+- Clamp request timeouts to the fetch scheduler's per-pass deadline.
+- Expose the response body as a stream so callers can parse without buffering,
+  inflating gzip/deflate bodies when FW_HTTP_GZIP is enabled.
+*/
+#include "utils/ApiHttpClient.h"
+#include "utils/DnsCache.h"
+#include <stdarg.h>
+#include <ESP.h>
+
+namespace
+{
+    struct HostConfig
+    {
+        const char *name;
+        unsigned long baseBackoffMs;
+        unsigned long maxBackoffMs;
+    };
+
+    // Indexed by ApiHttp::Host.
+    const HostConfig kHostConfig[] = {
+        {"auth.opensky-network.org", 15000UL, 300000UL},
+        {"opensky-network.org", 15000UL, 300000UL},
+        {"aeroapi.flightaware.com", 5000UL, 120000UL},
+        {"api.open-meteo.com", 15000UL, 600000UL},
+    };
+    static_assert(sizeof(kHostConfig) / sizeof(kHostConfig[0]) == (size_t)ApiHttp::Host::Count,
+                  "kHostConfig must cover every ApiHttp::Host");
+
+    ApiHttp::HostHealth s_health[(size_t)ApiHttp::Host::Count];
+    unsigned long s_deadlineMs = 0;
+
+    const uint32_t kTlsMaxAllocHeap = 40000;
+
+    const char *kCollectedHeaders[] = {
+        "Retry-After",
+        "X-Rate-Limit-Remaining",
+        "X-Rate-Limit-Retry-After-Seconds",
+        "Content-Length",
+        "Transfer-Encoding",
+        "Content-Encoding",
+    };
+
+    unsigned long backoffMs(const HostConfig &cfg, uint8_t failures)
+    {
+        uint8_t shift = failures > 0 ? failures - 1 : 0;
+        if (shift > 10)
+            shift = 10;
+        unsigned long delayMs = cfg.baseBackoffMs << shift;
+        if (delayMs > cfg.maxBackoffMs || delayMs < cfg.baseBackoffMs)
+            delayMs = cfg.maxBackoffMs;
+        // Equal jitter: keep half of the delay, randomize the rest so retries spread out.
+        unsigned long half = delayMs / 2;
+        return half + (unsigned long)random((long)half + 1);
+    }
+
+    long headerSeconds(HTTPClient &http, const char *name)
+    {
+        String v = http.header(name);
+        if (v.length() == 0)
+            return -1;
+        // Only the delta-seconds form is supported; HTTP-date values parse as 0 and are ignored.
+        long secs = v.toInt();
+        return secs > 0 ? secs : -1;
+    }
+
+    void recordOutcome(ApiHttp::Host host, HTTPClient &http, int code)
+    {
+        const size_t idx = (size_t)host;
+        const HostConfig &cfg = kHostConfig[idx];
+        ApiHttp::HostHealth &h = s_health[idx];
+
+        if (code > 0)
+        {
+            String remaining = http.header("X-Rate-Limit-Remaining");
+            if (remaining.length())
+            {
+                h.rateLimitRemaining = remaining.toInt();
+            }
+        }
+
+        // Anything the server answered, other than throttling or a server error, proves the host is healthy.
+        const bool failed = code < 0 || code == 429 || code >= 500;
+        if (!failed)
+        {
+            if (h.state != ApiHttp::BreakerState::Closed)
+            {
+                Serial.printf("ApiHttp: %s recovered after %u failures\n", cfg.name, h.consecutiveFailures);
+            }
+            h.state = ApiHttp::BreakerState::Closed;
+            h.consecutiveFailures = 0;
+            h.openForMs = 0;
+            return;
+        }
+
+        if (h.consecutiveFailures < 255)
+        {
+            h.consecutiveFailures++;
+        }
+        unsigned long delayMs = backoffMs(cfg, h.consecutiveFailures);
+        if (code > 0)
+        {
+            long retryAfter = headerSeconds(http, "X-Rate-Limit-Retry-After-Seconds");
+            if (retryAfter < 0)
+            {
+                retryAfter = headerSeconds(http, "Retry-After");
+            }
+            if (retryAfter > 0)
+            {
+                delayMs = (unsigned long)retryAfter * 1000UL;
+            }
+        }
+
+        h.state = ApiHttp::BreakerState::Open;
+        h.openedMs = millis();
+        h.openForMs = delayMs;
+        Serial.printf("ApiHttp: %s failed (code %d, %u in a row); backing off %lu ms\n",
+                      cfg.name,
+                      code,
+                      h.consecutiveFailures,
+                      delayMs);
+    }
+
+    bool tryAcquire(ApiHttp::Host host)
+    {
+        ApiHttp::HostHealth &h = s_health[(size_t)host];
+        switch (h.state)
+        {
+        case ApiHttp::BreakerState::Closed:
+            return true;
+        case ApiHttp::BreakerState::HalfOpen:
+            return false; // a probe is already in flight
+        case ApiHttp::BreakerState::Open:
+        default:
+            if (millis() - h.openedMs < h.openForMs)
+                return false;
+            h.state = ApiHttp::BreakerState::HalfOpen;
+            return true;
+        }
+    }
+}
+
+const char *ApiHttp::hostName(Host host)
+{
+    return kHostConfig[(size_t)host].name;
+}
+
+const ApiHttp::HostHealth &ApiHttp::health(Host host)
+{
+    return s_health[(size_t)host];
+}
+
+bool ApiHttp::available(Host host)
+{
+    const HostHealth &h = s_health[(size_t)host];
+    if (h.state == BreakerState::Closed)
+        return true;
+    if (h.state == BreakerState::HalfOpen)
+        return false;
+    return millis() - h.openedMs >= h.openForMs;
+}
+
+bool ApiHttp::tlsHeapAvailable()
+{
+    return ESP.getFreeHeap() >= 70000 && ESP.getMaxAllocHeap() >= kTlsMaxAllocHeap;
+}
+
+void ApiHttp::setDeadline(unsigned long deadlineMs)
+{
+    s_deadlineMs = deadlineMs;
+}
+
+ApiHttp::Request::Request(Host host, WiFiClient &client)
+    : m_host(host), m_client(client)
+{
+    m_url[0] = '\0';
+}
+
+ApiHttp::Request::Request(Host host, WiFiClientSecure &client)
+    : m_host(host), m_client(client), m_secureClient(&client)
+{
+    m_url[0] = '\0';
+}
+
+ApiHttp::Request::~Request()
+{
+    end();
+}
+
+bool ApiHttp::Request::setUrl(const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    int len = vsnprintf(m_url, sizeof(m_url), fmt, args);
+    va_end(args);
+    if (len < 0 || (size_t)len >= sizeof(m_url))
+    {
+        Serial.printf("ApiHttp: URL for %s exceeds %u bytes\n", hostName(m_host), (unsigned)sizeof(m_url));
+        m_url[0] = '\0';
+        return false;
+    }
+
+    end();
+    if (!m_http.begin(m_client, m_url))
+    {
+        return false;
+    }
+    m_begun = true;
+    m_http.useHTTP10(true); // no chunked bodies; the stream ends at connection close
+    m_http.setReuse(false);
+    m_http.collectHeaders(kCollectedHeaders, sizeof(kCollectedHeaders) / sizeof(kCollectedHeaders[0]));
+    return true;
+}
+
+void ApiHttp::Request::addHeader(const char *name, const char *value)
+{
+    if (m_begun)
+    {
+        m_http.addHeader(name, value);
+    }
+}
+
+void ApiHttp::Request::acceptCompressed()
+{
+#if FW_HTTP_GZIP
+    if (ESP.getMaxAllocHeap() >= InflateStream::workingSetBytes() + kTlsMaxAllocHeap)
+    {
+        addHeader("Accept-Encoding", "gzip");
+        return;
+    }
+#endif
+    addHeader("Accept-Encoding", "identity");
+}
+
+int ApiHttp::Request::get()
+{
+    return send("GET", nullptr, 0);
+}
+
+int ApiHttp::Request::post(const uint8_t *body, size_t length)
+{
+    return send("POST", body, length);
+}
+
+int ApiHttp::Request::send(const char *method, const uint8_t *body, size_t length)
+{
+    if (!m_begun)
+    {
+        return HTTPC_ERROR_NOT_CONNECTED;
+    }
+    m_effectiveTimeoutMs = m_timeoutMs;
+    if (s_deadlineMs != 0)
+    {
+        const long remainingMs = (long)(s_deadlineMs - millis());
+        if (remainingMs <= 0)
+        {
+            Serial.printf("ApiHttp: %s request skipped; pass deadline reached\n", hostName(m_host));
+            return kDeadlineExceeded;
+        }
+        if ((unsigned long)remainingMs < m_effectiveTimeoutMs)
+        {
+            m_effectiveTimeoutMs = (uint16_t)remainingMs;
+        }
+    }
+    if (!tryAcquire(m_host))
+    {
+        Serial.printf("ApiHttp: %s circuit open; request skipped\n", hostName(m_host));
+        return kRejected;
+    }
+
+    connectCached();
+    m_http.setTimeout(m_effectiveTimeoutMs);
+    m_http.setFollowRedirects(m_followRedirects ? HTTPC_STRICT_FOLLOW_REDIRECTS : HTTPC_DISABLE_FOLLOW_REDIRECTS);
+    int code = m_http.sendRequest(method, const_cast<uint8_t *>(body), length);
+    recordOutcome(m_host, m_http, code);
+    return code;
+}
+
+void ApiHttp::Request::connectCached()
+{
+    IPAddress address;
+    if (!DnsCache::resolve(m_host, address))
+        return; // HTTPClient falls back to its own lookup
+
+    // HTTPClient reuses an already-connected client instead of resolving the host again.
+    int ok;
+    if (m_secureClient)
+    {
+        ok = m_secureClient->connect(address, 443, hostName(m_host), nullptr, nullptr, nullptr);
+    }
+    else
+    {
+        ok = m_client.connect(address, 80);
+    }
+    if (!ok)
+    {
+        Serial.printf("ApiHttp: connect to cached %s for %s failed; re-resolving\n",
+                      address.toString().c_str(),
+                      hostName(m_host));
+        DnsCache::invalidate(m_host);
+        m_client.stop();
+    }
+}
+
+Stream *ApiHttp::Request::body()
+{
+    if (!m_begun)
+        return nullptr;
+    if (m_body)
+        return m_body;
+    WiFiClient *stream = m_http.getStreamPtr();
+    if (!stream)
+        return nullptr;
+    stream->setTimeout(m_effectiveTimeoutMs);
+
+    String encoding = m_http.header("Content-Encoding");
+    encoding.trim();
+    if (encoding.length() == 0 || encoding.equalsIgnoreCase("identity"))
+    {
+        m_body = stream;
+        return m_body;
+    }
+
+#if FW_HTTP_GZIP
+    const bool gzip = encoding.equalsIgnoreCase("gzip") || encoding.equalsIgnoreCase("x-gzip");
+    const bool zlib = encoding.equalsIgnoreCase("deflate");
+    if (gzip || zlib)
+    {
+        m_inflate = new InflateStream();
+        if (m_inflate->begin(*stream, gzip ? InflateStream::Format::Gzip : InflateStream::Format::Zlib))
+        {
+            m_body = m_inflate;
+            return m_body;
+        }
+        delete m_inflate;
+        m_inflate = nullptr;
+        return nullptr;
+    }
+#endif
+    Serial.printf("ApiHttp: %s sent unsupported Content-Encoding '%s'\n", hostName(m_host), encoding.c_str());
+    return nullptr;
+}
+
+bool ApiHttp::Request::bodyIntact()
+{
+    if (!m_inflate)
+        return true;
+    // JSON parsers stop at the closing brace, before the trailer is reached.
+    char scratch[64];
+    while (m_inflate->readBytes(scratch, sizeof(scratch)) > 0)
+    {
+    }
+    if (m_inflate->failed())
+    {
+        Serial.printf("ApiHttp: %s sent a corrupt compressed body; discarding it\n", hostName(m_host));
+        return false;
+    }
+    return true;
+}
+
+size_t ApiHttp::Request::readBody(char *buffer, size_t capacity)
+{
+    if (capacity == 0)
+        return 0;
+    buffer[0] = '\0';
+    Stream *stream = body();
+    if (!stream)
+        return 0;
+
+    size_t want = capacity - 1;
+    // Content-Length counts the bytes on the wire; an inflated body runs past it.
+    int expected = m_inflate ? -1 : m_http.getSize();
+    if (expected >= 0 && (size_t)expected < want)
+    {
+        want = (size_t)expected;
+    }
+    size_t got = stream->readBytes(buffer, want);
+    buffer[got] = '\0';
+    return got;
+}
+
+void ApiHttp::Request::end()
+{
+    if (m_inflate)
+    {
+        Serial.printf("ApiHttp: %s inflated %u -> %u bytes\n",
+                      hostName(m_host),
+                      (unsigned)m_inflate->compressedBytes(),
+                      (unsigned)m_inflate->inflatedBytes());
+        delete m_inflate;
+        m_inflate = nullptr;
+    }
+    m_body = nullptr;
+    if (m_begun)
+    {
+        m_http.end();
+        m_begun = false;
+    }
+}
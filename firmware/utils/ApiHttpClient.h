@@ -0,0 +1,113 @@
+#pragma once
+
+#include <Arduino.h>
+#include <HTTPClient.h>
+#include <WiFiClientSecure.h>
+#include "utils/InflateStream.h"
+
+namespace ApiHttp
+{
+    // Every outbound host gets its own circuit breaker so a flaky service does not
+    // starve the others.
+    enum class Host : uint8_t
+    {
+        OpenSkyAuth = 0,
+        OpenSky,
+        AeroApi,
+        OpenMeteo,
+        Count
+    };
+
+    enum class BreakerState : uint8_t
+    {
+        Closed,  // requests flow normally
+        Open,    // failing; reject until the backoff expires
+        HalfOpen // backoff expired; a single probe request is in flight
+    };
+
+    struct HostHealth
+    {
+        BreakerState state = BreakerState::Closed;
+        uint8_t consecutiveFailures = 0;
+        unsigned long openedMs = 0;
+        unsigned long openForMs = 0;
+        long rateLimitRemaining = -1; // from X-Rate-Limit-Remaining, -1 if unknown
+    };
+
+    static const size_t kMaxUrlLen = 256;
+    static const size_t kMaxErrorBodyLen = 160;
+
+    const char *hostName(Host host);
+    const HostHealth &health(Host host);
+
+    // Non-mutating check: false while the breaker is open and its backoff has not
+    // expired. Requests re-check on send, where an expired breaker goes half-open and
+    // exactly one probe is let through.
+    bool available(Host host);
+
+    // True if there is enough contiguous heap left to start a TLS handshake.
+    bool tlsHeapAvailable();
+
+    // Caps every request sent from now on so it finishes by deadlineMs (a millis() value);
+    // 0 clears the cap. Set by FetchScheduler around each job step.
+    void setDeadline(unsigned long deadlineMs);
+
+    class Request
+    {
+    public:
+        Request(Host host, WiFiClient &client);
+        Request(Host host, WiFiClientSecure &client);
+        ~Request();
+
+        // Formats the request URL into a fixed buffer; fails (and logs) on overflow.
+        bool setUrl(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+        void addHeader(const char *name, const char *value);
+        void setTimeout(uint16_t timeoutMs) { m_timeoutMs = timeoutMs; }
+        // Timeout actually applied to the last send, after the deadline cap.
+        uint16_t timeoutMs() const { return m_effectiveTimeoutMs; }
+        void setFollowRedirects(bool follow) { m_followRedirects = follow; }
+        // Advertises gzip when built with FW_HTTP_GZIP and the heap can hold the inflater;
+        // otherwise asks for identity.
+        void acceptCompressed();
+
+        // Return the HTTP status, or a negative HTTPClient error. Both update the
+        // host's breaker; a rejected (breaker open) request returns kRejected.
+        int get();
+        int post(const uint8_t *body, size_t length);
+
+        // Streaming body reader for the current response, with the request timeout applied.
+        // gzip/deflate bodies are inflated on the fly; returns nullptr if they cannot be.
+        Stream *body();
+        // After parsing: reads what the parser left of an inflated body so the gzip trailer
+        // is checked. False means the data was corrupt or cut short and must be discarded.
+        bool bodyIntact();
+        // Reads at most capacity-1 bytes of the body into buffer (NUL-terminated); for error logs.
+        size_t readBody(char *buffer, size_t capacity);
+        int contentLength() { return m_http.getSize(); }
+        // The socket under body(), so readers can tell a closed connection from a slow one.
+        WiFiClient &connection() { return m_client; }
+        String header(const char *name) { return m_http.header(name); }
+
+        void end();
+
+        static const int kRejected = -100;
+        // The scheduler deadline had already passed; the breaker is left untouched.
+        static const int kDeadlineExceeded = -101;
+
+    private:
+        int send(const char *method, const uint8_t *body, size_t length);
+        void connectCached();
+
+        Host m_host;
+        WiFiClient &m_client;
+        WiFiClientSecure *m_secureClient = nullptr; // set when the request is HTTPS (needed for SNI)
+        HTTPClient m_http;
+        InflateStream *m_inflate = nullptr;
+        Stream *m_body = nullptr;
+        char m_url[kMaxUrlLen];
+        uint16_t m_timeoutMs = 15000;
+        uint16_t m_effectiveTimeoutMs = 15000;
+        bool m_followRedirects = false;
+        bool m_begun = false;
+    };
+}
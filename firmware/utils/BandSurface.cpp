@@ -0,0 +1,76 @@
+/*
+Purpose: Row-band back buffer for tear-free partial updates without a second DMA frame.
+Responsibilities:
+- Compose one band of panel rows off-screen (clipped to the band).
+- Commit the band (or a column window of it) as run-length spans so each panel pixel is
+  written once per update.
+*/
+#include "utils/BandSurface.h"
+#include <Arduino.h>
+
+bool BandSurface::begin(int16_t panelWidth, int16_t panelHeight)
+{
+    m_width = panelWidth;
+    m_panelHeight = panelHeight;
+    m_pixels.assign((size_t)panelWidth * kRows * 3, 0);
+    if (m_pixels.empty())
+    {
+        Serial.println("BandSurface: allocation failed");
+        return false;
+    }
+    return true;
+}
+
+void BandSurface::writeSpan(int16_t x, int16_t y, int16_t w, const Color &color)
+{
+    const int16_t row = y - m_originY;
+    if (row < 0 || row >= kRows || m_pixels.empty())
+        return;
+    uint8_t *p = &m_pixels[((size_t)row * m_width + x) * 3];
+    for (int16_t i = 0; i < w; ++i)
+    {
+        *p++ = color.r;
+        *p++ = color.g;
+        *p++ = color.b;
+    }
+}
+
+void BandSurface::writeRect(int16_t x, int16_t y, int16_t w, int16_t h, const Color &color)
+{
+    for (int16_t row = 0; row < h; ++row)
+    {
+        writeSpan(x, y + row, w, color);
+    }
+}
+
+void BandSurface::commit(RenderSurface &panel, int16_t x0, int16_t x1) const
+{
+    if (m_pixels.empty())
+        return;
+    if (x0 < 0)
+        x0 = 0;
+    if (x1 > m_width)
+        x1 = m_width;
+    for (int16_t row = 0; row < kRows; ++row)
+    {
+        const int16_t py = m_originY + row;
+        if (py < 0 || py >= m_panelHeight)
+            continue;
+        const uint8_t *line = &m_pixels[(size_t)row * m_width * 3];
+        int16_t x = x0;
+        while (x < x1)
+        {
+            const uint8_t *start = line + (size_t)x * 3;
+            int16_t run = 1;
+            while (x + run < x1)
+            {
+                const uint8_t *next = line + (size_t)(x + run) * 3;
+                if (next[0] != start[0] || next[1] != start[1] || next[2] != start[2])
+                    break;
+                ++run;
+            }
+            panel.hline(x, py, run, rgb(start[0], start[1], start[2]));
+            x += run;
+        }
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <stddef.h>
+#include <vector>
+#include "utils/RenderSurface.h"
+
+// Off-screen back buffer for one band of kRows panel rows (RGB888, 3 bytes per pixel).
+// Drawing uses panel coordinates; anything outside the band is dropped. commit() then
+// writes every pixel of the band to the panel exactly once, as same-color runs, so a
+// redrawn row never shows its cleared (black) intermediate state.
+class BandSurface : public RenderSurface
+{
+public:
+    static const int16_t kRows = 8;
+
+    bool begin(int16_t panelWidth, int16_t panelHeight);
+    bool ready() const { return !m_pixels.empty(); }
+    size_t bytes() const { return m_pixels.size(); }
+
+    // Moves the band to panel rows [y, y + kRows).
+    void setOrigin(int16_t y) { m_originY = y; }
+    int16_t origin() const { return m_originY; }
+    void commit(RenderSurface &panel) const { commit(panel, 0, m_width); }
+    // Writes only columns [x0, x1), so a pane's band leaves its neighbours untouched.
+    void commit(RenderSurface &panel, int16_t x0, int16_t x1) const;
+
+    int16_t width() const override { return m_width; }
+    int16_t height() const override { return m_panelHeight; }
+
+protected:
+    void writeSpan(int16_t x, int16_t y, int16_t w, const Color &color) override;
+    void writeRect(int16_t x, int16_t y, int16_t w, int16_t h, const Color &color) override;
+
+private:
+    std::vector<uint8_t> m_pixels;
+    int16_t m_width = 0;
+    int16_t m_panelHeight = 0;
+    int16_t m_originY = 0;
+};
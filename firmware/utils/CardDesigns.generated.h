@@ -0,0 +1,78 @@
+// Auto-generated by tools/generate_card_designs.py. Do not edit manually.
+#pragma once
+
+#include "utils/CardLayout.h"
+
+// 3 designs, 18 rows, 35 segments.
+static constexpr uint8_t kCardDesignMaxLines = 6;
+static constexpr uint8_t kCardDesignMaxPieces = 15;
+static constexpr uint8_t kCardDesignMaxStrips = 10;
+
+namespace CardLayout
+{
+    static constexpr Segment kSegments[] = {
+        {Field::AirlineFin, ColorRole::Text, 0, nullptr},
+        {Field::Airline, ColorRole::Text, 1, nullptr},
+        {Field::OriginCode, ColorRole::Origin, 0, nullptr},
+        {Field::Arrow, ColorRole::White, 6, nullptr},
+        {Field::DestCode, ColorRole::Destination, 5, nullptr},
+        {Field::Aircraft, ColorRole::Text, 0, nullptr},
+        {Field::OriginCity, ColorRole::Origin, 0, nullptr},
+        {Field::Arrow, ColorRole::White, 3, nullptr},
+        {Field::DestCity, ColorRole::Destination, 3, nullptr},
+        {Field::Callsign, ColorRole::Text, 0, nullptr},
+        {Field::Literal, ColorRole::Text, 0, "  -  "},
+        {Field::Altitude, ColorRole::Text, 0, nullptr},
+        {Field::Literal, ColorRole::Text, 0, "  -  "},
+        {Field::Speed, ColorRole::Text, 0, nullptr},
+        {Field::OriginCode, ColorRole::Origin, 0, nullptr},
+        {Field::Arrow, ColorRole::White, 6, nullptr},
+        {Field::DestCode, ColorRole::Destination, 5, nullptr},
+        {Field::OriginCity, ColorRole::Origin, 0, nullptr},
+        {Field::Arrow, ColorRole::White, 3, nullptr},
+        {Field::DestCity, ColorRole::Destination, 3, nullptr},
+        {Field::Aircraft, ColorRole::Text, 0, nullptr},
+        {Field::AirlineFin, ColorRole::Text, 0, nullptr},
+        {Field::Airline, ColorRole::Text, 1, nullptr},
+        {Field::Altitude, ColorRole::Text, 0, nullptr},
+        {Field::Literal, ColorRole::Dim, 0, " / "},
+        {Field::Speed, ColorRole::Text, 0, nullptr},
+        {Field::AirlineFin, ColorRole::Text, 0, nullptr},
+        {Field::Airline, ColorRole::Text, 1, nullptr},
+        {Field::Callsign, ColorRole::Text, 0, nullptr},
+        {Field::AircraftCode, ColorRole::Dim, 6, nullptr},
+        {Field::Aircraft, ColorRole::Text, 0, nullptr},
+        {Field::Literal, ColorRole::Dim, 0, "ALT "},
+        {Field::Altitude, ColorRole::Text, 0, nullptr},
+        {Field::Literal, ColorRole::Dim, 0, "SPD "},
+        {Field::Speed, ColorRole::Text, 0, nullptr},
+    };
+
+    static constexpr Row kRows[] = {
+        {RowKind::Progress, Anchor::Top, 0, 2, TextStrip::Font::Glcd, Align::Left, Overflow::Clip, 0, 0, 0}, // classic row 0
+        {RowKind::Line, Anchor::Top, 1, 0, TextStrip::Font::Compact, Align::Left, Overflow::Marquee, 1, 0, 2}, // classic row 1
+        {RowKind::Line, Anchor::Top, 4, 0, TextStrip::Font::Glcd, Align::Center, Overflow::Clip, 1, 2, 3}, // classic row 2
+        {RowKind::Line, Anchor::Top, 2, 0, TextStrip::Font::Glcd, Align::Center, Overflow::Wrap, 1, 5, 1}, // classic row 3
+        {RowKind::Line, Anchor::Bottom, 1, 0, TextStrip::Font::Compact, Align::Left, Overflow::Marquee, 1, 6, 3}, // classic row 4
+        {RowKind::Line, Anchor::Bottom, 1, 0, TextStrip::Font::Compact, Align::Left, Overflow::Marquee, 1, 9, 5}, // classic row 5
+        {RowKind::Progress, Anchor::Top, 0, 2, TextStrip::Font::Glcd, Align::Left, Overflow::Clip, 0, 14, 0}, // route row 0
+        {RowKind::Line, Anchor::Top, 1, 0, TextStrip::Font::Glcd, Align::Center, Overflow::Clip, 1, 14, 3}, // route row 1
+        {RowKind::Line, Anchor::Top, 2, 0, TextStrip::Font::Compact, Align::Left, Overflow::Marquee, 1, 17, 3}, // route row 2
+        {RowKind::Line, Anchor::Top, 3, 0, TextStrip::Font::Glcd, Align::Center, Overflow::Wrap, 1, 20, 1}, // route row 3
+        {RowKind::Line, Anchor::Bottom, 1, 0, TextStrip::Font::Compact, Align::Left, Overflow::Marquee, 1, 21, 2}, // route row 4
+        {RowKind::Line, Anchor::Bottom, 1, 0, TextStrip::Font::Compact, Align::Center, Overflow::Marquee, 1, 23, 3}, // route row 5
+        {RowKind::Progress, Anchor::Top, 0, 2, TextStrip::Font::Glcd, Align::Left, Overflow::Clip, 0, 26, 0}, // spotter row 0
+        {RowKind::Line, Anchor::Top, 1, 0, TextStrip::Font::Compact, Align::Left, Overflow::Marquee, 1, 26, 2}, // spotter row 1
+        {RowKind::Line, Anchor::Top, 4, 0, TextStrip::Font::Glcd, Align::Center, Overflow::Truncate, 1, 28, 2}, // spotter row 2
+        {RowKind::Line, Anchor::Top, 2, 0, TextStrip::Font::Glcd, Align::Center, Overflow::Wrap, 1, 30, 1}, // spotter row 3
+        {RowKind::Line, Anchor::Bottom, 1, 0, TextStrip::Font::Compact, Align::Center, Overflow::Clip, 1, 31, 2}, // spotter row 4
+        {RowKind::Line, Anchor::Bottom, 1, 0, TextStrip::Font::Compact, Align::Center, Overflow::Clip, 1, 33, 2}, // spotter row 5
+    };
+
+    static constexpr Design kDesigns[] = {
+        {"classic", "Classic", 0, 6},
+        {"route", "Route first", 6, 6},
+        {"spotter", "Spotter", 12, 6},
+    };
+    static constexpr size_t kDesigns_COUNT = sizeof(kDesigns) / sizeof(kDesigns[0]);
+}
@@ -0,0 +1,33 @@
+/*
+Purpose: Give the display access to the compiled flight card designs.
+Responsibilities:
+- Expose the constexpr design, row and segment tables from CardDesigns.generated.h.
+- Check at compile time that every design fits the renderer's per-card capacity.
+*/
+#include "utils/CardLayout.h"
+#include "utils/CardDesigns.generated.h"
+
+static_assert(kCardDesignMaxLines <= CardLayout::kMaxLines, "regenerate CardDesigns.generated.h");
+static_assert(kCardDesignMaxPieces <= CardLayout::kMaxPieces, "regenerate CardDesigns.generated.h");
+static_assert(kCardDesignMaxStrips <= CardLayout::kMaxStrips, "regenerate CardDesigns.generated.h");
+static_assert(CardLayout::kDesigns_COUNT > 0, "at least one card design is required");
+
+uint8_t CardLayout::designCount()
+{
+    return (uint8_t)kDesigns_COUNT;
+}
+
+const CardLayout::Design &CardLayout::design(uint8_t index)
+{
+    return kDesigns[index < kDesigns_COUNT ? index : 0];
+}
+
+const CardLayout::Row &CardLayout::row(const Design &design, uint8_t index)
+{
+    return kRows[design.firstRow + index];
+}
+
+const CardLayout::Segment &CardLayout::segment(const Row &row, uint8_t index)
+{
+    return kSegments[row.firstSegment + index];
+}
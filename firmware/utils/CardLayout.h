@@ -0,0 +1,106 @@
+#pragma once
+
+#include <Arduino.h>
+#include "utils/TextStrip.h"
+
+// Flight card designs as data. Each design is a list of rows (progress bar or text line);
+// a line is a list of segments (flight fields, literals, arrows, the airline tail fin)
+// with a font, alignment, overflow policy and per-segment colors. The tables are
+// constexpr, compiled from tools/card_designs.json by tools/generate_card_designs.py into
+// CardDesigns.generated.h; NeoMatrixDisplay lays out and draws any design from them.
+namespace CardLayout
+{
+    // Per-card capacity of the renderer; the generator rejects designs that need more.
+    constexpr uint8_t kMaxLines = 8;   // text lines after wrapping
+    constexpr uint8_t kMaxPieces = 16; // strips, arrows and sprites over all lines
+    constexpr uint8_t kMaxStrips = 10; // text pieces (same-colored segments are merged)
+
+    enum class Field : uint8_t
+    {
+        Airline,      // display name, else operator/ident codes
+        AirlineFin,   // tail fin sprite of the operator; omitted when there is none
+        OriginCode,   // IATA, else ICAO
+        DestCode,
+        OriginCity,   // "---" when unknown
+        DestCity,
+        Aircraft,     // "Maker Model", e.g. "Airbus A350-900"
+        AircraftCode, // ICAO type designator, e.g. "A359"
+        Callsign,
+        Altitude,     // in the configured unit, with suffix
+        Speed,
+        Literal,      // Segment::text
+        Arrow,        // solid right-pointing arrow, 7 px wide
+    };
+
+    enum class ColorRole : uint8_t
+    {
+        Text,        // configured text color
+        Dim,         // text color at a third
+        Origin,      // soft teal
+        Destination, // soft amber
+        White,
+    };
+
+    enum class Align : uint8_t
+    {
+        Left,
+        Center,
+        Right,
+    };
+
+    enum class Overflow : uint8_t
+    {
+        Clip,     // draw from the aligned start, cut at the pane edge
+        Truncate, // shorten the last text piece with "..."
+        Marquee,  // scroll when wider than the pane; leading sprites stay put
+        Wrap,     // break at the first space onto a second line, each truncated
+    };
+
+    enum class Anchor : uint8_t
+    {
+        Top,    // stacked down from the pane top
+        Bottom, // stacked up from the pane bottom, last row lowest
+    };
+
+    enum class RowKind : uint8_t
+    {
+        Progress, // one segment per flight in the cycle, current one lit
+        Line,
+    };
+
+    struct Segment
+    {
+        Field field;
+        ColorRole color;
+        uint8_t gap;      // blank columns before the segment (dropped when it leads the line)
+        const char *text; // Field::Literal only
+    };
+
+    struct Row
+    {
+        RowKind kind;
+        Anchor anchor;
+        uint8_t gap;     // blank rows above (Top) or below (Bottom) the row
+        uint8_t height;  // Progress only; lines are TextStrip::kHeight
+        TextStrip::Font font;
+        Align align;
+        Overflow overflow;
+        uint8_t lineGap; // between the two lines of a wrapped row
+        uint8_t firstSegment;
+        uint8_t segmentCount;
+    };
+
+    struct Design
+    {
+        const char *name;  // stable id for settings
+        const char *label; // shown in the settings page
+        uint8_t firstRow;
+        uint8_t rowCount;
+    };
+
+    uint8_t designCount();
+    // Out-of-range indices fall back to design 0.
+    const Design &design(uint8_t index);
+    const Row &row(const Design &design, uint8_t index);
+    const Segment &segment(const Row &row, uint8_t index);
+}
@@ -0,0 +1,58 @@
+/*
+Purpose: Predict how close, and how soon, each aircraft passes the center.
+Responsibilities:
+- Turn each state vector's range/bearing and track/speed into a position and velocity
+  on a local east/north plane, in float.
+- Solve for the time of minimum distance, clamped to [0, kHorizonS], and the distance
+  then, for the whole fetch in one pass.
+- Provide the ordering used to rank aircraft by predicted pass.
+*/
+#include "utils/ClosestApproach.h"
+#include "utils/GeoUtils.h"
+
+void ClosestApproach::predict(std::vector<StateVector> &states)
+{
+    for (StateVector &s : states)
+    {
+        if (isnan(s.distance_km) || isnan(s.bearing_deg))
+        {
+            s.cpa_distance_km = NAN;
+            s.cpa_time_s = NAN;
+            continue;
+        }
+        s.cpa_distance_km = s.distance_km;
+        s.cpa_time_s = 0;
+        if (s.on_ground || isnan(s.heading) || isnan(s.velocity) || s.velocity <= 0)
+            continue;
+
+        // Position (km) and velocity (km/s) relative to the center.
+        float px, py, vx, vy;
+        polarToEastNorth((float)s.distance_km, (float)s.bearing_deg, px, py);
+        const float speed = (float)s.velocity / 1000.0f;
+        polarToEastNorth(speed, (float)s.heading, vx, vy);
+
+        // |p + v t| is smallest at t = -(p . v) / |v|^2.
+        float t = -(px * vx + py * vy) / (speed * speed);
+        if (t <= 0.0f)
+            continue; // moving away: the closest point is now
+        if (t > kHorizonS)
+            t = kHorizonS;
+        const float cx = px + vx * t;
+        const float cy = py + vy * t;
+        s.cpa_distance_km = sqrtf(cx * cx + cy * cy);
+        s.cpa_time_s = t;
+    }
+}
+
+bool ClosestApproach::before(const StateVector &a, const StateVector &b)
+{
+    const bool aKnown = !isnan(a.cpa_distance_km);
+    const bool bKnown = !isnan(b.cpa_distance_km);
+    if (aKnown != bKnown)
+        return aKnown;
+    if (!aKnown)
+        return false;
+    if (a.cpa_distance_km != b.cpa_distance_km)
+        return a.cpa_distance_km < b.cpa_distance_km;
+    return a.cpa_time_s < b.cpa_time_s;
+}
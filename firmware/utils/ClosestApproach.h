@@ -0,0 +1,25 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include "models/StateVector.h"
+
+// Closest point of approach to the configured center: assuming an aircraft holds its
+// track and ground speed, how near it will pass (cpa_distance_km) and in how many
+// seconds (cpa_time_s, 0 if it is already moving away). Computed in single precision on
+// a flat plane around the center, which is what the ESP32's FPU does natively and is
+// accurate to well under a pixel within the fetch radius.
+class ClosestApproach
+{
+public:
+    static constexpr float kHorizonS = 600.0f; // look ahead at most this far
+
+    // Fills cpa_distance_km/cpa_time_s of every state vector from its distance_km,
+    // bearing_deg, heading and velocity. Aircraft on the ground or without a track keep
+    // their current distance, reached now; without a position both stay NAN.
+    static void predict(std::vector<StateVector> &states);
+
+    // Order for "overhead soon": nearest predicted pass first, then soonest; aircraft
+    // without a prediction last.
+    static bool before(const StateVector &a, const StateVector &b);
+};
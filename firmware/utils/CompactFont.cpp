@@ -0,0 +1,96 @@
+/*
+Purpose: Measure and rasterize text in the compact proportional font.
+Responsibilities:
+- Look up glyph columns and widths in the packed PROGMEM atlas.
+- Apply the generated kerning pairs (binary search over a sorted pair table).
+- Set text into 1bpp row-major bitmaps such as TextStrip's.
+*/
+#include "utils/CompactFont.h"
+#include "utils/CompactFont.generated.h"
+
+static_assert(kCompactFontHeight == CompactFont::kHeight, "regenerate CompactFont.generated.h");
+
+namespace
+{
+    uint8_t glyphIndex(char c)
+    {
+        const uint8_t code = (uint8_t)c;
+        if (code < kCompactFontFirst || code > kCompactFontLast)
+            return (uint8_t)('?' - kCompactFontFirst);
+        return (uint8_t)(code - kCompactFontFirst);
+    }
+
+    uint16_t glyphOffset(uint8_t index)
+    {
+        return pgm_read_word(&kCompactFontOffsets[index]);
+    }
+
+    // Printable stand-in, so kerning and rendering agree with glyphWidth().
+    char printable(char c)
+    {
+        return (char)(glyphIndex(c) + kCompactFontFirst);
+    }
+}
+
+int16_t CompactFont::glyphWidth(char c)
+{
+    const uint8_t index = glyphIndex(c);
+    return (int16_t)(glyphOffset(index + 1) - glyphOffset(index));
+}
+
+int8_t CompactFont::kerning(char left, char right)
+{
+    const uint16_t key = (uint16_t)(((uint8_t)printable(left) << 8) | (uint8_t)printable(right));
+    size_t lo = 0;
+    size_t hi = kCompactFontKerning_COUNT;
+    while (lo < hi)
+    {
+        const size_t mid = (lo + hi) / 2;
+        const uint16_t pair = pgm_read_word(&kCompactFontKerning[mid].pair);
+        if (pair == key)
+            return (int8_t)pgm_read_byte(&kCompactFontKerning[mid].adjust);
+        if (pair < key)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return 0;
+}
+
+int16_t CompactFont::textWidth(const char *text, size_t len)
+{
+    if (len == 0)
+        return 0;
+    int16_t width = 0;
+    for (size_t i = 0; i < len; ++i)
+    {
+        width += glyphWidth(text[i]);
+        if (i + 1 < len)
+            width += kTracking + kerning(text[i], text[i + 1]);
+    }
+    return width;
+}
+
+void CompactFont::render(const char *text, size_t len, uint8_t *bits, int16_t stride, int16_t y)
+{
+    int16_t x = 0;
+    for (size_t i = 0; i < len; ++i)
+    {
+        const uint8_t index = glyphIndex(text[i]);
+        const uint16_t start = glyphOffset(index);
+        const uint16_t end = glyphOffset(index + 1);
+        for (uint16_t col = start; col < end; ++col, ++x)
+        {
+            const uint8_t column = pgm_read_byte(&kCompactFontAtlas[col]);
+            if (column == 0 || x < 0 || x >= stride * 8)
+                continue;
+            for (int16_t row = 0; row < kHeight; ++row)
+            {
+                if (column & (1 << row))
+                    bits[(size_t)(y + row) * stride + (x >> 3)] |= (uint8_t)(0x80 >> (x & 7));
+            }
+        }
+        if (i + 1 < len)
+            x += kTracking + kerning(text[i], text[i + 1]);
+    }
+}
@@ -0,0 +1,64 @@
+// Auto-generated by tools/generate_compact_font.py. Do not edit manually.
+#pragma once
+
+#include <Arduino.h>
+
+// 95 glyphs (' '..'~'), 275 columns, 102 kerning pairs.
+static const uint8_t kCompactFontFirst = 32;
+static const uint8_t kCompactFontLast = 126;
+static const int16_t kCompactFontHeight = 6;
+
+// One byte per glyph column, bit 0 = top row.
+static const uint8_t kCompactFontAtlas[] PROGMEM = {
+    0x00,0x00,0x17,0x03,0x00,0x03,0x0A,0x1F,0x0A,0x1F,0x0A,0x16,0x1F,0x0D,0x19,0x04,
+    0x13,0x0A,0x15,0x1A,0x03,0x0E,0x11,0x11,0x0E,0x0A,0x04,0x0A,0x04,0x0E,0x04,0x30,
+    0x04,0x04,0x04,0x10,0x18,0x04,0x03,0x1F,0x11,0x1F,0x12,0x1F,0x10,0x19,0x15,0x12,
+    0x11,0x15,0x0A,0x07,0x04,0x1F,0x17,0x15,0x09,0x1E,0x15,0x1D,0x01,0x1D,0x03,0x1F,
+    0x15,0x1F,0x17,0x15,0x0F,0x0A,0x1A,0x04,0x0A,0x11,0x0A,0x0A,0x0A,0x11,0x0A,0x04,
+    0x01,0x15,0x02,0x0E,0x11,0x17,0x06,0x1E,0x05,0x1E,0x1F,0x15,0x0A,0x0E,0x11,0x11,
+    0x1F,0x11,0x0E,0x1F,0x15,0x11,0x1F,0x05,0x01,0x0E,0x11,0x1D,0x1F,0x04,0x1F,0x11,
+    0x1F,0x11,0x08,0x10,0x0F,0x1F,0x04,0x1B,0x1F,0x10,0x10,0x1F,0x02,0x04,0x02,0x1F,
+    0x1F,0x02,0x04,0x1F,0x0E,0x11,0x11,0x0E,0x1F,0x05,0x02,0x0E,0x11,0x09,0x16,0x1F,
+    0x05,0x1A,0x12,0x15,0x09,0x01,0x1F,0x01,0x1F,0x10,0x1F,0x0F,0x10,0x0F,0x1F,0x08,
+    0x04,0x08,0x1F,0x1B,0x04,0x1B,0x03,0x1C,0x03,0x19,0x15,0x13,0x1F,0x11,0x03,0x04,
+    0x18,0x11,0x1F,0x02,0x01,0x02,0x10,0x10,0x10,0x01,0x02,0x0C,0x12,0x1E,0x1F,0x12,
+    0x0C,0x0C,0x12,0x12,0x0C,0x12,0x1F,0x0C,0x16,0x14,0x1E,0x05,0x01,0x24,0x2A,0x1E,
+    0x1F,0x04,0x18,0x1D,0x20,0x1D,0x1F,0x08,0x14,0x1F,0x1E,0x02,0x1C,0x02,0x1C,0x1E,
+    0x02,0x1C,0x0C,0x12,0x0C,0x3E,0x0A,0x04,0x04,0x0A,0x3E,0x1E,0x04,0x02,0x14,0x12,
+    0x0A,0x02,0x0F,0x12,0x0E,0x10,0x1E,0x0E,0x10,0x0E,0x0E,0x10,0x08,0x10,0x0E,0x12,
+    0x0C,0x12,0x26,0x28,0x1E,0x1A,0x12,0x16,0x04,0x1F,0x11,0x1F,0x11,0x1F,0x04,0x04,
+    0x02,0x04,0x02,
+};
+
+// Glyph i spans columns [offset[i], offset[i + 1]) of the atlas.
+static const uint16_t kCompactFontOffsets[] PROGMEM = {
+    0,2,3,6,11,14,17,20,21,23,25,28,31,32,35,36,
+    39,42,45,48,51,54,57,60,63,66,69,70,71,74,77,80,
+    83,87,90,93,96,99,102,105,108,111,114,117,120,123,128,132,
+    136,139,143,146,149,152,155,158,163,166,169,172,174,177,179,182,
+    185,187,190,193,196,199,202,205,208,211,212,214,217,218,223,226,
+    229,232,235,238,241,244,247,250,255,258,261,264,267,268,271,275,
+};
+
+// (left << 8 | right) sorted ascending, with the column adjustment for that pair.
+struct CompactFontKern
+{
+    uint16_t pair;
+    int8_t adjust;
+};
+static const CompactFontKern kCompactFontKerning[] PROGMEM = {
+    {0x2C2D,-1},{0x2C54,-1},{0x2C59,-1},{0x2C71,-1},{0x2C74,-1},{0x2D2C,-1},{0x2D2E,-1},{0x2D49,-1},
+    {0x2D54,-1},{0x2D6A,-1},{0x2E2D,-1},{0x2E54,-1},{0x2E59,-1},{0x2E71,-1},{0x2E74,-1},{0x426A,-1},
+    {0x432D,-1},{0x4371,-1},{0x446A,-1},{0x452D,-1},{0x4571,-1},{0x462C,-1},{0x462D,-1},{0x462E,-1},
+    {0x464A,-1},{0x4661,-1},{0x4663,-1},{0x4664,-1},{0x4665,-1},{0x4667,-1},{0x466A,-1},{0x466F,-1},
+    {0x4671,-1},{0x4673,-1},{0x492D,-1},{0x4971,-1},{0x4A6A,-1},{0x4C2D,-1},{0x4C54,-1},{0x4C59,-1},
+    {0x4C71,-1},{0x4C74,-1},{0x4F6A,-1},{0x502C,-1},{0x502E,-1},{0x504A,-1},{0x506A,-1},{0x536A,-1},
+    {0x542C,-1},{0x542D,-1},{0x542E,-1},{0x544A,-1},{0x5461,-1},{0x5463,-1},{0x5464,-1},{0x5465,-1},
+    {0x5467,-1},{0x546A,-1},{0x546F,-1},{0x5471,-1},{0x5473,-1},{0x566A,-1},{0x592C,-1},{0x592E,-1},
+    {0x594A,-1},{0x596A,-1},{0x6254,-1},{0x626A,-1},{0x6554,-1},{0x662C,-1},{0x662D,-1},{0x662E,-1},
+    {0x664A,-1},{0x6661,-1},{0x6663,-1},{0x6664,-1},{0x6665,-1},{0x6667,-1},{0x666A,-1},{0x666F,-1},
+    {0x6671,-1},{0x6673,-1},{0x6854,-1},{0x6859,-1},{0x6874,-1},{0x6B54,-1},{0x6D54,-1},{0x6E54,-1},
+    {0x6F54,-1},{0x6F6A,-1},{0x702C,-1},{0x702E,-1},{0x7049,-1},{0x7054,-1},{0x706A,-1},{0x722C,-1},
+    {0x722E,-1},{0x724A,-1},{0x726A,-1},{0x736A,-1},{0x766A,-1},{0x776A,-1},
+};
+static constexpr size_t kCompactFontKerning_COUNT = sizeof(kCompactFontKerning) / sizeof(kCompactFontKerning[0]);
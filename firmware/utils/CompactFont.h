@@ -0,0 +1,26 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Proportional 5 px font (caps and digits 5 rows, one descender row) for card lines that
+// would need a marquee in the 6x8 GFX font. Glyph columns, widths and kerning pairs live
+// in PROGMEM (CompactFont.generated.h, built by tools/generate_compact_font.py).
+namespace CompactFont
+{
+    constexpr int16_t kHeight = 6;
+    constexpr int16_t kTracking = 1; // blank columns between glyphs, before kerning
+
+    // Columns of one glyph; characters outside ' '..'~' are drawn as '?'.
+    int16_t glyphWidth(char c);
+
+    // Column adjustment between two adjacent glyphs (0 or negative).
+    int8_t kerning(char left, char right);
+
+    // Width in pixels of the set text, tracking and kerning included.
+    int16_t textWidth(const char *text, size_t len);
+    inline int16_t textWidth(const String &text) { return textWidth(text.c_str(), text.length()); }
+
+    // ORs the glyphs into a 1bpp row-major bitmap (MSB first, stride bytes per row) with
+    // the text's top row at y. The bitmap must be at least textWidth() columns wide.
+    void render(const char *text, size_t len, uint8_t *bits, int16_t stride, int16_t y);
+}
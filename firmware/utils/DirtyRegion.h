@@ -0,0 +1,96 @@
+#pragma once
+
+#include <stdint.h>
+
+// Fixed-capacity set of damaged rectangles for one frame, clipped to the panel. Touching
+// or overlapping rects are merged on insert; once full, new damage is merged into the
+// first rect so the region can only grow and never drops damage.
+class DirtyRegion
+{
+public:
+    struct Rect
+    {
+        int16_t x = 0;
+        int16_t y = 0;
+        int16_t w = 0;
+        int16_t h = 0;
+
+        int32_t area() const { return (int32_t)w * h; }
+    };
+
+    static const uint8_t kMaxRects = 8;
+
+    void setBounds(int16_t width, int16_t height)
+    {
+        m_width = width;
+        m_height = height;
+    }
+
+    void clear() { m_count = 0; }
+    bool empty() const { return m_count == 0; }
+    uint8_t count() const { return m_count; }
+    const Rect &operator[](uint8_t i) const { return m_rects[i]; }
+
+    void add(int16_t x, int16_t y, int16_t w, int16_t h)
+    {
+        Rect r;
+        int16_t x1 = x + w;
+        int16_t y1 = y + h;
+        r.x = x < 0 ? 0 : x;
+        r.y = y < 0 ? 0 : y;
+        if (x1 > m_width) x1 = m_width;
+        if (y1 > m_height) y1 = m_height;
+        r.w = x1 - r.x;
+        r.h = y1 - r.y;
+        if (r.w <= 0 || r.h <= 0)
+            return;
+
+        for (uint8_t i = 0; i < m_count; ++i)
+        {
+            if (touches(m_rects[i], r))
+            {
+                m_rects[i] = unite(m_rects[i], r);
+                return;
+            }
+        }
+        if (m_count < kMaxRects)
+        {
+            m_rects[m_count++] = r;
+            return;
+        }
+        m_rects[0] = unite(m_rects[0], r);
+    }
+
+    int32_t area() const
+    {
+        int32_t total = 0;
+        for (uint8_t i = 0; i < m_count; ++i)
+        {
+            total += m_rects[i].area();
+        }
+        return total;
+    }
+
+private:
+    static bool touches(const Rect &a, const Rect &b)
+    {
+        return a.x <= b.x + b.w && b.x <= a.x + a.w && a.y <= b.y + b.h && b.y <= a.y + a.h;
+    }
+
+    static Rect unite(const Rect &a, const Rect &b)
+    {
+        Rect u;
+        u.x = a.x < b.x ? a.x : b.x;
+        u.y = a.y < b.y ? a.y : b.y;
+        const int16_t ax1 = a.x + a.w, bx1 = b.x + b.w;
+        const int16_t ay1 = a.y + a.h, by1 = b.y + b.h;
+        u.w = (ax1 > bx1 ? ax1 : bx1) - u.x;
+        u.h = (ay1 > by1 ? ay1 : by1) - u.y;
+        return u;
+    }
+
+    Rect m_rects[kMaxRects];
+    uint8_t m_count = 0;
+    int16_t m_width = 0;
+    int16_t m_height = 0;
+};
@@ -0,0 +1,126 @@
+#include "utils/DnsCache.h"
+#include <WiFi.h>
+
+namespace
+{
+    struct Entry
+    {
+        IPAddress address;
+        unsigned long resolvedMs = 0;
+        bool valid = false;
+        bool refreshPending = false;
+    };
+
+    const size_t kHostCount = (size_t)ApiHttp::Host::Count;
+    Entry s_entries[kHostCount];
+    DnsCache::HostStats s_stats[kHostCount];
+
+    bool lookup(ApiHttp::Host host)
+    {
+        const size_t idx = (size_t)host;
+        Entry &e = s_entries[idx];
+        DnsCache::HostStats &st = s_stats[idx];
+
+        IPAddress resolved;
+        const unsigned long startMs = millis();
+        bool ok = WiFi.hostByName(ApiHttp::hostName(host), resolved) == 1 && resolved != IPAddress((uint32_t)0);
+        const uint32_t latencyMs = millis() - startMs;
+
+        st.lookups++;
+        st.lastLatencyMs = latencyMs;
+        if (latencyMs > st.maxLatencyMs)
+        {
+            st.maxLatencyMs = latencyMs;
+        }
+        if (!ok)
+        {
+            st.failures++;
+            Serial.printf("DnsCache: lookup for %s failed after %u ms\n", ApiHttp::hostName(host), latencyMs);
+            return false;
+        }
+
+        e.address = resolved;
+        e.resolvedMs = millis();
+        e.valid = true;
+        e.refreshPending = false;
+        return true;
+    }
+}
+
+void DnsCache::prewarm()
+{
+    for (size_t i = 0; i < kHostCount; ++i)
+    {
+        lookup((ApiHttp::Host)i);
+    }
+    logStats();
+}
+
+bool DnsCache::resolve(ApiHttp::Host host, IPAddress &outAddress)
+{
+    const size_t idx = (size_t)host;
+    Entry &e = s_entries[idx];
+    const unsigned long age = millis() - e.resolvedMs;
+
+    if (e.valid && age < kFreshMs)
+    {
+        s_stats[idx].hits++;
+        outAddress = e.address;
+        return true;
+    }
+    if (e.valid && age < kStaleMs)
+    {
+        s_stats[idx].staleHits++;
+        e.refreshPending = true;
+        outAddress = e.address;
+        return true;
+    }
+
+    e.valid = false;
+    if (!lookup(host))
+        return false;
+    outAddress = e.address;
+    return true;
+}
+
+void DnsCache::refreshStale()
+{
+    for (size_t i = 0; i < kHostCount; ++i)
+    {
+        if (s_entries[i].refreshPending)
+        {
+            // On failure the stale address keeps serving until kStaleMs runs out.
+            lookup((ApiHttp::Host)i);
+        }
+    }
+}
+
+void DnsCache::invalidate(ApiHttp::Host host)
+{
+    Entry &e = s_entries[(size_t)host];
+    e.valid = false;
+    e.refreshPending = false;
+}
+
+const DnsCache::HostStats &DnsCache::stats(ApiHttp::Host host)
+{
+    return s_stats[(size_t)host];
+}
+
+void DnsCache::logStats()
+{
+    for (size_t i = 0; i < kHostCount; ++i)
+    {
+        const Entry &e = s_entries[i];
+        const HostStats &st = s_stats[i];
+        Serial.printf("DnsCache: %s -> %s lookups=%u fail=%u hits=%u stale=%u last=%ums max=%ums\n",
+                      ApiHttp::hostName((ApiHttp::Host)i),
+                      e.valid ? e.address.toString().c_str() : "-",
+                      st.lookups,
+                      st.failures,
+                      st.hits,
+                      st.staleHits,
+                      st.lastLatencyMs,
+                      st.maxLatencyMs);
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <Arduino.h>
+#include "utils/ApiHttpClient.h"
+
+// Small per-host address cache in front of lwIP so each request does not pay for (or
+// fail on) a fresh lookup. Callers are expected to hold NetLock.
+namespace DnsCache
+{
+    // lwIP's hostByName does not expose record TTLs, so entries use a fixed freshness window.
+    static const unsigned long kFreshMs = 5UL * 60UL * 1000UL;
+    // Past kFreshMs an entry is served stale and re-resolved off the request path, for up to this long.
+    static const unsigned long kStaleMs = 60UL * 60UL * 1000UL;
+
+    struct HostStats
+    {
+        uint32_t lookups = 0;
+        uint32_t failures = 0;
+        uint32_t hits = 0;
+        uint32_t staleHits = 0;
+        uint32_t lastLatencyMs = 0;
+        uint32_t maxLatencyMs = 0;
+    };
+
+    // Resolves every API host once; call after WiFi connects.
+    void prewarm();
+    bool resolve(ApiHttp::Host host, IPAddress &outAddress);
+    // Re-resolves entries that were served stale; run between fetch passes.
+    void refreshStale();
+    // Drops an address that failed to connect so the next request resolves again.
+    void invalidate(ApiHttp::Host host);
+    const HostStats &stats(ApiHttp::Host host);
+    void logStats();
+}
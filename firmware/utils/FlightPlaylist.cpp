@@ -0,0 +1,165 @@
+/*
+Purpose: Relevance-ordered playlist for the flight card cycle.
+Responsibilities:
+- Score each flight from its predicted closest pass (or current distance), track
+  relative to the center, altitude and whether it just entered the snapshot.
+- Order the snapshot by score, skip low scorers on long lists, and scale each dwell;
+  watchlist matches come first and preempt the current flight when they appear.
+- Keep the current flight by identity (SnapshotDiff::keyOf) across snapshots and report
+  when it changes.
+*/
+#include "utils/FlightPlaylist.h"
+#include "utils/GeoUtils.h"
+#include <algorithm>
+
+namespace
+{
+    // Weights of the relevance terms; they sum to 1.
+    constexpr float kProximityWeight = 0.5f;
+    constexpr float kApproachWeight = 0.3f;
+    constexpr float kAltitudeWeight = 0.2f;
+    constexpr float kArrivalBonus = 0.25f;    // added on the first snapshot a flight is in
+    constexpr double kHighAltitudeM = 12000.0; // at or above this, the altitude term is 0
+
+    float clamp01(double v)
+    {
+        if (v < 0.0)
+            return 0.0f;
+        return v > 1.0 ? 1.0f : (float)v;
+    }
+}
+
+float FlightPlaylist::relevance(const FlightInfo &f, float radiusKm, bool justArrived)
+{
+    // An aircraft about to fly overhead counts as near already.
+    const double nearestKm = !isnan(f.cpa_distance_km) ? f.cpa_distance_km : f.distance_km;
+    float proximity = 0.5f;
+    if (!isnan(nearestKm) && radiusKm > 0)
+        proximity = 1.0f - clamp01(nearestKm / radiusKm);
+
+    // 1 heading straight for the center, 0 straight away from it.
+    float approach = 0.5f;
+    if (!isnan(f.track_deg) && !isnan(f.bearing_deg))
+    {
+        const double toCenterDeg = f.bearing_deg + 180.0;
+        approach = clamp01((cos(degreesToRadians(f.track_deg - toCenterDeg)) + 1.0) / 2.0);
+    }
+
+    float altitude = 0.5f;
+    if (!isnan(f.baro_altitude_m))
+        altitude = 1.0f - clamp01(f.baro_altitude_m / kHighAltitudeM);
+
+    float score = kProximityWeight * proximity + kApproachWeight * approach + kAltitudeWeight * altitude;
+    if (justArrived)
+        score += kArrivalBonus;
+    return clamp01(score);
+}
+
+void FlightPlaylist::update(const std::vector<FlightInfo> &flights, const SnapshotDiff &diff,
+                            float radiusKm, unsigned long baseDwellMs)
+{
+    m_entries.clear();
+    for (size_t i = 0; i < flights.size(); ++i)
+    {
+        const bool arrived = m_primed && (diff.changes(i) & SnapshotDiff::Added);
+        Entry e;
+        e.key = SnapshotDiff::keyOf(flights[i]);
+        e.flight = i;
+        e.score = relevance(flights[i], radiusKm, arrived);
+        e.watched = flights[i].watch != 0;
+        const float scale = e.watched ? kMaxDwell : kMinDwell + (kMaxDwell - kMinDwell) * e.score;
+        e.dwellMs = (unsigned long)(baseDwellMs * scale);
+        m_entries.push_back(e);
+    }
+    m_primed = true;
+
+    // Stable, so equally relevant flights keep the snapshot's order.
+    std::stable_sort(m_entries.begin(), m_entries.end(), [](const Entry &a, const Entry &b) {
+        if (a.watched != b.watched)
+            return a.watched;
+        return a.score > b.score;
+    });
+    if (m_entries.size() > kLongList)
+    {
+        // Drop the weak tail, but never the flight on screen.
+        size_t keep = kLongList;
+        for (size_t i = kLongList; i < m_entries.size(); ++i)
+        {
+            if (m_entries[i].watched || m_entries[i].score >= kSkipBelow || m_entries[i].key == m_currentKey)
+                m_entries[keep++] = m_entries[i];
+        }
+        m_entries.resize(keep);
+    }
+
+    // A flight that just matched the watchlist takes the screen from the current one.
+    std::vector<String> watchedKeys;
+    size_t alert = m_entries.size();
+    for (size_t i = 0; i < m_entries.size() && m_entries[i].watched; ++i)
+    {
+        const String &key = m_entries[i].key;
+        if (alert == m_entries.size() &&
+            std::find(m_watchedKeys.begin(), m_watchedKeys.end(), key) == m_watchedKeys.end())
+            alert = i;
+        watchedKeys.push_back(key);
+    }
+    m_watchedKeys.swap(watchedKeys);
+    if (alert < m_entries.size() && m_entries[alert].key != m_currentKey)
+    {
+        m_currentKey = m_entries[alert].key;
+        m_position = alert;
+        if (++m_step == 0)
+            m_step = 1;
+        return;
+    }
+
+    for (size_t i = 0; i < m_entries.size(); ++i)
+    {
+        if (m_currentKey.length() && m_entries[i].key == m_currentKey)
+        {
+            m_position = i; // same flight, new place: not a step
+            return;
+        }
+    }
+    // The current flight left (or there was none): start over from the top.
+    m_currentKey = m_entries.empty() ? String() : m_entries[0].key;
+    m_position = 0;
+    if (++m_step == 0)
+        m_step = 1;
+}
+
+size_t FlightPlaylist::flightAt(size_t offset) const
+{
+    return m_entries[(m_position + offset) % m_entries.size()].flight;
+}
+
+unsigned long FlightPlaylist::dwellMs(size_t count) const
+{
+    unsigned long longest = 0;
+    for (size_t i = 0; i < count && i < m_entries.size(); ++i)
+    {
+        longest = std::max(longest, m_entries[(m_position + i) % m_entries.size()].dwellMs);
+    }
+    return longest;
+}
+
+void FlightPlaylist::setPosition(size_t position)
+{
+    if (m_entries.empty() || position == m_position)
+        return;
+    m_position = position;
+    m_currentKey = m_entries[position].key;
+    if (++m_step == 0)
+        m_step = 1;
+}
+
+void FlightPlaylist::advance(size_t count)
+{
+    if (m_entries.empty())
+        return;
+    setPosition((m_position + count) % m_entries.size());
+}
+
+void FlightPlaylist::rewind()
+{
+    setPosition(0);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include "models/FlightInfo.h"
+#include "utils/SnapshotDiff.h"
+
+// Order in which the flight cards cycle: most relevant flight first, each with a dwell
+// scaled by its relevance (how close it is or will pass, approaching rather than
+// leaving, low altitude, just arrived). On a long list the least relevant flights are
+// skipped. The current flight is tracked by identity, so a new snapshot re-sorts the
+// playlist around it instead of moving the display to whatever flight now sits at the
+// same position. Watchlist matches (FlightInfo::watch) go before everything else, are
+// never skipped, dwell longest, and a newly matched flight takes the screen at once.
+class FlightPlaylist
+{
+public:
+    static const size_t kLongList = 6;        // above this many flights, low scorers are skipped
+    static constexpr float kSkipBelow = 0.3f; // relevance of a skipped flight
+    static constexpr float kMinDwell = 0.5f;  // dwell range, as a multiple of the base dwell
+    static constexpr float kMaxDwell = 1.5f;
+
+    // Relevance in [0, 1]; 0.5 is average. Unknown metrics count as average.
+    static float relevance(const FlightInfo &f, float radiusKm, bool justArrived);
+
+    // Rebuilds the order for a new snapshot; diff must just have been updated with it.
+    // Jumps to the first flight that matches the watchlist and did not before.
+    // Indices refer into flights, which must be the vector the display then draws from.
+    void update(const std::vector<FlightInfo> &flights, const SnapshotDiff &diff,
+                float radiusKm, unsigned long baseDwellMs);
+
+    size_t size() const { return m_entries.size(); }
+    size_t position() const { return m_position; }
+    // Index into the snapshot of the flight offset places after the current one.
+    size_t flightAt(size_t offset) const;
+    // Dwell of a step showing count flights from the current one: the longest of theirs.
+    unsigned long dwellMs(size_t count) const;
+
+    // Moves count flights on, wrapping around.
+    void advance(size_t count);
+    // Back to the most relevant flight, for when every flight fits on screen at once.
+    void rewind();
+
+    // Changes whenever the current flight does (advance, rewind, or it left the
+    // snapshot), so the display knows when to transition. Never 0.
+    uint32_t step() const { return m_step; }
+
+private:
+    struct Entry
+    {
+        String key;
+        size_t flight;
+        float score;
+        unsigned long dwellMs;
+        bool watched;
+    };
+
+    void setPosition(size_t position);
+
+    std::vector<Entry> m_entries;
+    std::vector<String> m_watchedKeys; // watchlist matches of the previous snapshot
+    String m_currentKey;
+    size_t m_position = 0;
+    uint32_t m_step = 1;
+    bool m_primed = false; // a snapshot was seen; before that, nothing counts as arrived
+};
@@ -30,6 +30,15 @@ inline double computeBearingDeg(double lat1, double lon1, double lat2, double lo
     return deg;
 }
 
+// East/north components of a polar vector on the flat plane around the center, in float:
+// range (km) and bearing give a position, ground speed and track a velocity.
+inline void polarToEastNorth(float magnitude, float bearingDeg, float &east, float &north)
+{
+    const float rad = bearingDeg * (float)(kPi / 180.0);
+    east = magnitude * sinf(rad);
+    north = magnitude * cosf(rad);
+}
+
 inline void centeredBoundingBox(double lat, double lon, double radiusKm,
                                 double &latMin, double &latMax,
                                 double &lonMin, double &lonMax)
@@ -0,0 +1,317 @@
+/*
+Purpose: Streaming gzip/zlib decoder between the HTTP socket and the JSON parsers.
+Responsibilities:
+- Parse the gzip member header (or let miniz parse the zlib header).
+- Inflate in small input chunks into a 32 KB wrapping window using the ROM miniz tinfl.
+- Expose the plain bytes through the Arduino Stream interface.
+- Check the gzip CRC32/ISIZE trailer at the end of the body (tinfl checks the zlib
+  Adler-32 itself). A mismatch sets failed(); by then most or all of the output has been
+  handed out, so callers read to the end and check failed() before using what they parsed.
+*/
+#include "utils/InflateStream.h"
+
+#if __has_include(<esp32/rom/miniz.h>)
+#include <esp32/rom/miniz.h>
+#else
+#include <rom/miniz.h>
+#endif
+
+static_assert(InflateStream::kWindowBytes == TINFL_LZ_DICT_SIZE, "window must match the tinfl dictionary size");
+
+namespace
+{
+    const uint8_t GZIP_FHCRC = 0x02;
+    const uint8_t GZIP_FEXTRA = 0x04;
+    const uint8_t GZIP_FNAME = 0x08;
+    const uint8_t GZIP_FCOMMENT = 0x10;
+
+    // Reflected CRC-32 (RFC 1952), four bits per step: a 64-byte table instead of 1 KB.
+    uint32_t crc32Update(uint32_t crc, const uint8_t *data, size_t length)
+    {
+        static const uint32_t kNibble[16] = {
+            0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+            0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C};
+        crc = ~crc;
+        for (size_t i = 0; i < length; ++i)
+        {
+            crc ^= data[i];
+            crc = (crc >> 4) ^ kNibble[crc & 15];
+            crc = (crc >> 4) ^ kNibble[crc & 15];
+        }
+        return ~crc;
+    }
+
+    uint32_t readLe32(const uint8_t *p)
+    {
+        return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+}
+
+size_t InflateStream::workingSetBytes()
+{
+    return kWindowBytes + sizeof(tinfl_decompressor);
+}
+
+InflateStream::~InflateStream()
+{
+    end();
+}
+
+bool InflateStream::begin(Stream &source, Format format)
+{
+    end();
+    m_source = &source;
+    m_inflator = static_cast<tinfl_decompressor *>(malloc(sizeof(tinfl_decompressor)));
+    m_window = static_cast<uint8_t *>(malloc(kWindowBytes));
+    if (m_inflator == nullptr || m_window == nullptr)
+    {
+        Serial.printf("InflateStream: cannot allocate %u bytes (max block %u)\n",
+                      (unsigned)workingSetBytes(),
+                      ESP.getMaxAllocHeap());
+        end();
+        m_failed = true;
+        return false;
+    }
+    tinfl_init(m_inflator);
+
+    m_format = format;
+    m_flags = TINFL_FLAG_HAS_MORE_INPUT;
+    if (format == Format::Zlib)
+    {
+        m_flags |= TINFL_FLAG_PARSE_ZLIB_HEADER;
+    }
+    else if (!skipGzipHeader())
+    {
+        Serial.println("InflateStream: invalid gzip header");
+        end();
+        m_failed = true;
+        return false;
+    }
+    return true;
+}
+
+void InflateStream::end()
+{
+    free(m_inflator);
+    free(m_window);
+    m_inflator = nullptr;
+    m_window = nullptr;
+    m_source = nullptr;
+    m_inputPos = m_inputLen = 0;
+    m_windowOffset = m_outRead = m_outEnd = 0;
+    m_crc = 0;
+    m_sourceDone = m_moreOutput = m_finished = m_failed = false;
+    m_compressedBytes = m_inflatedBytes = 0;
+}
+
+bool InflateStream::fillInput()
+{
+    if (m_inputPos < m_inputLen)
+        return true;
+    if (m_sourceDone || m_source == nullptr)
+        return false;
+    // readBytes blocks up to the source timeout; a short read of zero means the body ended.
+    m_inputLen = m_source->readBytes(reinterpret_cast<char *>(m_input), sizeof(m_input));
+    m_inputPos = 0;
+    m_compressedBytes += m_inputLen;
+    if (m_inputLen == 0)
+    {
+        m_sourceDone = true;
+        return false;
+    }
+    return true;
+}
+
+int InflateStream::readSourceByte()
+{
+    if (!fillInput())
+        return -1;
+    return m_input[m_inputPos++];
+}
+
+bool InflateStream::skipGzipHeader()
+{
+    uint8_t header[10];
+    for (size_t i = 0; i < sizeof(header); ++i)
+    {
+        int c = readSourceByte();
+        if (c < 0)
+            return false;
+        header[i] = (uint8_t)c;
+    }
+    if (header[0] != 0x1f || header[1] != 0x8b || header[2] != 8)
+        return false;
+
+    const uint8_t flags = header[3];
+    if (flags & GZIP_FEXTRA)
+    {
+        int lo = readSourceByte();
+        int hi = readSourceByte();
+        if (lo < 0 || hi < 0)
+            return false;
+        for (int n = lo | (hi << 8); n > 0; --n)
+        {
+            if (readSourceByte() < 0)
+                return false;
+        }
+    }
+    const uint8_t zeroTerminated[] = {GZIP_FNAME, GZIP_FCOMMENT};
+    for (uint8_t field : zeroTerminated)
+    {
+        if (!(flags & field))
+            continue;
+        int c;
+        do
+        {
+            c = readSourceByte();
+        } while (c > 0);
+        if (c < 0)
+            return false;
+    }
+    if (flags & GZIP_FHCRC)
+    {
+        if (readSourceByte() < 0 || readSourceByte() < 0)
+            return false;
+    }
+    return true;
+}
+
+bool InflateStream::verifyGzipTrailer()
+{
+    // CRC32 then ISIZE (length mod 2^32), little-endian. Older tinfl builds, like the ROM's,
+    // can leave the first trailer bytes in their bit buffer past any padding bits.
+    uint8_t trailer[8];
+    size_t have = 0;
+    uint32_t bits = m_inflator->m_num_bits;
+    uint32_t bitBuffer = (uint32_t)(m_inflator->m_bit_buf >> (bits & 7));
+    bits &= ~7u;
+    for (; bits >= 8 && have < sizeof(trailer); bits -= 8, bitBuffer >>= 8)
+        trailer[have++] = (uint8_t)bitBuffer;
+    for (; have < sizeof(trailer); ++have)
+    {
+        int c = readSourceByte();
+        if (c < 0)
+        {
+            Serial.println("InflateStream: gzip trailer missing");
+            return false;
+        }
+        trailer[have] = (uint8_t)c;
+    }
+
+    const uint32_t crc = readLe32(trailer);
+    const uint32_t size = readLe32(trailer + 4);
+    if (crc != m_crc || size != (uint32_t)m_inflatedBytes)
+    {
+        Serial.printf("InflateStream: gzip trailer mismatch (crc %08x/%08x, size %u/%u)\n",
+                      (unsigned)crc,
+                      (unsigned)m_crc,
+                      (unsigned)size,
+                      (unsigned)m_inflatedBytes);
+        return false;
+    }
+    return true;
+}
+
+bool InflateStream::refill()
+{
+    if (m_outRead < m_outEnd)
+        return true;
+    if (m_finished || m_failed || m_inflator == nullptr)
+        return false;
+
+    while (true)
+    {
+        if (!fillInput())
+        {
+            m_flags &= ~TINFL_FLAG_HAS_MORE_INPUT;
+        }
+
+        size_t inBytes = m_inputLen - m_inputPos;
+        size_t outBytes = kWindowBytes - m_windowOffset;
+        tinfl_status status = tinfl_decompress(m_inflator,
+                                               m_input + m_inputPos,
+                                               &inBytes,
+                                               m_window,
+                                               m_window + m_windowOffset,
+                                               &outBytes,
+                                               m_flags);
+        m_inputPos += inBytes;
+
+        m_outRead = m_windowOffset;
+        m_outEnd = m_windowOffset + outBytes;
+        m_windowOffset = (m_windowOffset + outBytes) & (kWindowBytes - 1);
+        m_inflatedBytes += outBytes;
+        if (m_format == Format::Gzip)
+            m_crc = crc32Update(m_crc, m_window + m_outRead, outBytes);
+        m_moreOutput = status == TINFL_STATUS_HAS_MORE_OUTPUT;
+
+        if (status < TINFL_STATUS_DONE)
+        {
+            Serial.printf("InflateStream: inflate failed (%d) after %u compressed bytes\n",
+                          (int)status,
+                          (unsigned)m_compressedBytes);
+            m_failed = true;
+            return outBytes > 0;
+        }
+        if (status == TINFL_STATUS_DONE)
+        {
+            m_finished = true;
+            if (m_format == Format::Gzip && !verifyGzipTrailer())
+            {
+                m_failed = true;
+                m_outRead = m_outEnd;
+                return false;
+            }
+            return outBytes > 0;
+        }
+        if (outBytes > 0)
+        {
+            return true;
+        }
+        if (status == TINFL_STATUS_NEEDS_MORE_INPUT && m_sourceDone)
+        {
+            Serial.println("InflateStream: compressed body truncated");
+            m_failed = true;
+            return false;
+        }
+    }
+}
+
+int InflateStream::available()
+{
+    if (m_outRead < m_outEnd)
+        return (int)(m_outEnd - m_outRead);
+    if (m_finished || m_failed)
+        return 0;
+    // Output tinfl still holds counts even once the input is used up and the socket closed.
+    return (m_moreOutput || m_inputPos < m_inputLen || (m_source && m_source->available() > 0)) ? 1 : 0;
+}
+
+int InflateStream::read()
+{
+    if (!refill())
+        return -1;
+    return m_window[m_outRead++];
+}
+
+int InflateStream::peek()
+{
+    if (!refill())
+        return -1;
+    return m_window[m_outRead];
+}
+
+size_t InflateStream::readBytes(char *buffer, size_t length)
+{
+    size_t copied = 0;
+    while (copied < length && refill())
+    {
+        size_t chunk = m_outEnd - m_outRead;
+        if (chunk > length - copied)
+            chunk = length - copied;
+        memcpy(buffer + copied, m_window + m_outRead, chunk);
+        m_outRead += chunk;
+        copied += chunk;
+    }
+    return copied;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Compressed responses are opt-in (-DFW_HTTP_GZIP=1): the inflater needs ~43 KB of heap
+// next to an open TLS session, which only fits on boards with headroom.
+#ifndef FW_HTTP_GZIP
+#define FW_HTTP_GZIP 0
+#endif
+
+struct tinfl_decompressor_tag;
+
+// Decodes a gzip (RFC 1952) or zlib (RFC 1950) body on the fly so JSON parsers can read
+// the plain text directly from the socket. Uses the miniz inflater from the ESP32 ROM.
+class InflateStream : public Stream
+{
+public:
+    enum class Format : uint8_t
+    {
+        Gzip,
+        Zlib
+    };
+
+    // Deflate back-references reach up to 32 KB, so the history window cannot be smaller
+    // than that for arbitrary servers; it doubles as the output buffer.
+    static const size_t kWindowBytes = 32768;
+    static const size_t kInputBytes = 512;
+    static size_t workingSetBytes();
+
+    InflateStream() = default;
+    ~InflateStream() override;
+
+    // Allocates the window and parses the gzip header. Returns false on a bad header or OOM.
+    bool begin(Stream &source, Format format);
+    void end();
+
+    // Set by a bad header, corrupt data, a truncated body or a trailer mismatch. The trailer is
+    // only checked once the body has been read to its end.
+    bool failed() const { return m_failed; }
+    size_t compressedBytes() const { return m_compressedBytes; }
+    size_t inflatedBytes() const { return m_inflatedBytes; }
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t readBytes(char *buffer, size_t length) override;
+    size_t write(uint8_t) override { return 0; }
+
+private:
+    bool fillInput();
+    int readSourceByte();
+    bool skipGzipHeader();
+    bool refill();
+    bool verifyGzipTrailer();
+
+    Stream *m_source = nullptr;
+    tinfl_decompressor_tag *m_inflator = nullptr;
+    uint8_t *m_window = nullptr;
+    uint8_t m_input[kInputBytes];
+    size_t m_inputPos = 0;
+    size_t m_inputLen = 0;
+    size_t m_windowOffset = 0;
+    size_t m_outRead = 0;
+    size_t m_outEnd = 0;
+    uint32_t m_flags = 0;
+    Format m_format = Format::Gzip;
+    uint32_t m_crc = 0; // CRC-32 of the output so far, checked against the gzip trailer
+    bool m_sourceDone = false;
+    bool m_moreOutput = false; // tinfl stopped at the window edge with output still pending
+    bool m_finished = false;
+    bool m_failed = false;
+    size_t m_compressedBytes = 0;
+    size_t m_inflatedBytes = 0;
+};
@@ -0,0 +1,228 @@
+/*
+Purpose: Compact table of the nearest aircraft (callsign, type, altitude, distance).
+Responsibilities:
+- Pick the airborne aircraft nearest the center, as many as fit the viewport.
+- Format each row in short units and keep its rendered strips between fetches.
+- Mark only the rows whose text (or column position) changed as dirty, and draw single
+  rows so the caller can repaint just those.
+*/
+#include "utils/ListView.h"
+#include "config/UserConfiguration.h"
+#include <algorithm>
+
+namespace
+{
+    constexpr TextStrip::Font kFont = TextStrip::Font::Compact;
+
+    // One decimal below 10, whole numbers above: "4.3", "27".
+    String shortNumber(double value)
+    {
+        char buf[12];
+        if (value < 9.95)
+            snprintf(buf, sizeof(buf), "%.1f", value);
+        else
+            snprintf(buf, sizeof(buf), "%ld", lround(value));
+        return String(buf);
+    }
+
+    String formatAltitude(double meters, bool feet)
+    {
+        if (isnan(meters))
+            return String("--");
+        if (meters < 0)
+            meters = 0;
+        if (feet)
+        {
+            // Flight level: hundreds of feet, three digits.
+            char buf[8];
+            snprintf(buf, sizeof(buf), "%03ld", lround(meters * 3.28084 / 100.0));
+            return String(buf);
+        }
+        return shortNumber(meters / 1000.0);
+    }
+}
+
+void ListView::setViewport(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    m_x = x;
+    m_y = y;
+    m_w = w;
+    m_h = h;
+    for (uint8_t i = 0; i < kMaxRows; ++i)
+    {
+        m_rows[i].dirty = true;
+    }
+}
+
+uint8_t ListView::rows() const
+{
+    const int16_t fit = m_h / kRowHeight;
+    if (fit <= 0)
+        return 0;
+    return fit < kMaxRows ? (uint8_t)fit : kMaxRows;
+}
+
+String ListView::typeFor(const String &callsign, const std::vector<FlightInfo> &flights)
+{
+    if (callsign.length() == 0)
+        return String();
+    for (const auto &f : flights)
+    {
+        if (f.ident_icao == callsign || f.ident == callsign)
+            return f.aircraft_code;
+    }
+    return String();
+}
+
+void ListView::update(const std::vector<StateVector> &states, const std::vector<FlightInfo> &flights,
+                      bool altitudeFeet, bool distanceNm)
+{
+    std::vector<const StateVector *> nearest;
+    nearest.reserve(states.size());
+    for (const auto &s : states)
+    {
+        if (s.on_ground || isnan(s.distance_km))
+            continue;
+        nearest.push_back(&s);
+    }
+    std::sort(nearest.begin(), nearest.end(), [](const StateVector *a, const StateVector *b) {
+        return a->distance_km < b->distance_km;
+    });
+    if (nearest.size() > rows())
+        nearest.resize(rows());
+
+    int16_t widths[kColumns] = {0};
+    for (uint8_t i = 0; i < kMaxRows; ++i)
+    {
+        Row &row = m_rows[i];
+        const bool used = i < nearest.size();
+        if (used != row.used)
+            row.dirty = true;
+        row.used = used;
+        if (!used)
+        {
+            row.watched = false;
+            for (uint8_t c = 0; c < kColumns; ++c)
+            {
+                if (row.text[c].length())
+                {
+                    row.text[c] = String();
+                    row.strips[c].clear();
+                }
+            }
+            continue;
+        }
+
+        const StateVector &s = *nearest[i];
+        String text[kColumns];
+        text[Callsign] = s.callsign;
+        text[Callsign].trim();
+        text[Type] = typeFor(text[Callsign], flights);
+        if (text[Callsign].length() == 0)
+        {
+            text[Callsign] = s.icao24;
+            text[Callsign].toUpperCase();
+        }
+        text[Altitude] = formatAltitude(s.baro_altitude, altitudeFeet);
+        text[Distance] = shortNumber(distanceNm ? s.distance_km / 1.852 : s.distance_km);
+        const bool watched = s.watch != 0;
+        if (watched != row.watched)
+        {
+            row.watched = watched;
+            row.dirty = true;
+        }
+
+        for (uint8_t c = 0; c < kColumns; ++c)
+        {
+            if (text[c] != row.text[c])
+            {
+                row.text[c] = text[c];
+                row.strips[c].render(text[c], kFont);
+                row.dirty = true;
+            }
+            if (row.strips[c].width() > widths[c])
+                widths[c] = row.strips[c].width();
+        }
+    }
+    m_count = (uint8_t)nearest.size();
+    layoutColumns(widths);
+}
+
+void ListView::layoutColumns(int16_t widths[kColumns])
+{
+    // Numbers are right-aligned at the pane's right edge; the callsign takes what is left
+    // and is clipped when a long one does not fit.
+    int16_t x0[kColumns];
+    int16_t x1[kColumns];
+    int16_t edge = m_x + m_w;
+    for (int8_t c = Distance; c > Callsign; --c)
+    {
+        x1[c] = edge;
+        x0[c] = edge - widths[c];
+        if (widths[c] > 0)
+            edge = x0[c] - kColumnGap;
+    }
+    x0[Callsign] = m_x;
+    x1[Callsign] = std::max(edge, m_x);
+
+    bool moved = false;
+    for (uint8_t c = 0; c < kColumns; ++c)
+    {
+        moved |= x0[c] != m_colX0[c] || x1[c] != m_colX1[c];
+        m_colX0[c] = x0[c];
+        m_colX1[c] = x1[c];
+    }
+    if (!moved)
+        return;
+    for (uint8_t i = 0; i < kMaxRows; ++i)
+    {
+        if (m_rows[i].used)
+            m_rows[i].dirty = true;
+    }
+}
+
+bool ListView::dirty() const
+{
+    for (uint8_t i = 0; i < kMaxRows; ++i)
+    {
+        if (m_rows[i].dirty)
+            return true;
+    }
+    return false;
+}
+
+void ListView::markClean()
+{
+    for (uint8_t i = 0; i < kMaxRows; ++i)
+    {
+        m_rows[i].dirty = false;
+    }
+}
+
+void ListView::draw(RenderSurface &surface, uint8_t row) const
+{
+    if (row >= kMaxRows || !m_rows[row].used)
+        return;
+    const RenderSurface::Color colors[kColumns] = {
+        RenderSurface::rgb(UserConfiguration::TEXT_COLOR_R,
+                           UserConfiguration::TEXT_COLOR_G,
+                           UserConfiguration::TEXT_COLOR_B),
+        RenderSurface::rgb(UserConfiguration::TEXT_COLOR_R / 3,
+                           UserConfiguration::TEXT_COLOR_G / 3,
+                           UserConfiguration::TEXT_COLOR_B / 3),
+        RenderSurface::rgb(80, 200, 200), // soft teal, as the card's origin
+        RenderSurface::rgb(255, 200, 80), // soft amber, as the card's destination
+    };
+    const RenderSurface::Color watchedColor = RenderSurface::rgb(255, 60, 60); // as the radar's
+    const Row &r = m_rows[row];
+    const int16_t y = rowY(row);
+    for (uint8_t c = 0; c < kColumns; ++c)
+    {
+        const TextStrip &strip = r.strips[c];
+        if (strip.width() == 0)
+            continue;
+        // Text columns are left-aligned, numbers right-aligned.
+        const int16_t x = c <= Type ? m_colX0[c] : m_colX1[c] - strip.width();
+        strip.blit(surface, x, y, m_colX0[c], m_colX1[c], c == Callsign && r.watched ? watchedColor : colors[c]);
+    }
+}
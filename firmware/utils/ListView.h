@@ -0,0 +1,77 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include "models/FlightInfo.h"
+#include "models/StateVector.h"
+#include "utils/RenderSurface.h"
+#include "utils/TextStrip.h"
+
+// Table of the nearest aircraft, one row each: callsign, type, altitude and distance,
+// nearest first. Rows are formatted and rendered into strips when a fetch arrives and
+// compared with what the row showed before, so the display repaints only the rows whose
+// text changed instead of the whole pane. Watchlist matches show their callsign in red.
+class ListView
+{
+public:
+    static const uint8_t kMaxRows = 16;
+    static const int16_t kRowHeight = TextStrip::kHeight;
+    static const int16_t kColumnGap = 2;
+
+    // Pane the list is drawn into (panel coordinates). Marks every row dirty.
+    void setViewport(int16_t x, int16_t y, int16_t w, int16_t h);
+    int16_t viewX() const { return m_x; }
+    int16_t viewY() const { return m_y; }
+    int16_t viewWidth() const { return m_w; }
+    int16_t viewHeight() const { return m_h; }
+
+    // Takes the state vectors of a new fetch. The type comes from the enriched flight
+    // with the same callsign (blank if there is none). Altitude is in hundreds of feet
+    // (flight level) or km, distance in nm or km.
+    void update(const std::vector<StateVector> &states, const std::vector<FlightInfo> &flights,
+                bool altitudeFeet, bool distanceNm);
+
+    uint8_t count() const { return m_count; }
+    // Rows that fit the viewport (at most kMaxRows).
+    uint8_t rows() const;
+    int16_t rowY(uint8_t row) const { return m_y + row * kRowHeight; }
+
+    bool dirty() const;
+    bool rowDirty(uint8_t row) const { return row < kMaxRows && m_rows[row].dirty; }
+    void markClean();
+
+    // Draws one row into [rowY(row), rowY(row) + kRowHeight); the caller clears it (or
+    // composes in a band) first. Rows past count() draw nothing.
+    void draw(RenderSurface &surface, uint8_t row) const;
+
+private:
+    enum Column : uint8_t
+    {
+        Callsign,
+        Type,
+        Altitude,
+        Distance,
+        kColumns,
+    };
+
+    struct Row
+    {
+        bool used = false;
+        bool dirty = true;
+        bool watched = false;
+        String text[kColumns];
+        TextStrip strips[kColumns];
+    };
+
+    static String typeFor(const String &callsign, const std::vector<FlightInfo> &flights);
+    void layoutColumns(int16_t widths[kColumns]);
+
+    Row m_rows[kMaxRows];
+    uint8_t m_count = 0;
+    int16_t m_colX0[kColumns] = {0};  // column clip, [m_colX0, m_colX1)
+    int16_t m_colX1[kColumns] = {0};
+    int16_t m_x = 0;
+    int16_t m_y = 0;
+    int16_t m_w = 0;
+    int16_t m_h = 0;
+};
@@ -0,0 +1,62 @@
+/*
+Purpose: Extrapolate aircraft position and altitude between fetches.
+Responsibilities:
+- Take position, track, ground speed, vertical rate and fix time from a state vector.
+- Advance them to any render time with a confidence that decays with the fix's age,
+  integrating the decay so motion slows smoothly to a stop at the horizon.
+- Clamp the extrapolated altitude.
+*/
+#include "utils/MotionModel.h"
+#include "utils/GeoUtils.h"
+
+void MotionModel::reset(const StateVector &s, unsigned long nowMs)
+{
+    polarToEastNorth((float)s.distance_km, (float)s.bearing_deg, m_eastKm, m_northKm);
+    m_eastKmps = 0;
+    m_northKmps = 0;
+    if (!isnan(s.velocity) && !isnan(s.heading) && !s.on_ground)
+        polarToEastNorth((float)s.velocity / 1000.0f, (float)s.heading, m_eastKmps, m_northKmps);
+    m_altitudeM = (float)s.baro_altitude;
+    m_climbMps = isnan(s.vertical_rate) ? 0.0f : (float)s.vertical_rate;
+    m_fixMs = s.position_ms != 0 ? s.position_ms : nowMs;
+}
+
+float MotionModel::effectiveSeconds(unsigned long fixMs, unsigned long nowMs)
+{
+    // A fix stamped after nowMs (clock skew) is treated as current.
+    if ((long)(nowMs - fixMs) <= 0)
+        return 0.0f;
+    const float horizon = kHorizonMs / 1000.0f;
+    float age = (nowMs - fixMs) / 1000.0f;
+    if (age > horizon)
+        age = horizon;
+    // Integral of the confidence 1 - t / horizon from the fix to now.
+    return age - age * age / (2.0f * horizon);
+}
+
+float MotionModel::confidenceAt(unsigned long nowMs) const
+{
+    if ((long)(nowMs - m_fixMs) <= 0)
+        return 1.0f;
+    const unsigned long age = nowMs - m_fixMs;
+    return age >= kHorizonMs ? 0.0f : 1.0f - (float)age / kHorizonMs;
+}
+
+void MotionModel::positionAt(unsigned long nowMs, float &eastKm, float &northKm) const
+{
+    const float t = effectiveSeconds(m_fixMs, nowMs);
+    eastKm = m_eastKm + m_eastKmps * t;
+    northKm = m_northKm + m_northKmps * t;
+}
+
+float MotionModel::altitudeAt(float altitudeM, float verticalRateMps, unsigned long fixMs, unsigned long nowMs)
+{
+    if (isnan(altitudeM))
+        return altitudeM;
+    if (isnan(verticalRateMps))
+        return altitudeM;
+    const float altitude = altitudeM + verticalRateMps * effectiveSeconds(fixMs, nowMs);
+    if (altitude < 0.0f)
+        return 0.0f;
+    return altitude > kMaxAltitudeM ? kMaxAltitudeM : altitude;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Arduino.h>
+#include "models/StateVector.h"
+
+// Dead reckoning of one aircraft between fetches: from its last fix it keeps its track
+// and ground speed and climbs at its vertical rate. Trust in the extrapolation decays
+// linearly with the age of the fix and reaches zero at kHorizonMs, so an aircraft whose
+// fixes stop arriving eases to a halt instead of flying on; altitude is clamped to
+// [0, kMaxAltitudeM].
+class MotionModel
+{
+public:
+    static const unsigned long kHorizonMs = 60000; // two fetch intervals
+    static constexpr float kMaxAltitudeM = 15000.0f;
+
+    // From a state vector (position from distance_km/bearing_deg, relative to the
+    // center). The fix time is s.position_ms, or nowMs when that is unknown.
+    void reset(const StateVector &s, unsigned long nowMs);
+
+    // 1 at the fix, 0 from kHorizonMs on.
+    float confidenceAt(unsigned long nowMs) const;
+    // Km east/north of the center.
+    void positionAt(unsigned long nowMs, float &eastKm, float &northKm) const;
+    float altitudeAt(unsigned long nowMs) const { return altitudeAt(m_altitudeM, m_climbMps, m_fixMs, nowMs); }
+
+    // Altitude alone, for callers that only keep a fix's altitude, vertical rate and time.
+    // NAN stays NAN; an unknown rate holds the altitude.
+    static float altitudeAt(float altitudeM, float verticalRateMps, unsigned long fixMs, unsigned long nowMs);
+
+private:
+    // Seconds of motion at nowMs: the fix's age weighted by the decaying confidence.
+    static float effectiveSeconds(unsigned long fixMs, unsigned long nowMs);
+
+    float m_eastKm = 0;
+    float m_northKm = 0;
+    float m_eastKmps = 0; // velocity, km/s
+    float m_northKmps = 0;
+    float m_altitudeM = NAN;
+    float m_climbMps = 0;
+    unsigned long m_fixMs = 0;
+};
@@ -0,0 +1,224 @@
+/*
+Purpose: Overlap network reads with JSON parsing across the two ESP32 cores.
+Responsibilities:
+- Run a reader task on the core the caller is not on, draining the source into an SPSC ring.
+- Serve the caller's parser from the ring through the Stream interface.
+- Flow control on ring fill: the reader parks when less than one chunk is free and the
+  parser wakes it once the ring drains below half.
+- End the body when the connection closes and drains; end() deletes the reader task
+  before freeing anything it uses, even if a read is still stuck.
+- Record total time, parser starvation, reader stalls and peak ring fill per body.
+*/
+#include "utils/PipelinedStream.h"
+
+PipelinedStream::~PipelinedStream()
+{
+    end();
+}
+
+bool PipelinedStream::begin(Stream &source, uint32_t timeoutMs, Client *connection)
+{
+    end();
+    m_storage = static_cast<uint8_t *>(malloc(kRingBytes));
+    m_readerExited = xSemaphoreCreateBinary();
+    if (m_storage == nullptr || m_readerExited == nullptr)
+    {
+        end();
+        return false;
+    }
+
+    m_source = &source;
+    m_connection = connection;
+    m_ring.reset(m_storage, kRingBytes);
+    m_timeoutMs = timeoutMs;
+    setTimeout(timeoutMs);
+    m_stop.store(false);
+    m_sourceDone.store(false);
+    m_readerWaiting.store(false);
+    m_peakFill.store(0);
+    m_readerStallMs.store(0);
+    m_stats = Stats();
+    m_startMs = millis();
+    m_consumerTask = xTaskGetCurrentTaskHandle();
+
+    const BaseType_t readerCore = (xPortGetCoreID() == PRO_CPU_NUM) ? APP_CPU_NUM : PRO_CPU_NUM;
+    if (xTaskCreatePinnedToCore(readerEntry, "netReader", kReaderStackBytes, this, 1, &m_readerTask, readerCore) != pdPASS)
+    {
+        Serial.println("PipelinedStream: reader task creation failed; parsing inline");
+        m_readerTask = nullptr;
+        end();
+        return false;
+    }
+    return true;
+}
+
+void PipelinedStream::end()
+{
+    if (m_readerTask)
+    {
+        m_stop.store(true);
+        // The reader only blocks in short slices, so it notices the stop flag quickly and
+        // then parks. A read stuck past the timeout is cut short by deleting the task; the
+        // extra tick lets the other core switch away from it before its ring is freed.
+        if (xSemaphoreTake(m_readerExited, pdMS_TO_TICKS(m_timeoutMs + 1000)) == pdTRUE)
+        {
+            vTaskDelete(m_readerTask);
+        }
+        else
+        {
+            Serial.println("PipelinedStream: reader did not exit in time; deleting it");
+            vTaskDelete(m_readerTask);
+            vTaskDelay(1);
+        }
+        m_readerTask = nullptr;
+
+        m_stats.totalMs = millis() - m_startMs;
+        m_stats.peakFill = m_peakFill.load();
+        m_stats.readerStallMs = m_readerStallMs.load();
+        Serial.printf("PipelinedStream: %u bytes in %u ms, peak fill %u/%u, parser waited %u ms, reader stalled %u ms\n",
+                      (unsigned)m_stats.bytes,
+                      m_stats.totalMs,
+                      (unsigned)m_stats.peakFill,
+                      (unsigned)kRingBytes,
+                      m_stats.consumerWaitMs,
+                      m_stats.readerStallMs);
+    }
+    if (m_readerExited)
+    {
+        vSemaphoreDelete(m_readerExited);
+        m_readerExited = nullptr;
+    }
+    free(m_storage);
+    m_storage = nullptr;
+    m_source = nullptr;
+    m_connection = nullptr;
+    m_consumerTask = nullptr;
+}
+
+void PipelinedStream::readerEntry(void *arg)
+{
+    static_cast<PipelinedStream *>(arg)->runReader();
+    // end() owns the deletion, so the task never outlives the state it reads.
+    for (;;)
+    {
+        vTaskSuspend(nullptr);
+    }
+}
+
+void PipelinedStream::runReader()
+{
+    uint8_t chunk[kReaderChunkBytes];
+    unsigned long lastDataMs = millis();
+    while (!m_stop.load())
+    {
+        if (m_ring.space() < kReaderChunkBytes)
+        {
+            m_readerWaiting.store(true);
+            const unsigned long stallStart = millis();
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(20));
+            m_readerWaiting.store(false);
+            m_readerStallMs.fetch_add(millis() - stallStart);
+            lastDataMs = millis(); // waiting on the parser is not a network timeout
+            continue;
+        }
+
+        int avail = m_source->available();
+        if (avail <= 0)
+        {
+            // Closed and drained: the body is complete (or cut short); nothing more will come.
+            if (m_connection && !m_connection->connected() && m_connection->available() == 0)
+                break;
+            if (millis() - lastDataMs >= m_timeoutMs)
+                break;
+            vTaskDelay(1);
+            continue;
+        }
+
+        size_t want = (size_t)avail < sizeof(chunk) ? (size_t)avail : sizeof(chunk);
+        size_t got = m_source->readBytes(reinterpret_cast<char *>(chunk), want);
+        if (got == 0)
+            break;
+        m_ring.write(chunk, got); // space for a full chunk was checked above
+        m_stats.bytes += got;
+        lastDataMs = millis();
+
+        const size_t fill = m_ring.size();
+        if (fill > m_peakFill.load())
+        {
+            m_peakFill.store(fill);
+        }
+        xTaskNotifyGive(m_consumerTask);
+    }
+    m_sourceDone.store(true);
+    xTaskNotifyGive(m_consumerTask);
+    xSemaphoreGive(m_readerExited);
+}
+
+bool PipelinedStream::waitForData()
+{
+    if (m_ring.size() > 0)
+        return true;
+    if (m_readerTask == nullptr)
+        return false;
+
+    const unsigned long waitStart = millis();
+    while (m_ring.size() == 0)
+    {
+        if (m_sourceDone.load())
+        {
+            // The reader publishes data before the done flag, so re-check once.
+            if (m_ring.size() > 0)
+                break;
+            return false;
+        }
+        if (millis() - waitStart >= m_timeoutMs)
+            return false;
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(10));
+    }
+    m_stats.consumerWaitMs += millis() - waitStart;
+    return true;
+}
+
+void PipelinedStream::wakeReaderIfDrained()
+{
+    if (m_readerWaiting.load() && m_ring.size() <= kRingBytes / 2)
+    {
+        xTaskNotifyGive(m_readerTask);
+    }
+}
+
+int PipelinedStream::available()
+{
+    size_t buffered = m_ring.size();
+    if (buffered > 0)
+        return (int)buffered;
+    return m_sourceDone.load() ? 0 : 1;
+}
+
+int PipelinedStream::read()
+{
+    if (!waitForData())
+        return -1;
+    uint8_t c = 0;
+    m_ring.read(&c, 1);
+    wakeReaderIfDrained();
+    return c;
+}
+
+int PipelinedStream::peek()
+{
+    if (!waitForData())
+        return -1;
+    return m_ring.peek();
+}
+
+size_t PipelinedStream::readBytes(char *buffer, size_t length)
+{
+    size_t copied = 0;
+    while (copied < length && waitForData())
+    {
+        copied += m_ring.read(reinterpret_cast<uint8_t *>(buffer) + copied, length - copied);
+        wakeReaderIfDrained();
+    }
+    return copied;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Client.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include "utils/SpscRing.h"
+
+// Splits "read the socket" from "parse the JSON": a reader task on the other core drains
+// the (TLS-decrypted) source into an SPSC ring while the caller's task parses from this
+// Stream. The reader pauses when the ring is nearly full and resumes at half capacity.
+class PipelinedStream : public Stream
+{
+public:
+    static const size_t kRingBytes = 2048;
+    static const size_t kReaderChunkBytes = 256;
+    static const uint32_t kReaderStackBytes = 6144; // mbedTLS record decryption runs on this stack
+
+    struct Stats
+    {
+        uint32_t totalMs = 0;
+        uint32_t consumerWaitMs = 0; // parser starved: ring empty
+        uint32_t readerStallMs = 0;  // flow control: ring full
+        size_t peakFill = 0;
+        size_t bytes = 0;
+    };
+
+    PipelinedStream() = default;
+    ~PipelinedStream() override;
+
+    // Starts the reader task; on failure the caller should parse from source directly.
+    // connection is the socket under source (source itself for plain bodies); once it is
+    // closed and drained the reader stops instead of polling out the timeout.
+    bool begin(Stream &source, uint32_t timeoutMs, Client *connection = nullptr);
+    // Stops the reader and deletes its task, waiting up to the timeout for it to finish
+    // its current read first. Must run before the source is closed.
+    void end();
+    const Stats &stats() const { return m_stats; }
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t readBytes(char *buffer, size_t length) override;
+    size_t write(uint8_t) override { return 0; }
+
+private:
+    static void readerEntry(void *arg);
+    void runReader();
+    bool waitForData();
+    void wakeReaderIfDrained();
+
+    Stream *m_source = nullptr;
+    Client *m_connection = nullptr;
+    uint8_t *m_storage = nullptr;
+    SpscRing m_ring;
+    uint32_t m_timeoutMs = 15000;
+    unsigned long m_startMs = 0;
+    TaskHandle_t m_readerTask = nullptr;
+    TaskHandle_t m_consumerTask = nullptr;
+    SemaphoreHandle_t m_readerExited = nullptr;
+    std::atomic<bool> m_stop{false};
+    std::atomic<bool> m_sourceDone{false};
+    std::atomic<bool> m_readerWaiting{false};
+    std::atomic<size_t> m_peakFill{0};
+    std::atomic<uint32_t> m_readerStallMs{0};
+    Stats m_stats;
+};
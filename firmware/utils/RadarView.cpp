@@ -0,0 +1,253 @@
+/*
+Purpose: Radar (plan-view) rendering of the aircraft in range.
+Responsibilities:
+- Keep up to kMaxContacts nearest aircraft, matched across fetches by icao24.
+- Dead-reckon each contact from its latest fix, blending out the jump to a new fix over
+  the glide window; project the previous fixes of its TrackStore track into its trail.
+- Draw range rings, fading trails, contact dots and heading ticks as 1 px spans, clipped
+  to the viewport, and report when a redraw would actually change a pixel.
+*/
+#include "utils/RadarView.h"
+#include "utils/GeoUtils.h"
+#include <string.h>
+#include <algorithm>
+
+void RadarView::setViewport(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    m_x = x;
+    m_y = y;
+    m_w = w;
+    m_h = h;
+    m_dirty = true;
+}
+
+RadarView::Contact *RadarView::find(const char *icao24)
+{
+    for (uint8_t i = 0; i < kMaxContacts; ++i)
+    {
+        if (m_contacts[i].used && strcmp(m_contacts[i].icao24, icao24) == 0)
+            return &m_contacts[i];
+    }
+    return nullptr;
+}
+
+void RadarView::positionAt(const Contact &c, unsigned long nowMs, float &e, float &n) const
+{
+    c.motion.positionAt(nowMs, e, n);
+    float t = (float)(nowMs - c.glideStartMs) / (float)m_glideMs;
+    if (t > 1.0f)
+        t = 1.0f;
+    e += c.offsetE * (1.0f - t);
+    n += c.offsetN * (1.0f - t);
+}
+
+void RadarView::loadTrail(Contact &c, const TrackStore::Track *track, double centerLat, double centerLon)
+{
+    c.trailCount = 0;
+    if (track == nullptr || track->size() < 2)
+        return;
+    // Every kept fix but the latest, which the contact itself is drawn from.
+    const uint8_t fixes = track->size() - 1;
+    const uint8_t first = fixes > kTrailPoints ? fixes - kTrailPoints : 0;
+    for (uint8_t i = first; i < fixes; ++i)
+    {
+        const TrackStore::Sample &s = track->at(i);
+        polarToEastNorth((float)haversineKm(centerLat, centerLon, s.lat, s.lon),
+                         (float)computeBearingDeg(centerLat, centerLon, s.lat, s.lon),
+                         c.trailE[c.trailCount], c.trailN[c.trailCount]);
+        c.trailCount++;
+    }
+}
+
+void RadarView::toPixel(float e, float n, int16_t &px, int16_t &py) const
+{
+    const int16_t radiusPx = (std::min(m_w, m_h) - 1) / 2;
+    const float scale = radiusPx / m_radiusKm;
+    px = m_x + m_w / 2 + (int16_t)lroundf(e * scale);
+    py = m_y + m_h / 2 - (int16_t)lroundf(n * scale);
+}
+
+void RadarView::update(const std::vector<StateVector> &states, const TrackStore &tracks,
+                       double centerLat, double centerLon, float radiusKm,
+                       unsigned long glideMs, unsigned long nowMs)
+{
+    m_radiusKm = radiusKm > 0.1f ? radiusKm : 0.1f;
+    m_glideMs = glideMs > 0 ? glideMs : 1;
+
+    // Nearest first, so the fixed contact table keeps the closest aircraft.
+    std::vector<const StateVector *> inRange;
+    inRange.reserve(states.size());
+    for (const auto &s : states)
+    {
+        if (s.on_ground || isnan(s.distance_km) || isnan(s.bearing_deg) || s.distance_km > m_radiusKm)
+            continue;
+        if (s.icao24.length() == 0 || s.icao24.length() >= sizeof(Contact::icao24))
+            continue;
+        inRange.push_back(&s);
+    }
+    std::sort(inRange.begin(), inRange.end(), [](const StateVector *a, const StateVector *b) {
+        return a->distance_km < b->distance_km;
+    });
+    if (inRange.size() > kMaxContacts)
+        inRange.resize(kMaxContacts);
+
+    bool seen[kMaxContacts] = {false};
+    std::vector<const StateVector *> fresh;
+    for (const StateVector *s : inRange)
+    {
+        Contact *c = find(s->icao24.c_str());
+        if (c == nullptr)
+        {
+            fresh.push_back(s);
+            continue;
+        }
+        // Converge from wherever the contact is drawn now, so a fix never makes it jump.
+        float drawnE = 0, drawnN = 0;
+        positionAt(*c, nowMs, drawnE, drawnN);
+        c->motion.reset(*s, nowMs);
+        float predictedE = 0, predictedN = 0;
+        c->motion.positionAt(nowMs, predictedE, predictedN);
+        c->offsetE = drawnE - predictedE;
+        c->offsetN = drawnN - predictedN;
+        c->glideStartMs = nowMs;
+        c->headingDeg = (float)s->heading;
+        c->watched = s->watch != 0;
+        loadTrail(*c, tracks.find(s->icao24), centerLat, centerLon);
+        seen[c - m_contacts] = true;
+    }
+
+    // Contacts not in this fetch are gone; their slots take the new aircraft.
+    for (uint8_t i = 0; i < kMaxContacts; ++i)
+    {
+        if (m_contacts[i].used && !seen[i])
+            m_contacts[i] = Contact();
+    }
+    for (const StateVector *s : fresh)
+    {
+        for (uint8_t i = 0; i < kMaxContacts; ++i)
+        {
+            if (m_contacts[i].used)
+                continue;
+            Contact &c = m_contacts[i];
+            c = Contact();
+            c.used = true;
+            strncpy(c.icao24, s->icao24.c_str(), sizeof(c.icao24) - 1);
+            c.motion.reset(*s, nowMs);
+            c.glideStartMs = nowMs;
+            c.headingDeg = (float)s->heading;
+            c.watched = s->watch != 0;
+            loadTrail(c, tracks.find(s->icao24), centerLat, centerLon);
+            break;
+        }
+    }
+
+    m_count = 0;
+    for (uint8_t i = 0; i < kMaxContacts; ++i)
+    {
+        if (m_contacts[i].used)
+            m_count++;
+    }
+    m_dirty = true;
+}
+
+bool RadarView::advance(unsigned long nowMs)
+{
+    bool changed = m_dirty;
+    for (uint8_t i = 0; i < kMaxContacts; ++i)
+    {
+        Contact &c = m_contacts[i];
+        if (!c.used)
+            continue;
+        float e = 0, n = 0;
+        positionAt(c, nowMs, e, n);
+        int16_t px = 0, py = 0;
+        toPixel(e, n, px, py);
+        if (px != c.px || py != c.py)
+        {
+            c.px = px;
+            c.py = py;
+            changed = true;
+        }
+    }
+    m_dirty = false;
+    return changed;
+}
+
+void RadarView::plot(RenderSurface &surface, int16_t px, int16_t py, const RenderSurface::Color &color) const
+{
+    if (px < m_x || py < m_y || px >= m_x + m_w || py >= m_y + m_h)
+        return;
+    surface.hline(px, py, 1, color);
+}
+
+void RadarView::draw(RenderSurface &surface) const
+{
+    const RenderSurface::Color ringColor = RenderSurface::rgb(0, 70, 0);
+    const RenderSurface::Color centerColor = RenderSurface::rgb(0, 140, 0);
+    const RenderSurface::Color contactColor = RenderSurface::rgb(255, 255, 255);
+    const RenderSurface::Color watchedColor = RenderSurface::rgb(255, 60, 60);
+    const RenderSurface::Color tickColor = RenderSurface::rgb(80, 200, 200);
+
+    const int16_t cx = m_x + m_w / 2;
+    const int16_t cy = m_y + m_h / 2;
+    const int16_t radiusPx = (std::min(m_w, m_h) - 1) / 2;
+
+    // Range rings (midpoint circle), outermost at the configured radius.
+    for (uint8_t ring = 1; ring <= kRings; ++ring)
+    {
+        const int16_t r = (int16_t)(radiusPx * ring / kRings);
+        int16_t x = r;
+        int16_t y = 0;
+        int16_t err = 1 - r;
+        while (x >= y)
+        {
+            plot(surface, cx + x, cy + y, ringColor);
+            plot(surface, cx + y, cy + x, ringColor);
+            plot(surface, cx - y, cy + x, ringColor);
+            plot(surface, cx - x, cy + y, ringColor);
+            plot(surface, cx - x, cy - y, ringColor);
+            plot(surface, cx - y, cy - x, ringColor);
+            plot(surface, cx + y, cy - x, ringColor);
+            plot(surface, cx + x, cy - y, ringColor);
+            ++y;
+            if (err < 0)
+            {
+                err += 2 * y + 1;
+            }
+            else
+            {
+                --x;
+                err += 2 * (y - x) + 1;
+            }
+        }
+    }
+    plot(surface, cx, cy, centerColor);
+
+    for (uint8_t i = 0; i < kMaxContacts; ++i)
+    {
+        const Contact &c = m_contacts[i];
+        if (!c.used)
+            continue;
+
+        // Trail: oldest sample dimmest.
+        for (uint8_t k = 0; k < c.trailCount; ++k)
+        {
+            const uint8_t level = (uint8_t)(40 + 120 * (k + 1) / (c.trailCount + 1));
+            int16_t tx = 0, ty = 0;
+            toPixel(c.trailE[k], c.trailN[k], tx, ty);
+            plot(surface, tx, ty, RenderSurface::rgb(level, level * 3 / 4, 0));
+        }
+
+        if (!isnan(c.headingDeg))
+        {
+            float dx, dn;
+            polarToEastNorth(1.0f, (float)c.headingDeg, dx, dn);
+            const float dy = -dn; // panel rows grow southwards
+            for (int16_t step = 1; step <= 2; ++step)
+            {
+                plot(surface, c.px + (int16_t)lroundf(dx * step), c.py + (int16_t)lroundf(dy * step), tickColor);
+            }
+        }
+        plot(surface, c.px, c.py, c.watched ? watchedColor : contactColor);
+    }
+}
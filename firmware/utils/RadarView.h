@@ -0,0 +1,78 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include "models/StateVector.h"
+#include "utils/MotionModel.h"
+#include "utils/RenderSurface.h"
+#include "utils/TrackStore.h"
+
+// Plan view of the aircraft around the configured center: range rings, one dot per
+// aircraft with a heading tick, and a fading trail through its previous fixes (taken
+// from the TrackStore on each fetch). Watchlist matches are drawn in red. Positions
+// arrive once per fetch; between them each contact is dead-reckoned from its latest fix
+// (MotionModel), and a new fix is blended in over a short correction window from
+// wherever the contact was drawn, so it moves smoothly at render rate.
+class RadarView
+{
+public:
+    static const uint8_t kMaxContacts = 16;   // nearest aircraft kept
+    static const uint8_t kTrailPoints = TrackStore::kSamples - 1; // fixes before the latest
+    static const uint8_t kRings = 3;
+
+    // Pane the radar is drawn into (panel coordinates).
+    void setViewport(int16_t x, int16_t y, int16_t w, int16_t h);
+    int16_t viewX() const { return m_x; }
+    int16_t viewY() const { return m_y; }
+    int16_t viewWidth() const { return m_w; }
+    int16_t viewHeight() const { return m_h; }
+
+    // Takes the state vectors of a new fetch, after tracks has filed them; trails are
+    // projected around the center. Contacts are matched by icao24; aircraft missing from
+    // the fetch are dropped. glideMs is the time a contact takes to converge from
+    // where it is drawn onto the track predicted from its new fix.
+    void update(const std::vector<StateVector> &states, const TrackStore &tracks,
+                double centerLat, double centerLon, float radiusKm,
+                unsigned long glideMs, unsigned long nowMs);
+
+    // Moves contacts along their predicted tracks. Returns true if anything
+    // landed on a different pixel since the last draw.
+    bool advance(unsigned long nowMs);
+
+    // Full repaint of the viewport; the caller clears it (or composes in a band) first.
+    void draw(RenderSurface &surface) const;
+
+    uint8_t count() const { return m_count; }
+
+private:
+    struct Contact
+    {
+        char icao24[7] = {0};
+        bool used = false;
+        MotionModel motion;           // from the latest fix
+        float offsetE = 0, offsetN = 0; // drawn minus predicted position when the fix arrived, km
+        unsigned long glideStartMs = 0; // the offset fades to 0 over m_glideMs from here
+        float headingDeg = NAN;
+        bool watched = false;
+        float trailE[kTrailPoints] = {0}; // km east/north of center, oldest first
+        float trailN[kTrailPoints] = {0};
+        uint8_t trailCount = 0;
+        int16_t px = 0, py = 0; // last computed pixel position
+    };
+
+    void positionAt(const Contact &c, unsigned long nowMs, float &e, float &n) const;
+    static void loadTrail(Contact &c, const TrackStore::Track *track, double centerLat, double centerLon);
+    void toPixel(float e, float n, int16_t &px, int16_t &py) const;
+    void plot(RenderSurface &surface, int16_t px, int16_t py, const RenderSurface::Color &color) const;
+    Contact *find(const char *icao24);
+
+    Contact m_contacts[kMaxContacts];
+    uint8_t m_count = 0;
+    float m_radiusKm = 1.0f;
+    unsigned long m_glideMs = 1;
+    bool m_dirty = true;
+    int16_t m_x = 0;
+    int16_t m_y = 0;
+    int16_t m_w = 0;
+    int16_t m_h = 0;
+};
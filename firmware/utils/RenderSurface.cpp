@@ -0,0 +1,124 @@
+/*
+Purpose: Portable half of the display primitive layer.
+Responsibilities:
+- Clip spans, rects and 1bpp bitmaps to the surface once, before the backend sees them.
+- Turn 1bpp bitmaps (text strips, logo) into horizontal runs.
+- GfxSurface: draw through Adafruit_GFX so the same code runs off-panel.
+*/
+#include "utils/RenderSurface.h"
+#include <Adafruit_GFX.h>
+
+RenderSurface::Color RenderSurface::rgb(uint8_t r, uint8_t g, uint8_t b)
+{
+    Color c;
+    c.r = r;
+    c.g = g;
+    c.b = b;
+    c.rgb565 = (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+    return c;
+}
+
+RenderSurface::Color RenderSurface::from565(uint16_t color)
+{
+    Color c;
+    // Replicate the high bits into the low ones so full-scale stays full-scale.
+    const uint8_t r5 = (color >> 11) & 0x1F;
+    const uint8_t g6 = (color >> 5) & 0x3F;
+    const uint8_t b5 = color & 0x1F;
+    c.r = (uint8_t)((r5 << 3) | (r5 >> 2));
+    c.g = (uint8_t)((g6 << 2) | (g6 >> 4));
+    c.b = (uint8_t)((b5 << 3) | (b5 >> 2));
+    c.rgb565 = color;
+    return c;
+}
+
+void RenderSurface::hline(int16_t x, int16_t y, int16_t w, const Color &color)
+{
+    if (y < 0 || y >= height())
+        return;
+    int16_t x1 = x + w;
+    if (x < 0) x = 0;
+    if (x1 > width()) x1 = width();
+    if (x1 > x)
+    {
+        writeSpan(x, y, x1 - x, color);
+    }
+}
+
+void RenderSurface::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, const Color &color)
+{
+    int16_t x1 = x + w;
+    int16_t y1 = y + h;
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (x1 > width()) x1 = width();
+    if (y1 > height()) y1 = height();
+    if (x1 > x && y1 > y)
+    {
+        writeRect(x, y, x1 - x, y1 - y, color);
+    }
+}
+
+void RenderSurface::clear()
+{
+    writeRect(0, 0, width(), height(), Color());
+}
+
+void RenderSurface::blitMono(const uint8_t *bits, int16_t strideBytes, int16_t w, int16_t h,
+                             int16_t x, int16_t y, int16_t clipX0, int16_t clipX1,
+                             const Color &color, bool litBit)
+{
+    if (bits == nullptr || w <= 0)
+        return;
+    if (clipX0 < 0) clipX0 = 0;
+    if (clipX1 > width()) clipX1 = width();
+
+    int16_t first = clipX0 - x;
+    int16_t last = clipX1 - x; // exclusive
+    if (first < 0) first = 0;
+    if (last > w) last = w;
+    if (first >= last)
+        return;
+
+    const uint8_t want = litBit ? 1 : 0;
+    for (int16_t row = 0; row < h; ++row)
+    {
+        const int16_t py = y + row;
+        if (py < 0 || py >= height())
+            continue;
+        const uint8_t *line = bits + (size_t)row * strideBytes;
+        int16_t col = first;
+        while (col < last)
+        {
+            while (col < last && ((line[col >> 3] >> (7 - (col & 7))) & 0x01) != want)
+                ++col;
+            const int16_t runStart = col;
+            while (col < last && ((line[col >> 3] >> (7 - (col & 7))) & 0x01) == want)
+                ++col;
+            if (col > runStart)
+            {
+                writeSpan(x + runStart, py, col - runStart, color);
+            }
+        }
+    }
+}
+
+int16_t GfxSurface::width() const
+{
+    return m_gfx.width();
+}
+
+int16_t GfxSurface::height() const
+{
+    return m_gfx.height();
+}
+
+void GfxSurface::writeSpan(int16_t x, int16_t y, int16_t w, const Color &color)
+{
+    m_gfx.drawFastHLine(x, y, w, color.rgb565);
+}
+
+void GfxSurface::writeRect(int16_t x, int16_t y, int16_t w, int16_t h, const Color &color)
+{
+    m_gfx.fillRect(x, y, w, h, color.rgb565);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <stdint.h>
+
+class Adafruit_GFX;
+
+// Span-oriented drawing primitives for the display code. Callers hand over whole rows
+// (horizontal runs, rects, 1bpp bitmaps) with a color converted once per call; the
+// backend decides how to get them onto the panel. Every primitive clips to the surface.
+class RenderSurface
+{
+public:
+    struct Color
+    {
+        uint8_t r = 0;
+        uint8_t g = 0;
+        uint8_t b = 0;
+        uint16_t rgb565 = 0;
+    };
+
+    static Color rgb(uint8_t r, uint8_t g, uint8_t b);
+    static Color from565(uint16_t color);
+
+    virtual ~RenderSurface() = default;
+
+    virtual int16_t width() const = 0;
+    virtual int16_t height() const = 0;
+
+    void hline(int16_t x, int16_t y, int16_t w, const Color &color);
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, const Color &color);
+    void clear();
+
+    // Draws a 1bpp bitmap (row-major, MSB first, strideBytes per row) with its top-left at
+    // (x, y), limited to columns [clipX0, clipX1). Pixels whose bit equals litBit are drawn,
+    // as horizontal runs.
+    void blitMono(const uint8_t *bits, int16_t strideBytes, int16_t w, int16_t h,
+                  int16_t x, int16_t y, int16_t clipX0, int16_t clipX1,
+                  const Color &color, bool litBit = true);
+
+protected:
+    // Called with spans already clipped to the surface.
+    virtual void writeSpan(int16_t x, int16_t y, int16_t w, const Color &color) = 0;
+    virtual void writeRect(int16_t x, int16_t y, int16_t w, int16_t h, const Color &color) = 0;
+};
+
+// Portable backend over any Adafruit_GFX target (e.g. GFXcanvas16 for host testing).
+class GfxSurface : public RenderSurface
+{
+public:
+    explicit GfxSurface(Adafruit_GFX &gfx) : m_gfx(gfx) {}
+
+    int16_t width() const override;
+    int16_t height() const override;
+
+protected:
+    void writeSpan(int16_t x, int16_t y, int16_t w, const Color &color) override;
+    void writeRect(int16_t x, int16_t y, int16_t w, int16_t h, const Color &color) override;
+
+private:
+    Adafruit_GFX &m_gfx;
+};
@@ -0,0 +1,96 @@
+/*
+Purpose: Diff consecutive flight snapshots by identity.
+Responsibilities:
+- Detect an unchanged snapshot cheaply (same identities, versions and metrics in order).
+- Otherwise match flights to the previous snapshot by icao24/callsign and sort them into
+  added, updated (card fields or live metrics) and removed sets.
+*/
+#include "utils/SnapshotDiff.h"
+
+const String &SnapshotDiff::keyOf(const FlightInfo &f)
+{
+    if (f.icao24.length())
+        return f.icao24;
+    if (f.ident_icao.length())
+        return f.ident_icao;
+    return f.ident.length() ? f.ident : f.ident_iata;
+}
+
+uint32_t SnapshotDiff::versionOf(const FlightInfo &f)
+{
+    // Flights from the fetcher carry a version stamp; hash anything else on the fly.
+    return f.version != 0 ? f.version : flightDisplayVersion(f);
+}
+
+bool SnapshotDiff::sameAsSeen(const std::vector<FlightInfo> &flights) const
+{
+    if (flights.size() != m_seen.size())
+        return false;
+    for (size_t i = 0; i < flights.size(); ++i)
+    {
+        const Seen &seen = m_seen[i];
+        if (seen.version != versionOf(flights[i]) ||
+            seen.metrics != flightMetricsVersion(flights[i]) ||
+            seen.key != keyOf(flights[i]))
+            return false;
+    }
+    return true;
+}
+
+bool SnapshotDiff::update(const std::vector<FlightInfo> &flights)
+{
+    if (m_primed && sameAsSeen(flights))
+        return false;
+    m_primed = true;
+
+    m_added.clear();
+    m_updated.clear();
+    m_removed.clear();
+    m_changes.assign(flights.size(), Unchanged);
+    for (auto &seen : m_seen)
+    {
+        seen.matched = false;
+    }
+
+    std::vector<Seen> next;
+    next.reserve(flights.size());
+    for (size_t i = 0; i < flights.size(); ++i)
+    {
+        const FlightInfo &f = flights[i];
+        Seen now{keyOf(f), versionOf(f), flightMetricsVersion(f), false};
+
+        // Snapshots mostly keep their order, so try the same slot first.
+        Seen *before = nullptr;
+        if (i < m_seen.size() && !m_seen[i].matched && m_seen[i].key == now.key)
+            before = &m_seen[i];
+        for (size_t j = 0; before == nullptr && j < m_seen.size(); ++j)
+        {
+            if (!m_seen[j].matched && m_seen[j].key == now.key)
+                before = &m_seen[j];
+        }
+
+        if (before == nullptr)
+        {
+            m_changes[i] = Added;
+            m_added.push_back(i);
+        }
+        else
+        {
+            before->matched = true;
+            if (before->version != now.version)
+                m_changes[i] |= CardChanged;
+            if (before->metrics != now.metrics)
+                m_changes[i] |= MetricsChanged;
+            if (m_changes[i] != Unchanged)
+                m_updated.push_back(i);
+        }
+        next.push_back(now);
+    }
+    for (const auto &seen : m_seen)
+    {
+        if (!seen.matched)
+            m_removed.push_back(seen.key);
+    }
+    m_seen.swap(next);
+    return true;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include "models/FlightInfo.h"
+
+// Compares each flight snapshot with the previous one by identity (icao24, else the
+// callsign), so a new fetch reads as arrivals, departures and in-place updates rather
+// than as a new list. The display is handed the same snapshot every frame; telling it
+// apart from a new one costs one pass over the flights and no allocation.
+class SnapshotDiff
+{
+public:
+    enum Change : uint8_t
+    {
+        Unchanged = 0,
+        Added = 1,          // not in the previous snapshot
+        CardChanged = 2,    // FlightInfo::version differs (route, names, type)
+        MetricsChanged = 4, // live metrics differ (altitude, speed, position)
+    };
+
+    // Identity of a flight across snapshots; a reference into f.
+    static const String &keyOf(const FlightInfo &f);
+
+    // Diffs flights against the snapshot passed last time and remembers it. Returns false
+    // if nothing changed; the sets below then still describe the last change.
+    bool update(const std::vector<FlightInfo> &flights);
+
+    const std::vector<size_t> &added() const { return m_added; }     // indices into flights
+    const std::vector<size_t> &updated() const { return m_updated; } // indices; present before, content changed
+    const std::vector<String> &removed() const { return m_removed; } // keys gone from the snapshot
+    // Change bits of flights[index] in the latest snapshot.
+    uint8_t changes(size_t index) const { return index < m_changes.size() ? m_changes[index] : (uint8_t)Unchanged; }
+
+private:
+    struct Seen
+    {
+        String key;
+        uint32_t version;
+        uint32_t metrics;
+        bool matched;
+    };
+
+    static uint32_t versionOf(const FlightInfo &f);
+    bool sameAsSeen(const std::vector<FlightInfo> &flights) const;
+
+    std::vector<Seen> m_seen; // previous snapshot, in its order
+    std::vector<uint8_t> m_changes;
+    std::vector<size_t> m_added;
+    std::vector<size_t> m_updated;
+    std::vector<String> m_removed;
+    bool m_primed = false;
+};
@@ -0,0 +1,97 @@
+/*
+Purpose: Draw sprites from the compressed PROGMEM sprite atlas.
+Responsibilities:
+- Decode each sprite's rows of palette-indexed runs straight into clipped spans.
+- Resolve palette entries (or a caller tint) to surface colors.
+- Map operator ICAO codes to airline tail fin sprites (binary search over a sorted table).
+*/
+#include "utils/SpriteAtlas.h"
+#include "images/SpriteAtlas.generated.h"
+
+namespace
+{
+    const SpriteDesc *desc(uint8_t id)
+    {
+        return id < Sprite::Count ? &kSprites[id] : nullptr;
+    }
+}
+
+int16_t SpriteAtlas::width(uint8_t id)
+{
+    const SpriteDesc *d = desc(id);
+    return d ? pgm_read_byte(&d->width) : 0;
+}
+
+int16_t SpriteAtlas::height(uint8_t id)
+{
+    const SpriteDesc *d = desc(id);
+    return d ? pgm_read_byte(&d->height) : 0;
+}
+
+void SpriteAtlas::draw(RenderSurface &surface, uint8_t id, int16_t x, int16_t y,
+                       int16_t clipX0, int16_t clipX1, const RenderSurface::Color *tint)
+{
+    const SpriteDesc *d = desc(id);
+    if (d == nullptr)
+        return;
+    const int16_t w = pgm_read_byte(&d->width);
+    const int16_t h = pgm_read_byte(&d->height);
+
+    RenderSurface::Color palette[4];
+    for (uint8_t i = 1; i < 4; ++i)
+    {
+        palette[i] = tint ? *tint
+                          : RenderSurface::rgb(pgm_read_byte(&d->palette[i - 1][0]),
+                                               pgm_read_byte(&d->palette[i - 1][1]),
+                                               pgm_read_byte(&d->palette[i - 1][2]));
+    }
+
+    const uint8_t *run = &kSpriteRuns[pgm_read_word(&d->offset)];
+    for (int16_t row = 0; row < h; ++row)
+    {
+        const int16_t py = y + row;
+        int16_t col = 0;
+        while (col < w)
+        {
+            const uint8_t value = pgm_read_byte(run++);
+            const uint8_t index = value >> 6;
+            const int16_t len = (int16_t)(value & 0x3F) + 1;
+            if (index != 0)
+            {
+                int16_t x0 = x + col;
+                int16_t x1 = x0 + len;
+                if (x0 < clipX0) x0 = clipX0;
+                if (x1 > clipX1) x1 = clipX1;
+                if (x1 > x0)
+                    surface.hline(x0, py, x1 - x0, palette[index]);
+            }
+            col += len;
+        }
+    }
+}
+
+int SpriteAtlas::airlineSprite(const String &icao)
+{
+    if (icao.length() != 3)
+        return -1;
+    char key[3];
+    for (uint8_t i = 0; i < 3; ++i)
+        key[i] = (char)toupper((unsigned char)icao[i]);
+
+    size_t lo = 0;
+    size_t hi = kAirlineSprites_COUNT;
+    while (lo < hi)
+    {
+        const size_t mid = (lo + hi) / 2;
+        int cmp = 0;
+        for (uint8_t i = 0; i < 3 && cmp == 0; ++i)
+            cmp = (int)(char)pgm_read_byte(&kAirlineSprites[mid].icao[i]) - key[i];
+        if (cmp == 0)
+            return pgm_read_byte(&kAirlineSprites[mid].sprite);
+        if (cmp < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return -1;
+}
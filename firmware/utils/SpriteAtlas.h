@@ -0,0 +1,24 @@
+#pragma once
+
+#include <Arduino.h>
+#include "utils/RenderSurface.h"
+#include "images/SpriteIds.generated.h"
+
+// Palette-indexed, run-length encoded sprites (weather icons, boot logo, airline tail
+// fins) built by tools/generate_sprite_atlas.py into images/SpriteAtlas.generated.h.
+// Each opaque run is written as one horizontal span, so drawing costs one writeSpan per
+// run instead of one call per pixel.
+namespace SpriteAtlas
+{
+    int16_t width(uint8_t id);
+    int16_t height(uint8_t id);
+
+    // Draws sprite id with its top-left at (x, y), clipped to columns [clipX0, clipX1)
+    // and the surface. With tint set, every opaque pixel uses that color instead of the
+    // sprite's palette (for single-color icons that follow the theme).
+    void draw(RenderSurface &surface, uint8_t id, int16_t x, int16_t y,
+              int16_t clipX0, int16_t clipX1, const RenderSurface::Color *tint = nullptr);
+
+    // Tail fin sprite for an operator ICAO code (case-insensitive), or -1 if none.
+    int airlineSprite(const String &icao);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+
+// Lock-free single-producer/single-consumer byte ring. Capacity must be a power of two;
+// head/tail are free-running counters so full and empty are distinguishable without a spare slot.
+class SpscRing
+{
+public:
+    SpscRing() = default;
+
+    void reset(uint8_t *storage, size_t capacity)
+    {
+        m_storage = storage;
+        m_capacity = capacity;
+        m_mask = capacity - 1;
+        m_head.store(0, std::memory_order_relaxed);
+        m_tail.store(0, std::memory_order_relaxed);
+    }
+
+    size_t capacity() const { return m_capacity; }
+
+    size_t size() const
+    {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+    size_t space() const { return m_capacity - size(); }
+
+    // Producer side.
+    size_t write(const uint8_t *data, size_t length)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        const size_t tail = m_tail.load(std::memory_order_acquire);
+        size_t n = m_capacity - (head - tail);
+        if (n > length)
+            n = length;
+        const size_t offset = head & m_mask;
+        const size_t first = (n < m_capacity - offset) ? n : (m_capacity - offset);
+        memcpy(m_storage + offset, data, first);
+        memcpy(m_storage, data + first, n - first);
+        m_head.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    // Consumer side.
+    size_t read(uint8_t *out, size_t length)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t head = m_head.load(std::memory_order_acquire);
+        size_t n = head - tail;
+        if (n > length)
+            n = length;
+        const size_t offset = tail & m_mask;
+        const size_t first = (n < m_capacity - offset) ? n : (m_capacity - offset);
+        memcpy(out, m_storage + offset, first);
+        memcpy(out + first, m_storage, n - first);
+        m_tail.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    // Consumer side; returns -1 when empty.
+    int peek() const
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (m_head.load(std::memory_order_acquire) == tail)
+            return -1;
+        return m_storage[tail & m_mask];
+    }
+
+private:
+    uint8_t *m_storage = nullptr;
+    size_t m_capacity = 0;
+    size_t m_mask = 0;
+    std::atomic<size_t> m_head{0};
+    std::atomic<size_t> m_tail{0};
+};
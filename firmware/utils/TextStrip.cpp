@@ -0,0 +1,74 @@
+/*
+Purpose: Cache rendered text as 1bpp strips for the flight card.
+Responsibilities:
+- Rasterize a string once, either through GFXcanvas1 in the built-in 6x8 GFX font or
+  from the compact proportional font atlas.
+- Blit the strip onto a RenderSurface as clipped horizontal runs.
+*/
+#include "utils/TextStrip.h"
+#include "utils/CompactFont.h"
+#include <Adafruit_GFX.h>
+#include <string.h>
+
+int16_t TextStrip::measure(const String &text, Font font)
+{
+    if (font == Font::Compact)
+        return CompactFont::textWidth(text);
+    return (int16_t)text.length() * kCharWidth;
+}
+
+void TextStrip::render(const String &text, Font font)
+{
+    m_width = 0;
+    m_stride = 0;
+    if (text.length() == 0)
+        return;
+
+    if (font == Font::Compact)
+    {
+        // The atlas is set straight into the strip; no canvas needed.
+        const int16_t width = CompactFont::textWidth(text);
+        m_width = width;
+        m_stride = (width + 7) / 8;
+        m_bits.assign((size_t)m_stride * kHeight, 0);
+        CompactFont::render(text.c_str(), text.length(), m_bits.data(), m_stride, 1);
+        return;
+    }
+
+    const int16_t width = (int16_t)text.length() * kCharWidth;
+    GFXcanvas1 canvas(width, kHeight);
+    if (canvas.getBuffer() == nullptr)
+    {
+        Serial.printf("TextStrip: no heap for %d px strip\n", width);
+        return;
+    }
+    canvas.fillScreen(0);
+    canvas.setTextWrap(false);
+    canvas.setTextSize(1);
+    canvas.setTextColor(1);
+    canvas.setCursor(0, 0);
+    for (size_t i = 0; i < (size_t)text.length(); ++i)
+    {
+        canvas.write(text[i]);
+    }
+
+    m_width = width;
+    m_stride = (width + 7) / 8;
+    m_bits.resize((size_t)m_stride * kHeight);
+    memcpy(m_bits.data(), canvas.getBuffer(), m_bits.size());
+}
+
+void TextStrip::clear()
+{
+    std::vector<uint8_t>().swap(m_bits);
+    m_width = 0;
+    m_stride = 0;
+}
+
+void TextStrip::blit(RenderSurface &dst, int16_t x, int16_t y, int16_t clipX0, int16_t clipX1,
+                     const RenderSurface::Color &color) const
+{
+    if (m_width == 0)
+        return;
+    dst.blitMono(m_bits.data(), m_stride, m_width, kHeight, x, y, clipX0, clipX1, color);
+}
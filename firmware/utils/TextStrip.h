@@ -0,0 +1,40 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include "utils/RenderSurface.h"
+
+// A line of text pre-rendered once into a 1bpp bitmap (row-major, MSB first, one byte
+// per 8 columns). Drawing it is a clipped blit of horizontal runs instead of one drawPixel
+// per lit pixel through Adafruit_GFX::write.
+class TextStrip
+{
+public:
+    static const int16_t kCharWidth = 6; // Font::Glcd advance
+    static const int16_t kHeight = 8;
+
+    enum class Font : uint8_t
+    {
+        Glcd,    // built-in 6x8 GFX font, fixed width
+        Compact, // utils/CompactFont, proportional; set one row down in the 8-row strip
+    };
+
+    // Width the text will have once rendered in the given font.
+    static int16_t measure(const String &text, Font font = Font::Glcd);
+
+    // Re-renders in place; the bitmap's capacity is kept for reuse.
+    void render(const String &text, Font font = Font::Glcd);
+    void clear();
+
+    int16_t width() const { return m_width; }
+    size_t bytes() const { return m_bits.size(); }
+
+    // Draws the strip with its top-left at (x, y), limited to columns [clipX0, clipX1).
+    void blit(RenderSurface &dst, int16_t x, int16_t y, int16_t clipX0, int16_t clipX1,
+              const RenderSurface::Color &color) const;
+
+private:
+    std::vector<uint8_t> m_bits;
+    int16_t m_width = 0;
+    int16_t m_stride = 0;
+};
@@ -0,0 +1,179 @@
+/*
+Purpose: Bounded per-aircraft history of recent fixes.
+Responsibilities:
+- Map icao24 addresses to track slots through a linear-probing index, so filing or
+  finding a state vector is O(1).
+- Append each new fix to the track's ring of kSamples, skipping fixes already recorded.
+- Keep tracks in least-recently-seen order; reuse the oldest slot when the store is full
+  and drop tracks of aircraft missing for kRetainMs.
+*/
+#include "utils/TrackStore.h"
+
+TrackStore::TrackStore()
+{
+    memset(m_index, kNone, sizeof(m_index));
+    for (uint8_t i = 0; i < kMaxTracks; ++i)
+    {
+        m_prev[i] = kNone;
+        m_next[i] = (uint8_t)(i + 1 < kMaxTracks ? i + 1 : kNone);
+    }
+}
+
+uint32_t TrackStore::keyOf(const String &icao24)
+{
+    if (icao24.length() == 0 || icao24.length() > 6)
+        return kNoKey;
+    uint32_t key = 0;
+    for (unsigned int i = 0; i < icao24.length(); ++i)
+    {
+        const char c = icao24[i];
+        uint32_t digit;
+        if (c >= '0' && c <= '9')
+            digit = c - '0';
+        else if (c >= 'a' && c <= 'f')
+            digit = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F')
+            digit = c - 'A' + 10;
+        else
+            return kNoKey;
+        key = (key << 4) | digit;
+    }
+    return key;
+}
+
+uint8_t TrackStore::lookup(uint32_t key) const
+{
+    for (uint8_t b = home(key);; b = (b + 1) & (kIndexSize - 1))
+    {
+        const uint8_t slot = m_index[b];
+        if (slot == kNone)
+            return kNone;
+        if (m_tracks[slot].m_key == key)
+            return slot;
+    }
+}
+
+void TrackStore::unlink(uint8_t slot)
+{
+    if (m_prev[slot] != kNone)
+        m_next[m_prev[slot]] = m_next[slot];
+    else
+        m_newest = m_next[slot];
+    if (m_next[slot] != kNone)
+        m_prev[m_next[slot]] = m_prev[slot];
+    else
+        m_oldest = m_prev[slot];
+}
+
+void TrackStore::pushFront(uint8_t slot)
+{
+    m_prev[slot] = kNone;
+    m_next[slot] = m_newest;
+    if (m_newest != kNone)
+        m_prev[m_newest] = slot;
+    m_newest = slot;
+    if (m_oldest == kNone)
+        m_oldest = slot;
+}
+
+void TrackStore::remove(uint8_t slot)
+{
+    // Find the slot's bucket, then shift later entries of its probe run back so lookups
+    // never stop at the hole (no tombstones).
+    uint8_t hole = home(m_tracks[slot].m_key);
+    while (m_index[hole] != slot)
+        hole = (hole + 1) & (kIndexSize - 1);
+    m_index[hole] = kNone;
+    for (uint8_t b = (hole + 1) & (kIndexSize - 1); m_index[b] != kNone; b = (b + 1) & (kIndexSize - 1))
+    {
+        const uint8_t h = home(m_tracks[m_index[b]].m_key);
+        // Move the entry unless its home lies cyclically in (hole, b].
+        const bool homeAfterHole = ((b - h) & (kIndexSize - 1)) < ((b - hole) & (kIndexSize - 1));
+        if (homeAfterHole)
+            continue;
+        m_index[hole] = m_index[b];
+        m_index[b] = kNone;
+        hole = b;
+    }
+
+    unlink(slot);
+    m_tracks[slot] = Track();
+    m_next[slot] = m_free;
+    m_prev[slot] = kNone;
+    m_free = slot;
+    m_size--;
+}
+
+uint8_t TrackStore::insert(uint32_t key, unsigned long nowMs)
+{
+    if (m_free == kNone)
+        remove(m_oldest);
+    const uint8_t slot = m_free;
+    m_free = m_next[slot];
+    m_size++;
+
+    Track &t = m_tracks[slot];
+    t = Track();
+    t.m_key = key;
+    t.m_firstSeenMs = nowMs;
+    uint8_t b = home(key);
+    while (m_index[b] != kNone)
+        b = (b + 1) & (kIndexSize - 1);
+    m_index[b] = slot;
+    pushFront(slot);
+    return slot;
+}
+
+void TrackStore::update(const StateVector &s, unsigned long nowMs)
+{
+    const uint32_t key = keyOf(s.icao24);
+    if (key == kNoKey || isnan(s.lat) || isnan(s.lon))
+        return;
+    uint8_t slot = lookup(key);
+    if (slot == kNone)
+    {
+        slot = insert(key, nowMs);
+    }
+    else
+    {
+        unlink(slot);
+        pushFront(slot);
+    }
+
+    Track &t = m_tracks[slot];
+    t.m_lastSeenMs = nowMs;
+    const unsigned long fixMs = s.position_ms != 0 ? s.position_ms : nowMs;
+    if (t.m_count > 0 && t.latest().ms == fixMs)
+        return; // the aircraft reported no new position since the last fetch
+    Sample &sample = t.m_samples[t.m_head];
+    sample.ms = fixMs;
+    sample.lat = (float)s.lat;
+    sample.lon = (float)s.lon;
+    sample.altitudeM = (float)s.baro_altitude;
+    sample.speedMps = (float)s.velocity;
+    t.m_head = (uint8_t)((t.m_head + 1) % kSamples);
+    if (t.m_count < kSamples)
+        t.m_count++;
+}
+
+void TrackStore::update(const std::vector<StateVector> &states, unsigned long nowMs)
+{
+    for (const StateVector &s : states)
+    {
+        update(s, nowMs);
+    }
+    // The list is ordered by last sighting, so the stale tracks are all at its end.
+    while (m_oldest != kNone && nowMs - m_tracks[m_oldest].m_lastSeenMs > kRetainMs)
+    {
+        remove(m_oldest);
+    }
+}
+
+const TrackStore::Track *TrackStore::find(const String &icao24) const
+{
+    const uint32_t key = keyOf(icao24);
+    if (key == kNoKey)
+        return nullptr;
+    const uint8_t slot = lookup(key);
+    return slot == kNone ? nullptr : &m_tracks[slot];
+}
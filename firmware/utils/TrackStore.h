@@ -0,0 +1,87 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include "models/StateVector.h"
+
+// Recent history of every aircraft seen, keyed by icao24, in fixed memory: up to
+// kMaxTracks tracks of the last kSamples fixes each. A state vector is filed in O(1)
+// (open-addressed index on the 24-bit address, least-recently-seen list for eviction),
+// so the store can take every vector of a fetch. Tracks of aircraft that left are
+// dropped after kRetainMs, or earlier when a new aircraft needs the slot. The radar
+// draws its trails from it.
+class TrackStore
+{
+public:
+    static const uint8_t kMaxTracks = 48;
+    static const uint8_t kSamples = 8;
+    static const unsigned long kRetainMs = 120000; // keep a missing aircraft's track this long
+
+    struct Sample
+    {
+        unsigned long ms = 0; // fix time on the local clock (see StateVector::position_ms)
+        float lat = NAN;
+        float lon = NAN;
+        float altitudeM = NAN;
+        float speedMps = NAN;
+    };
+
+    class Track
+    {
+    public:
+        uint8_t size() const { return m_count; }
+        // Oldest first: at(0) is the oldest kept fix, at(size() - 1) the latest.
+        const Sample &at(uint8_t i) const { return m_samples[(m_head + kSamples - m_count + i) % kSamples]; }
+        const Sample &latest() const { return at(m_count - 1); }
+        unsigned long firstSeenMs() const { return m_firstSeenMs; }
+        unsigned long lastSeenMs() const { return m_lastSeenMs; }
+
+    private:
+        friend class TrackStore;
+        Sample m_samples[kSamples];
+        uint8_t m_head = 0; // next slot to write
+        uint8_t m_count = 0;
+        uint32_t m_key = 0;
+        unsigned long m_firstSeenMs = 0;
+        unsigned long m_lastSeenMs = 0;
+    };
+
+    TrackStore();
+
+    // Files one state vector; a fix already recorded (same time) only refreshes lastSeen.
+    // Vectors without a valid icao24 or position are ignored.
+    void update(const StateVector &s, unsigned long nowMs);
+    // Files a whole fetch, then drops tracks not seen for kRetainMs.
+    void update(const std::vector<StateVector> &states, unsigned long nowMs);
+
+    const Track *find(const String &icao24) const;
+    uint8_t size() const { return m_size; }
+
+private:
+    static const uint8_t kNone = 0xFF;
+    static const uint8_t kIndexBits = 7;
+    static const uint8_t kIndexSize = 1 << kIndexBits;
+    static_assert(kIndexSize >= 2 * kMaxTracks, "keep the index at most half full");
+    static_assert(kMaxTracks < kNone, "track slots are uint8_t");
+
+    // The 24-bit address parsed from hex, or kNoKey.
+    static const uint32_t kNoKey = 0xFFFFFFFFu;
+    static uint32_t keyOf(const String &icao24);
+    // Fibonacci hashing: spreads the sequential addresses of one registry over the index.
+    static uint8_t home(uint32_t key) { return (uint8_t)((key * 2654435761u) >> (32 - kIndexBits)); }
+
+    uint8_t lookup(uint32_t key) const; // track slot, or kNone
+    uint8_t insert(uint32_t key, unsigned long nowMs);
+    void remove(uint8_t slot);
+    void unlink(uint8_t slot);
+    void pushFront(uint8_t slot);
+
+    Track m_tracks[kMaxTracks];
+    uint8_t m_index[kIndexSize]; // track slot per bucket, kNone if empty
+    uint8_t m_prev[kMaxTracks];  // recency list, most recently seen first
+    uint8_t m_next[kMaxTracks];  // ... and, for unused slots, the free list
+    uint8_t m_newest = kNone;
+    uint8_t m_oldest = kNone;
+    uint8_t m_free = 0;
+    uint8_t m_size = 0;
+};
@@ -0,0 +1,186 @@
+/*
+Purpose: Compile the user's watchlist and match state vectors against it.
+Responsibilities:
+- Parse the settings list into callsign/operator, type and address keys (exact or
+  prefix) in one character trie, and squawks into a 4096-bit set.
+- Match a state vector's callsign, icao24 and squawk, and a flight's type, walking the
+  trie once per field without allocating.
+- Always treat the emergency squawks 7500/7600/7700 as watched.
+*/
+#include "utils/Watchlist.h"
+#include <ctype.h>
+#include <string.h>
+
+namespace
+{
+    Watchlist s_active;
+
+    bool isSeparator(char c)
+    {
+        return c == ',' || c == ';' || c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    bool startsWith(const char *token, size_t length, const char *tag)
+    {
+        const size_t n = strlen(tag);
+        return length > n && strncasecmp(token, tag, n) == 0;
+    }
+}
+
+const Watchlist &Watchlist::active()
+{
+    return s_active;
+}
+
+void Watchlist::load(const String &list)
+{
+    s_active.compile(list);
+}
+
+bool Watchlist::isEmergency(const String &squawk)
+{
+    return squawk == "7500" || squawk == "7600" || squawk == "7700";
+}
+
+int Watchlist::squawkIndex(const char *digits, size_t length)
+{
+    if (length != 4)
+        return -1;
+    int index = 0;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        const char c = digits[i];
+        if (c < '0' || c > '7')
+            return -1;
+        index = index * 8 + (c - '0');
+    }
+    return index;
+}
+
+uint16_t Watchlist::child(uint16_t node, char c) const
+{
+    for (uint16_t n = m_nodes[node].firstChild; n != 0; n = m_nodes[n].nextSibling)
+    {
+        if (m_nodes[n].c == c)
+            return n;
+    }
+    return 0;
+}
+
+void Watchlist::insert(char kind, const char *key, size_t length, bool prefix)
+{
+    uint16_t node = 0;
+    for (size_t i = 0; i <= length; ++i)
+    {
+        const char c = i == 0 ? kind : (char)toupper((unsigned char)key[i - 1]);
+        uint16_t next = child(node, c);
+        if (next == 0)
+        {
+            if (m_nodes.size() >= 0xFFFF)
+            {
+                Serial.println("Watchlist: list too long; remaining entries ignored");
+                return;
+            }
+            next = (uint16_t)m_nodes.size();
+            m_nodes.push_back(Node{c, 0, 0, m_nodes[node].firstChild});
+            m_nodes[node].firstChild = next;
+        }
+        node = next;
+    }
+    m_nodes[node].flags |= prefix ? kPrefix : kEnd;
+}
+
+void Watchlist::compile(const String &list)
+{
+    m_nodes.clear();
+    m_nodes.push_back(Node{0, 0, 0, 0});
+    memset(m_squawks, 0, sizeof(m_squawks));
+
+    const char *p = list.c_str();
+    while (*p)
+    {
+        while (*p && isSeparator(*p))
+            ++p;
+        const char *token = p;
+        while (*p && !isSeparator(*p))
+            ++p;
+        size_t length = (size_t)(p - token);
+        if (length == 0)
+            continue;
+
+        char kind = kCallsignKind;
+        const char *key = token;
+        if (startsWith(token, length, "type:"))
+        {
+            kind = kTypeKind;
+            key += 5;
+        }
+        else if (startsWith(token, length, "hex:"))
+        {
+            kind = kAddressKind;
+            key += 4;
+        }
+        else if (startsWith(token, length, "sq:"))
+        {
+            const int index = squawkIndex(token + 3, length - 3);
+            if (index >= 0)
+                m_squawks[index / 8] |= (uint8_t)(1 << (index % 8));
+            else
+                Serial.printf("Watchlist: ignoring '%.*s'\n", (int)length, token);
+            continue;
+        }
+        length -= (size_t)(key - token);
+
+        bool prefix = length > 0 && key[length - 1] == '*';
+        if (prefix)
+            --length;
+        bool valid = length > 0;
+        bool letters = true;
+        for (size_t i = 0; i < length; ++i)
+        {
+            valid = valid && isalnum((unsigned char)key[i]);
+            letters = letters && isalpha((unsigned char)key[i]);
+        }
+        if (!valid)
+        {
+            Serial.printf("Watchlist: ignoring '%.*s'\n", (int)(p - token), token);
+            continue;
+        }
+        // A bare three-letter ICAO airline designator stands for all its callsigns.
+        if (kind == kCallsignKind && length == 3 && letters)
+            prefix = true;
+        insert(kind, key, length, prefix);
+    }
+}
+
+bool Watchlist::lookup(char kind, const String &key) const
+{
+    if (key.length() == 0 || m_nodes.empty())
+        return false;
+    uint16_t node = child(0, kind);
+    for (unsigned int i = 0; node != 0 && i < key.length(); ++i)
+    {
+        if (m_nodes[node].flags & kPrefix)
+            return true;
+        node = child(node, (char)toupper((unsigned char)key[i]));
+    }
+    return node != 0 && (m_nodes[node].flags & (kEnd | kPrefix)) != 0;
+}
+
+uint8_t Watchlist::match(const StateVector &s) const
+{
+    uint8_t bits = None;
+    if (lookup(kCallsignKind, s.callsign))
+        bits |= Callsign;
+    if (lookup(kAddressKind, s.icao24))
+        bits |= Address;
+    const int squawk = squawkIndex(s.squawk.c_str(), s.squawk.length());
+    if (isEmergency(s.squawk) || (squawk >= 0 && (m_squawks[squawk / 8] & (1 << (squawk % 8)))))
+        bits |= Squawk;
+    return bits;
+}
+
+uint8_t Watchlist::matchType(const String &aircraftCode) const
+{
+    return lookup(kTypeKind, aircraftCode) ? Type : None;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include "models/StateVector.h"
+
+// Aircraft the user wants to be told about, compiled once from the settings list into a
+// trie (callsigns, operators, types, addresses) and a squawk bitset, so a state vector is
+// checked in O(length of its fields) while it is parsed. Entries are separated by commas
+// or spaces, case-insensitive, and may end in '*' to match a prefix:
+//   DLH438  callsign        DLH     operator (three letters: all its callsigns)
+//   RCH*    callsign prefix type:A388, type:B74*   ICAO aircraft type (after enrichment)
+//   hex:3c6752, hex:ae*     transponder address (ae/af: US military)
+//   sq:7000                 squawk; 7500, 7600 and 7700 are always watched
+class Watchlist
+{
+public:
+    enum Match : uint8_t
+    {
+        None = 0,
+        Callsign = 1, // callsign or operator
+        Type = 2,
+        Address = 4,
+        Squawk = 8,
+    };
+
+    // The list the fetchers match against; empty until load().
+    static const Watchlist &active();
+    // Compiles list into active(). Call before the fetch task starts.
+    static void load(const String &list);
+
+    void compile(const String &list);
+
+    // Match bits of a state vector (callsign, address, squawk).
+    uint8_t match(const StateVector &s) const;
+    // Type is only known once a flight is enriched.
+    uint8_t matchType(const String &aircraftCode) const;
+
+    static bool isEmergency(const String &squawk);
+
+private:
+    // Trie node; children are a sibling list. Keys start with a kind character so the
+    // namespaces share one trie.
+    struct Node
+    {
+        char c;
+        uint8_t flags;       // kEnd, kPrefix
+        uint16_t firstChild; // 0: none (the root is never a child)
+        uint16_t nextSibling;
+    };
+    static const uint8_t kEnd = 1;    // a key ends here
+    static const uint8_t kPrefix = 2; // every continuation matches
+    static const char kCallsignKind = 'c';
+    static const char kTypeKind = 't';
+    static const char kAddressKind = 'h';
+
+    void insert(char kind, const char *key, size_t length, bool prefix);
+    bool lookup(char kind, const String &key) const;
+    uint16_t child(uint16_t node, char c) const;
+    static int squawkIndex(const char *digits, size_t length); // 0..4095, or -1 if not 4 octal digits
+
+    std::vector<Node> m_nodes; // [0] is the root
+    uint8_t m_squawks[4096 / 8] = {0};
+};